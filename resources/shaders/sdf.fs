@@ -0,0 +1,21 @@
+#version 330
+
+// Texto com fonte SDF (game_font.c): o alfa do atlas é a distância até a borda do glyph,
+// com 0.5 exatamente na borda. A suavização usa a variação da distância entre pixels
+// vizinhos, então a borda fica nítida em qualquer tamanho.
+
+in vec2 fragTexCoord;
+in vec4 fragColor;
+
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+
+out vec4 finalColor;
+
+void main()
+{
+    float distanceFromEdge = texture(texture0, fragTexCoord).a - 0.5;
+    float distancePerPixel = length(vec2(dFdx(distanceFromEdge), dFdy(distanceFromEdge)));
+    float alpha = smoothstep(-distancePerPixel, distancePerPixel, distanceFromEdge);
+    finalColor = vec4(fragColor.rgb, fragColor.a*alpha)*colDiffuse;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file background_worker.c
+ * @author Grupo 1
+ * @brief Implementação da thread de tarefas em segundo plano.
+ * @version 1.0
+ * @copyright Copyright (c) 2025
+ *
+ * As duas filas (a executar e prontas) são listas ligadas de nós alocados no envio;
+ * a trava só protege a troca de nós entre as filas, nunca a execução de uma tarefa.
+ */
+
+#include "raylib/background_worker.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//---------------------------------------------
+// Definições e Constantes (Privadas ao Módulo)
+//---------------------------------------------
+
+typedef struct JobNode {
+    void *job;
+    struct JobNode *next;
+} JobNode;
+
+typedef struct {
+    JobNode *head;
+    JobNode *tail;
+} JobQueue;
+
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool stopping;
+    JobQueue pending;
+    JobQueue finished;
+    BackgroundJobFunc run;
+} WorkerState;
+
+//---------------------------------------------
+// Funções Privadas
+//---------------------------------------------
+static void PushNode(JobQueue *queue, JobNode *node) {
+    node->next = NULL;
+    if (queue->tail != NULL) queue->tail->next = node;
+    else queue->head = node;
+    queue->tail = node;
+}
+
+static JobNode *PopNode(JobQueue *queue) {
+    JobNode *node = queue->head;
+    if (node == NULL) return NULL;
+    queue->head = node->next;
+    if (queue->head == NULL) queue->tail = NULL;
+    return node;
+}
+
+static void *WorkerThread(void *argument) {
+    WorkerState *state = argument;
+    pthread_mutex_lock(&state->lock);
+    while (!state->stopping) {
+        JobNode *node = PopNode(&state->pending);
+        if (node == NULL) {
+            pthread_cond_wait(&state->wake, &state->lock);
+            continue;
+        }
+        pthread_mutex_unlock(&state->lock);
+        state->run(node->job);
+        pthread_mutex_lock(&state->lock);
+        PushNode(&state->finished, node);
+    }
+    pthread_mutex_unlock(&state->lock);
+    return NULL;
+}
+
+static void DiscardQueue(JobQueue *queue, BackgroundJobFunc discard) {
+    JobNode *node;
+    while ((node = PopNode(queue)) != NULL) {
+        if (discard != NULL) discard(node->job);
+        free(node);
+    }
+}
+
+//---------------------------------------------
+// Implementação das Funções Públicas
+//---------------------------------------------
+
+bool StartBackgroundWorker(BackgroundWorker *worker, BackgroundJobFunc run) {
+    worker->state = NULL;
+    WorkerState *state = calloc(1, sizeof(WorkerState));
+    if (state == NULL) return false;
+    state->run = run;
+    if (pthread_mutex_init(&state->lock, NULL) != 0) {
+        free(state);
+        return false;
+    }
+    pthread_cond_init(&state->wake, NULL);
+    if (pthread_create(&state->thread, NULL, WorkerThread, state) != 0) {
+        fprintf(stderr, "[BackgroundWorker] Aviso: thread não iniciada.\n");
+        pthread_cond_destroy(&state->wake);
+        pthread_mutex_destroy(&state->lock);
+        free(state);
+        return false;
+    }
+    worker->state = state;
+    return true;
+}
+
+bool SubmitBackgroundJob(BackgroundWorker *worker, void *job) {
+    WorkerState *state = worker->state;
+    if (state == NULL) return false;
+    JobNode *node = malloc(sizeof(JobNode));
+    if (node == NULL) return false;
+    node->job = job;
+    pthread_mutex_lock(&state->lock);
+    PushNode(&state->pending, node);
+    pthread_cond_signal(&state->wake);
+    pthread_mutex_unlock(&state->lock);
+    return true;
+}
+
+bool TakeFinishedBackgroundJob(BackgroundWorker *worker, void **job) {
+    WorkerState *state = worker->state;
+    if (state == NULL) return false;
+    pthread_mutex_lock(&state->lock);
+    JobNode *node = PopNode(&state->finished);
+    pthread_mutex_unlock(&state->lock);
+    if (node == NULL) return false;
+    *job = node->job;
+    free(node);
+    return true;
+}
+
+void StopBackgroundWorker(BackgroundWorker *worker, BackgroundJobFunc discard) {
+    WorkerState *state = worker->state;
+    if (state == NULL) return;
+    pthread_mutex_lock(&state->lock);
+    state->stopping = true;
+    pthread_cond_signal(&state->wake);
+    pthread_mutex_unlock(&state->lock);
+    pthread_join(state->thread, NULL);
+    DiscardQueue(&state->pending, discard);
+    DiscardQueue(&state->finished, discard);
+    pthread_cond_destroy(&state->wake);
+    pthread_mutex_destroy(&state->lock);
+    free(state);
+    worker->state = NULL;
+}
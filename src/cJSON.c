@@ -44,8 +44,24 @@
 #include <limits.h>
 #include <ctype.h>
 #include <float.h>
+#include <stdint.h>
+
+/* SIMD scanning is used on x86 when SSE2 is part of the target; AVX2 is compiled
+ * with a per-function target attribute and only used if the CPU reports it at runtime.
+ * Define CJSON_DISABLE_SIMD to build the scalar routines only. */
+#if !defined(CJSON_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define CJSON_SIMD_SSE2
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 9))))
+#define CJSON_SIMD_AVX2
+#include <immintrin.h>
+#endif
+#endif
 
-#ifdef ENABLE_LOCALES
+#ifndef DISABLE_LOCALES
 #include <locale.h>
 #endif
 
@@ -206,8 +222,15 @@ static unsigned char* cJSON_strdup(const unsigned char* string, const internal_h
     return copy;
 }
 
+static void clear_container_indexes(void);
+static void release_pools(void);
+
 CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
 {
+    /* the index tables and pools were allocated with the old hooks */
+    clear_container_indexes();
+    release_pools();
+
     if (hooks == NULL)
     {
         /* Reset hooks */
@@ -237,996 +260,3413 @@ CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks)
     }
 }
 
-/* Internal constructor. */
-static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
-{
-    cJSON* node = (cJSON*)hooks->allocate(sizeof(cJSON));
-    if (node)
-    {
-        memset(node, '\0', sizeof(cJSON));
-    }
+/* Memory reuse across parses, both off by default.
+ * Object names without escapes can be interned: one shared copy per distinct name, handed out
+ * with cJSON_StringIsConst so cJSON_Delete leaves it alone. The copies are packed into blocks
+ * and only freed by cJSON_ReleasePools (or cJSON_InitHooks).
+ * Deleted items can go to a free list that cJSON_New_Item takes from before allocating. */
+#define INTERN_MAX_KEY_LENGTH 64
+#define INTERN_MAX_KEYS 4096
+#define INTERN_BLOCK_SIZE 4096
 
-    return node;
-}
+typedef struct intern_block
+{
+    struct intern_block *next;
+    size_t used;
+    unsigned char data[INTERN_BLOCK_SIZE];
+} intern_block;
 
-/* Delete a cJSON structure. */
-CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
+typedef struct
 {
-    cJSON *next = NULL;
-    while (item != NULL)
-    {
-        next = item->next;
-        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
-        {
-            cJSON_Delete(item->child);
-        }
-        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
-        {
-            global_hooks.deallocate(item->valuestring);
-            item->valuestring = NULL;
-        }
-        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
-        {
-            global_hooks.deallocate(item->string);
-            item->string = NULL;
-        }
-        global_hooks.deallocate(item);
-        item = next;
-    }
-}
+    const char *string;
+    size_t length;
+    uint32_t hash;
+} intern_entry;
 
-/* get the decimal point character of the current locale */
-static unsigned char get_decimal_point(void)
+typedef struct
 {
-#ifdef ENABLE_LOCALES
-    struct lconv *lconv = localeconv();
-    return (unsigned char) lconv->decimal_point[0];
-#else
-    return '.';
-#endif
-}
+    cJSON_bool enabled;
+    intern_entry *entries; /* open addressing, string == NULL means empty */
+    size_t capacity;
+    size_t count;
+    intern_block *blocks;
+} intern_table;
 
 typedef struct
 {
-    const unsigned char *content;
-    size_t length;
-    size_t offset;
-    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
-    internal_hooks hooks;
-} parse_buffer;
+    cJSON *free_items; /* linked through next */
+    size_t count;
+    size_t limit;
+} node_pool;
 
-/* check if the given size is left to read in a given parse buffer (starting with 1) */
-#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
-/* check if the buffer can be accessed at the given index (starting with 0) */
-#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
-#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
-/* get a pointer to the buffer at the position */
-#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+static intern_table key_intern_table = { false, NULL, 0, 0, NULL };
+static node_pool item_pool = { NULL, 0, 0 };
 
-/* Parse the input text to generate a number, and populate the result into item. */
-static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+static uint32_t hash_bytes(const unsigned char *bytes, size_t length)
 {
-    double number = 0;
-    unsigned char *after_end = NULL;
-    unsigned char *number_c_string;
-    unsigned char decimal_point = get_decimal_point();
+    uint32_t hash = 2166136261u;
     size_t i = 0;
-    size_t number_string_length = 0;
-    cJSON_bool has_decimal_point = false;
+    for (i = 0; i < length; i++)
+    {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
 
-    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    return hash;
+}
+
+static cJSON_bool grow_intern_table(intern_table * const table)
+{
+    size_t new_capacity = (table->capacity == 0) ? 64 : table->capacity * 2;
+    intern_entry *new_entries = (intern_entry*)global_hooks.allocate(new_capacity * sizeof(intern_entry));
+    size_t i = 0;
+
+    if (new_entries == NULL)
     {
         return false;
     }
+    memset(new_entries, '\0', new_capacity * sizeof(intern_entry));
 
-    /* copy the number into a temporary buffer and replace '.' with the decimal point
-     * of the current locale (for strtod)
-     * This also takes care of '\0' not necessarily being available for marking the end of the input */
-    for (i = 0; can_access_at_index(input_buffer, i); i++)
+    for (i = 0; i < table->capacity; i++)
     {
-        switch (buffer_at_offset(input_buffer)[i])
+        if (table->entries[i].string != NULL)
         {
-            case '0':
-            case '1':
-            case '2':
-            case '3':
-            case '4':
-            case '5':
-            case '6':
-            case '7':
-            case '8':
-            case '9':
-            case '+':
-            case '-':
-            case 'e':
-            case 'E':
-                number_string_length++;
-                break;
-
-            case '.':
-                number_string_length++;
-                has_decimal_point = true;
-                break;
-
-            default:
-                goto loop_end;
+            size_t slot = table->entries[i].hash & (new_capacity - 1);
+            while (new_entries[slot].string != NULL)
+            {
+                slot = (slot + 1) & (new_capacity - 1);
+            }
+            new_entries[slot] = table->entries[i];
         }
     }
-loop_end:
-    /* malloc for temporary buffer, add 1 for '\0' */
-    number_c_string = (unsigned char *) input_buffer->hooks.allocate(number_string_length + 1);
-    if (number_c_string == NULL)
+
+    if (table->entries != NULL)
     {
-        return false; /* allocation failure */
+        global_hooks.deallocate(table->entries);
     }
+    table->entries = new_entries;
+    table->capacity = new_capacity;
 
-    memcpy(number_c_string, buffer_at_offset(input_buffer), number_string_length);
-    number_c_string[number_string_length] = '\0';
+    return true;
+}
 
-    if (has_decimal_point)
+/* the shared copy of key, NULL if it can't be interned (the caller then makes its own copy) */
+static const char *intern_key(const unsigned char *key, size_t length)
+{
+    intern_table * const table = &key_intern_table;
+    uint32_t hash = 0;
+    size_t slot = 0;
+    unsigned char *copy = NULL;
+
+    if (!table->enabled || (length > INTERN_MAX_KEY_LENGTH))
     {
-        for (i = 0; i < number_string_length; i++)
+        return NULL;
+    }
+
+    hash = hash_bytes(key, length);
+    if (table->capacity > 0)
+    {
+        for (slot = hash & (table->capacity - 1); table->entries[slot].string != NULL; slot = (slot + 1) & (table->capacity - 1))
         {
-            if (number_c_string[i] == '.')
+            const intern_entry *entry = &table->entries[slot];
+            if ((entry->hash == hash) && (entry->length == length) && (memcmp(entry->string, key, length) == 0))
             {
-                /* replace '.' with the decimal point of the current locale (for strtod) */
-                number_c_string[i] = decimal_point;
+                return entry->string;
             }
         }
     }
 
-    number = strtod((const char*)number_c_string, (char**)&after_end);
-    if (number_c_string == after_end)
+    /* new name, unless the table is full: untrusted input must not grow it forever */
+    if (table->count >= INTERN_MAX_KEYS)
     {
-        /* free the temporary buffer */
-        input_buffer->hooks.deallocate(number_c_string);
-        return false; /* parse_error */
+        return NULL;
     }
-
-    item->valuedouble = number;
-
-    /* use saturation in case of overflow */
-    if (number >= INT_MAX)
+    if (((table->count + 1) * 2 > table->capacity) && !grow_intern_table(table))
     {
-        item->valueint = INT_MAX;
+        return NULL;
     }
-    else if (number <= (double)INT_MIN)
+    if ((table->blocks == NULL) || ((INTERN_BLOCK_SIZE - table->blocks->used) < (length + 1)))
     {
-        item->valueint = INT_MIN;
+        intern_block *block = (intern_block*)global_hooks.allocate(sizeof(intern_block));
+        if (block == NULL)
+        {
+            return NULL;
+        }
+        block->next = table->blocks;
+        block->used = 0;
+        table->blocks = block;
     }
-    else
+
+    copy = table->blocks->data + table->blocks->used;
+    memcpy(copy, key, length);
+    copy[length] = '\0';
+    table->blocks->used += length + 1;
+
+    for (slot = hash & (table->capacity - 1); table->entries[slot].string != NULL; slot = (slot + 1) & (table->capacity - 1))
     {
-        item->valueint = (int)number;
     }
+    table->entries[slot].string = (const char*)copy;
+    table->entries[slot].length = length;
+    table->entries[slot].hash = hash;
+    table->count++;
 
-    item->type = cJSON_Number;
-
-    input_buffer->offset += (size_t)(after_end - number_c_string);
-    /* free the temporary buffer */
-    input_buffer->hooks.deallocate(number_c_string);
-    return true;
+    return (const char*)copy;
 }
 
-/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
-CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
+static void trim_item_pool(size_t limit)
 {
-    if (number >= INT_MAX)
-    {
-        object->valueint = INT_MAX;
-    }
-    else if (number <= (double)INT_MIN)
+    while (item_pool.count > limit)
     {
-        object->valueint = INT_MIN;
+        cJSON *item = item_pool.free_items;
+        item_pool.free_items = item->next;
+        item_pool.count--;
+        global_hooks.deallocate(item);
     }
-    else
+}
+
+/* give an item's memory back, to the pool if there is room */
+static void release_item(cJSON * const item)
+{
+    if (item_pool.count < item_pool.limit)
     {
-        object->valueint = (int)number;
+        item->next = item_pool.free_items;
+        item_pool.free_items = item;
+        item_pool.count++;
+        return;
     }
 
-    return object->valuedouble = number;
+    global_hooks.deallocate(item);
 }
 
-/* Note: when passing a NULL valuestring, cJSON_SetValuestring treats this as an error and return NULL */
-CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
+static void release_pools(void)
 {
-    char *copy = NULL;
-    size_t v1_len;
-    size_t v2_len;
-    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
-    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    intern_block *block = key_intern_table.blocks;
+    while (block != NULL)
     {
-        return NULL;
+        intern_block *next = block->next;
+        global_hooks.deallocate(block);
+        block = next;
     }
-    /* return NULL if the object is corrupted or valuestring is NULL */
-    if (object->valuestring == NULL || valuestring == NULL)
+    if (key_intern_table.entries != NULL)
     {
-        return NULL;
+        global_hooks.deallocate(key_intern_table.entries);
     }
+    key_intern_table.entries = NULL;
+    key_intern_table.capacity = 0;
+    key_intern_table.count = 0;
+    key_intern_table.blocks = NULL;
 
-    v1_len = strlen(valuestring);
-    v2_len = strlen(object->valuestring);
+    trim_item_pool(0);
+}
 
-    if (v1_len <= v2_len)
+CJSON_PUBLIC(void) cJSON_SetKeyInterning(cJSON_bool enable)
+{
+    key_intern_table.enabled = enable ? true : false;
+}
+
+CJSON_PUBLIC(void) cJSON_SetItemPoolLimit(size_t max_free_items)
+{
+    item_pool.limit = max_free_items;
+    trim_item_pool(max_free_items);
+}
+
+CJSON_PUBLIC(void) cJSON_ReleasePools(void)
+{
+    release_pools();
+}
+
+/* Internal constructor. */
+static cJSON *cJSON_New_Item(const internal_hooks * const hooks)
+{
+    cJSON* node = NULL;
+
+    /* pooled items come from global_hooks, which every caller passes (or a copy of it) */
+    if (item_pool.free_items != NULL)
     {
-        /* strcpy does not handle overlapping string: [X1, X2] [Y1, Y2] => X2 < Y1 or Y2 < X1 */
-        if (!( valuestring + v1_len < object->valuestring || object->valuestring + v2_len < valuestring ))
-        {
-            return NULL;
-        }
-        strcpy(object->valuestring, valuestring);
-        return object->valuestring;
+        node = item_pool.free_items;
+        item_pool.free_items = node->next;
+        item_pool.count--;
     }
-    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
-    if (copy == NULL)
+    else
     {
-        return NULL;
+        node = (cJSON*)hooks->allocate(sizeof(cJSON));
     }
-    if (object->valuestring != NULL)
+    if (node)
     {
-        cJSON_free(object->valuestring);
+        memset(node, '\0', sizeof(cJSON));
     }
-    object->valuestring = copy;
 
-    return copy;
+    return node;
 }
 
+/* Optional lookup index.
+ * Containers with at least index_threshold children get a side table the first time a
+ * lookup has to walk that far: an array of their items (O(1) cJSON_GetArrayItem) and, for
+ * objects, an open addressing hash of the keys (O(1) cJSON_GetObjectItem*).
+ * The tables live in a registry keyed by the container pointer so the public cJSON struct
+ * is unchanged. Every cJSON function that relinks children drops the container's entry,
+ * it is rebuilt lazily. Like the rest of cJSON's global state this isn't thread safe. */
 typedef struct
 {
-    unsigned char *buffer;
-    size_t length;
-    size_t offset;
-    size_t depth; /* current nesting depth (for formatted printing) */
-    cJSON_bool noalloc;
-    cJSON_bool format; /* is this print a formatted print */
-    internal_hooks hooks;
-} printbuffer;
+    const cJSON *container;
+    size_t count;
+    cJSON **items; /* children in list order */
+    size_t *slots; /* object key hash, holds position + 1, 0 means empty */
+    size_t slot_mask;
+} container_index;
 
-/* realloc printbuffer if necessary to have at least "needed" bytes more */
-static unsigned char* ensure(printbuffer * const p, size_t needed)
+typedef struct
 {
-    unsigned char *newbuffer = NULL;
-    size_t newsize = 0;
+    container_index **entries; /* open addressing by container pointer */
+    size_t capacity;
+    size_t count;
+} index_registry;
 
-    if ((p == NULL) || (p->buffer == NULL))
-    {
-        return NULL;
-    }
+static size_t index_threshold = 0;
+static index_registry global_index_registry = { NULL, 0, 0 };
 
-    if ((p->length > 0) && (p->offset >= p->length))
+/* FNV-1a over ASCII lowercased bytes, so case sensitive and insensitive lookups share one table */
+static size_t hash_key(const unsigned char *key)
+{
+    uint32_t hash = 2166136261u;
+    for (; *key != '\0'; key++)
     {
-        /* make sure that offset is valid */
-        return NULL;
+        hash ^= (uint32_t)tolower(*key);
+        hash *= 16777619u;
     }
 
-    if (needed > INT_MAX)
+    return (size_t)hash;
+}
+
+static size_t hash_pointer(const void *pointer)
+{
+    uint64_t value = (uint64_t)(size_t)pointer;
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+
+    return (size_t)value;
+}
+
+static void free_container_index(container_index *index)
+{
+    global_hooks.deallocate(index->items);
+    if (index->slots != NULL)
     {
-        /* sizes bigger than INT_MAX are currently not supported */
-        return NULL;
+        global_hooks.deallocate(index->slots);
     }
+    global_hooks.deallocate(index);
+}
 
-    needed += p->offset + 1;
-    if (needed <= p->length)
+static size_t find_registry_slot(const cJSON *container)
+{
+    size_t mask = global_index_registry.capacity - 1;
+    size_t slot = hash_pointer(container) & mask;
+    while ((global_index_registry.entries[slot] != NULL) && (global_index_registry.entries[slot]->container != container))
     {
-        return p->buffer + p->offset;
+        slot = (slot + 1) & mask;
     }
 
-    if (p->noalloc) {
+    return slot;
+}
+
+static container_index *find_container_index(const cJSON *container)
+{
+    if (global_index_registry.count == 0)
+    {
         return NULL;
     }
 
-    /* calculate new buffer size */
-    if (needed > (INT_MAX / 2))
+    return global_index_registry.entries[find_registry_slot(container)];
+}
+
+/* drop the index of a container whose children are about to change (or that is being deleted) */
+static void invalidate_container_index(const cJSON *container)
+{
+    size_t mask = 0;
+    size_t hole = 0;
+    size_t slot = 0;
+
+    if ((global_index_registry.count == 0) || (container == NULL))
     {
-        /* overflow of int, use INT_MAX if possible */
-        if (needed <= INT_MAX)
-        {
-            newsize = INT_MAX;
-        }
-        else
-        {
-            return NULL;
-        }
+        return;
     }
-    else
+
+    mask = global_index_registry.capacity - 1;
+    hole = find_registry_slot(container);
+    if (global_index_registry.entries[hole] == NULL)
     {
-        newsize = needed * 2;
+        return;
     }
+    free_container_index(global_index_registry.entries[hole]);
+    global_index_registry.entries[hole] = NULL;
+    global_index_registry.count--;
 
-    if (p->hooks.reallocate != NULL)
+    /* backward shift deletion keeps the probe sequences intact without tombstones */
+    for (slot = (hole + 1) & mask; global_index_registry.entries[slot] != NULL; slot = (slot + 1) & mask)
     {
-        /* reallocate with realloc if available */
-        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
-        if (newbuffer == NULL)
+        size_t home = hash_pointer(global_index_registry.entries[slot]->container) & mask;
+        if (((slot - home) & mask) >= ((slot - hole) & mask))
         {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
-
-            return NULL;
+            global_index_registry.entries[hole] = global_index_registry.entries[slot];
+            global_index_registry.entries[slot] = NULL;
+            hole = slot;
         }
     }
-    else
+}
+
+static void clear_container_indexes(void)
+{
+    size_t i = 0;
+    for (i = 0; i < global_index_registry.capacity; i++)
     {
-        /* otherwise reallocate manually */
-        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
-        if (!newbuffer)
+        if (global_index_registry.entries[i] != NULL)
         {
-            p->hooks.deallocate(p->buffer);
-            p->length = 0;
-            p->buffer = NULL;
-
-            return NULL;
+            free_container_index(global_index_registry.entries[i]);
         }
-
-        memcpy(newbuffer, p->buffer, p->offset + 1);
-        p->hooks.deallocate(p->buffer);
     }
-    p->length = newsize;
-    p->buffer = newbuffer;
-
-    return newbuffer + p->offset;
+    if (global_index_registry.entries != NULL)
+    {
+        global_hooks.deallocate(global_index_registry.entries);
+    }
+    global_index_registry.entries = NULL;
+    global_index_registry.capacity = 0;
+    global_index_registry.count = 0;
 }
 
-/* calculate the new length of the string in a printbuffer and update the offset */
-static void update_offset(printbuffer * const buffer)
+static cJSON_bool register_container_index(container_index *index)
 {
-    const unsigned char *buffer_pointer = NULL;
-    if ((buffer == NULL) || (buffer->buffer == NULL))
+    /* keep the load factor under 1/2 */
+    if ((global_index_registry.count + 1) * 2 > global_index_registry.capacity)
     {
-        return;
+        size_t old_capacity = global_index_registry.capacity;
+        container_index **old_entries = global_index_registry.entries;
+        size_t new_capacity = (old_capacity == 0) ? 16 : old_capacity * 2;
+        size_t i = 0;
+
+        container_index **new_entries = (container_index**)global_hooks.allocate(new_capacity * sizeof(container_index*));
+        if (new_entries == NULL)
+        {
+            return false;
+        }
+        memset(new_entries, 0, new_capacity * sizeof(container_index*));
+        global_index_registry.entries = new_entries;
+        global_index_registry.capacity = new_capacity;
+        for (i = 0; i < old_capacity; i++)
+        {
+            if (old_entries[i] != NULL)
+            {
+                global_index_registry.entries[find_registry_slot(old_entries[i]->container)] = old_entries[i];
+            }
+        }
+        if (old_entries != NULL)
+        {
+            global_hooks.deallocate(old_entries);
+        }
     }
-    buffer_pointer = buffer->buffer + buffer->offset;
 
-    buffer->offset += strlen((const char*)buffer_pointer);
-}
+    global_index_registry.entries[find_registry_slot(index->container)] = index;
+    global_index_registry.count++;
 
-/* securely comparison of floating-point variables */
-static cJSON_bool compare_double(double a, double b)
-{
-    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
-    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+    return true;
 }
 
-/* Render the number nicely from the given item into a string. */
-static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+static container_index *build_container_index(const cJSON *container)
 {
-    unsigned char *output_pointer = NULL;
-    double d = item->valuedouble;
-    int length = 0;
+    container_index *index = NULL;
+    cJSON *child = NULL;
+    size_t count = 0;
     size_t i = 0;
-    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
-    unsigned char decimal_point = get_decimal_point();
-    double test = 0.0;
 
-    if (output_buffer == NULL)
+    for (child = container->child; child != NULL; child = child->next)
     {
-        return false;
+        count++;
     }
 
-    /* This checks for NaN and Infinity */
-    if (isnan(d) || isinf(d))
+    index = (container_index*)global_hooks.allocate(sizeof(container_index));
+    if (index == NULL)
     {
-        length = sprintf((char*)number_buffer, "null");
+        return NULL;
     }
-    else if(d == (double)item->valueint)
+    memset(index, 0, sizeof(container_index));
+    index->container = container;
+    index->count = count;
+    index->items = (cJSON**)global_hooks.allocate((count + 1) * sizeof(cJSON*));
+    if (index->items == NULL)
     {
-        length = sprintf((char*)number_buffer, "%d", item->valueint);
+        global_hooks.deallocate(index);
+        return NULL;
     }
-    else
+    for (child = container->child; child != NULL; child = child->next)
     {
-        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
-        length = sprintf((char*)number_buffer, "%1.15g", d);
+        index->items[i++] = child;
+    }
 
-        /* Check whether the original double can be recovered */
-        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
+    if (cJSON_IsObject(container))
+    {
+        size_t capacity = 16;
+        while (capacity < (count * 2))
         {
-            /* If not, print with 17 decimal places of precision */
-            length = sprintf((char*)number_buffer, "%1.17g", d);
+            capacity *= 2;
+        }
+        index->slots = (size_t*)global_hooks.allocate(capacity * sizeof(size_t));
+        if (index->slots == NULL)
+        {
+            free_container_index(index);
+            return NULL;
+        }
+        memset(index->slots, 0, capacity * sizeof(size_t));
+        index->slot_mask = capacity - 1;
+        for (i = 0; i < count; i++)
+        {
+            size_t slot = 0;
+            if (index->items[i]->string == NULL)
+            {
+                /* not a well formed object, leave it to the linear lookup */
+                free_container_index(index);
+                return NULL;
+            }
+            slot = hash_key((const unsigned char*)index->items[i]->string) & index->slot_mask;
+            while (index->slots[slot] != 0)
+            {
+                slot = (slot + 1) & index->slot_mask;
+            }
+            index->slots[slot] = i + 1;
         }
     }
 
-    /* sprintf failed or buffer overrun occurred */
-    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    if (!register_container_index(index))
     {
-        return false;
+        free_container_index(index);
+        return NULL;
     }
 
-    /* reserve appropriate space in the output */
-    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
-    if (output_pointer == NULL)
+    return index;
+}
+
+/* a linear lookup walked `visited` children, index the container if it is large */
+static void maybe_index_container(const cJSON *container, size_t visited)
+{
+    if ((index_threshold != 0) && (visited >= index_threshold))
     {
-        return false;
+        build_container_index(container);
     }
+}
 
-    /* copy the printed number to the output and replace locale
-     * dependent decimal point with '.' */
-    for (i = 0; i < ((size_t)length); i++)
+static cJSON *index_get_object_item(const container_index *index, const char *name, const cJSON_bool case_sensitive)
+{
+    size_t slot = hash_key((const unsigned char*)name) & index->slot_mask;
+    size_t best = 0;
+
+    /* duplicate keys are allowed, the linear lookup returns the first one so do the same */
+    for (; index->slots[slot] != 0; slot = (slot + 1) & index->slot_mask)
     {
-        if (number_buffer[i] == decimal_point)
+        size_t position = index->slots[slot];
+        const char *key = index->items[position - 1]->string;
+        cJSON_bool equal = case_sensitive ? (strcmp(name, key) == 0) : (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)key) == 0);
+        if (equal && ((best == 0) || (position < best)))
         {
-            output_pointer[i] = '.';
-            continue;
+            best = position;
         }
-
-        output_pointer[i] = number_buffer[i];
     }
-    output_pointer[i] = '\0';
-
-    output_buffer->offset += (size_t)length;
 
-    return true;
+    return (best == 0) ? NULL : index->items[best - 1];
 }
 
-/* parse 4 digit hexadecimal number */
-static unsigned parse_hex4(const unsigned char * const input)
+CJSON_PUBLIC(void) cJSON_SetIndexThreshold(int threshold)
 {
-    unsigned int h = 0;
-    size_t i = 0;
+    clear_container_indexes();
+    index_threshold = (threshold > 0) ? (size_t)threshold : 0;
+}
 
-    for (i = 0; i < 4; i++)
+/* Delete a cJSON structure. */
+CJSON_PUBLIC(void) cJSON_Delete(cJSON *item)
+{
+    cJSON *next = NULL;
+    while (item != NULL)
     {
-        /* parse digit */
-        if ((input[i] >= '0') && (input[i] <= '9'))
-        {
-            h += (unsigned int) input[i] - '0';
-        }
-        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        next = item->next;
+        if (item->child != NULL)
         {
-            h += (unsigned int) 10 + input[i] - 'A';
+            invalidate_container_index(item);
         }
-        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+        if (!(item->type & cJSON_IsReference) && (item->child != NULL))
         {
-            h += (unsigned int) 10 + input[i] - 'a';
+            cJSON_Delete(item->child);
         }
-        else /* invalid */
+        if (!(item->type & cJSON_IsReference) && (item->valuestring != NULL))
         {
-            return 0;
+            global_hooks.deallocate(item->valuestring);
+            item->valuestring = NULL;
         }
-
-        if (i < 3)
+        if (!(item->type & cJSON_StringIsConst) && (item->string != NULL))
         {
-            /* shift left to make place for the next nibble */
-            h = h << 4;
+            global_hooks.deallocate(item->string);
+            item->string = NULL;
         }
+        release_item(item);
+        item = next;
     }
+}
 
-    return h;
+/* get the decimal point character of the current locale,
+ * strtod/sprintf follow LC_NUMERIC so this is needed to keep the JSON side locale independent */
+static unsigned char get_decimal_point(void)
+{
+#ifndef DISABLE_LOCALES
+    struct lconv *lconv = localeconv();
+    return (unsigned char) lconv->decimal_point[0];
+#else
+    return '.';
+#endif
 }
 
-/* converts a UTF-16 literal to UTF-8
- * A literal can be one or two sequences of the form \uXXXX */
-static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+/* Byte scanning routines used by the parser.
+ * Both return an offset in [0, length] and never read past input + length. */
+typedef size_t (*scan_function)(const unsigned char *input, size_t length);
+
+/* Character classes of a 64 byte block, bit i stands for byte i (used by the tape parser) */
+typedef struct
 {
-    long unsigned int codepoint = 0;
-    unsigned int first_code = 0;
-    const unsigned char *first_sequence = input_pointer;
-    unsigned char utf8_length = 0;
-    unsigned char utf8_position = 0;
-    unsigned char sequence_length = 0;
-    unsigned char first_byte_mark = 0;
+    uint64_t backslash;
+    uint64_t quote;
+    /* { } [ ] : , */
+    uint64_t structural;
+    /* <= 32, like buffer_skip_whitespace */
+    uint64_t whitespace;
+} block_classes;
 
-    if ((input_end - first_sequence) < 6)
+typedef void (*classify_function)(const unsigned char *block, block_classes * const classes);
+
+typedef struct
+{
+    const char *name;
+    /* number of leading bytes that are whitespace (<= 32) */
+    scan_function skip_whitespace;
+    /* offset of the first '\"' or '\\' */
+    scan_function find_string_special;
+    /* classify exactly 64 bytes */
+    classify_function classify_block;
+} scan_backend;
+
+static size_t scalar_skip_whitespace(const unsigned char *input, size_t length)
+{
+    size_t i = 0;
+    while ((i < length) && (input[i] <= 32))
     {
-        /* input ends unexpectedly */
-        goto fail;
+        i++;
     }
 
-    /* get the first utf16 sequence */
-    first_code = parse_hex4(first_sequence + 2);
+    return i;
+}
 
-    /* check that the code is valid */
-    if (((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+static size_t scalar_find_string_special(const unsigned char *input, size_t length)
+{
+    size_t i = 0;
+    while ((i < length) && (input[i] != '\"') && (input[i] != '\\'))
     {
-        goto fail;
+        i++;
     }
 
-    /* UTF16 surrogate pair */
-    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
-    {
-        const unsigned char *second_sequence = first_sequence + 6;
-        unsigned int second_code = 0;
-        sequence_length = 12; /* \uXXXX\uXXXX */
+    return i;
+}
 
-        if ((input_end - second_sequence) < 6)
-        {
-            /* input ends unexpectedly */
-            goto fail;
-        }
+static void scalar_classify_block(const unsigned char *block, block_classes * const classes)
+{
+    uint64_t bit = 1;
+    size_t i = 0;
 
-        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
+    memset(classes, '\0', sizeof(*classes));
+    for (i = 0; i < 64; i++, bit <<= 1)
+    {
+        switch (block[i])
         {
-            /* missing second half of the surrogate pair */
-            goto fail;
+            case '\\':
+                classes->backslash |= bit;
+                break;
+            case '\"':
+                classes->quote |= bit;
+                break;
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                classes->structural |= bit;
+                break;
+            default:
+                if (block[i] <= 32)
+                {
+                    classes->whitespace |= bit;
+                }
+                break;
         }
+    }
+}
 
-        /* get the second utf16 sequence */
-        second_code = parse_hex4(second_sequence + 2);
-        /* check that the code is valid */
-        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
+#ifdef CJSON_SIMD_SSE2
+/* index of the lowest set bit, mask must not be 0 */
+static size_t first_set_bit(unsigned int mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return (size_t)index;
+#else
+    size_t index = 0;
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+static size_t sse2_skip_whitespace(const unsigned char *input, size_t length)
+{
+    const __m128i space = _mm_set1_epi8(32);
+    size_t i = 0;
+
+    for (; (i + 16) <= length; i += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(input + i));
+        /* max(c, 32) == 32 exactly when c <= 32 (unsigned compare) */
+        const unsigned int not_whitespace = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, space), space)) ^ 0xFFFFu;
+        if (not_whitespace != 0)
         {
-            /* invalid second half of the surrogate pair */
-            goto fail;
+            return i + first_set_bit(not_whitespace);
         }
+    }
 
+    return i + scalar_skip_whitespace(input + i, length - i);
+}
 
-        /* calculate the unicode codepoint from the surrogate pair */
-        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
+static size_t sse2_find_string_special(const unsigned char *input, size_t length)
+{
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    size_t i = 0;
+
+    for (; (i + 16) <= length; i += 16)
+    {
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(input + i));
+        const unsigned int special = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+        if (special != 0)
+        {
+            return i + first_set_bit(special);
+        }
     }
-    else
+
+    return i + scalar_find_string_special(input + i, length - i);
+}
+
+static void sse2_classify_block(const unsigned char *block, block_classes * const classes)
+{
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i space = _mm_set1_epi8(32);
+    const __m128i case_bit = _mm_set1_epi8(0x20);
+    const __m128i open_brace = _mm_set1_epi8('{');
+    const __m128i close_brace = _mm_set1_epi8('}');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    size_t i = 0;
+
+    memset(classes, '\0', sizeof(*classes));
+    for (i = 0; i < 64; i += 16)
     {
-        sequence_length = 6; /* \uXXXX */
-        codepoint = first_code;
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)(block + i));
+        /* '[' and ']' only differ from '{' and '}' in bit 5 */
+        const __m128i folded = _mm_or_si128(chunk, case_bit);
+        const __m128i structural = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(folded, open_brace), _mm_cmpeq_epi8(folded, close_brace)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, colon), _mm_cmpeq_epi8(chunk, comma)));
+
+        classes->backslash |= (uint64_t)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash)) << i;
+        classes->quote |= (uint64_t)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote)) << i;
+        classes->structural |= (uint64_t)(unsigned int)_mm_movemask_epi8(structural) << i;
+        classes->whitespace |= (uint64_t)(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, space), space)) << i;
     }
+}
+#endif /* CJSON_SIMD_SSE2 */
 
-    /* encode as UTF-8
-     * takes at maximum 4 bytes to encode:
-     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
-    if (codepoint < 0x80)
+#ifdef CJSON_SIMD_AVX2
+#define CJSON_TARGET_AVX2 __attribute__((target("avx2")))
+
+CJSON_TARGET_AVX2 static size_t avx2_skip_whitespace(const unsigned char *input, size_t length)
+{
+    size_t i = 0;
+    unsigned int not_whitespace = 0;
+
+    /* most runs are short, probe 16 bytes before touching the 256 bit registers */
+    if (length >= 16)
     {
-        /* normal ascii, encoding 0xxxxxxx */
-        utf8_length = 1;
+        const __m128i space = _mm_set1_epi8(32);
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)input);
+        not_whitespace = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, space), space)) ^ 0xFFFFu;
+        if (not_whitespace != 0)
+        {
+            return first_set_bit(not_whitespace);
+        }
+        i = 16;
     }
-    else if (codepoint < 0x800)
+
+    if ((i + 32) <= length)
     {
-        /* two bytes, encoding 110xxxxx 10xxxxxx */
-        utf8_length = 2;
-        first_byte_mark = 0xC0; /* 11000000 */
+        const __m256i space = _mm256_set1_epi8(32);
+        for (; (i + 32) <= length; i += 32)
+        {
+            const __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(input + i));
+            not_whitespace = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(chunk, space), space));
+            if (not_whitespace != 0)
+            {
+                break;
+            }
+        }
+        /* leave the upper halves clean, -O1 doesn't insert vzeroupper for us
+         * and the SSE code running next would pay for the state transition */
+        _mm256_zeroupper();
+
+        if (not_whitespace != 0)
+        {
+            return i + first_set_bit(not_whitespace);
+        }
     }
-    else if (codepoint < 0x10000)
+
+    return i + scalar_skip_whitespace(input + i, length - i);
+}
+
+CJSON_TARGET_AVX2 static size_t avx2_find_string_special(const unsigned char *input, size_t length)
+{
+    size_t i = 0;
+    unsigned int special = 0;
+
+    if (length >= 16)
     {
-        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 3;
-        first_byte_mark = 0xE0; /* 11100000 */
+        const __m128i quote = _mm_set1_epi8('\"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i chunk = _mm_loadu_si128((const __m128i*)(const void*)input);
+        special = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+        if (special != 0)
+        {
+            return first_set_bit(special);
+        }
+        i = 16;
     }
-    else if (codepoint <= 0x10FFFF)
+
+    if ((i + 32) <= length)
     {
-        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
-        utf8_length = 4;
-        first_byte_mark = 0xF0; /* 11110000 */
+        const __m256i quote = _mm256_set1_epi8('\"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        for (; (i + 32) <= length; i += 32)
+        {
+            const __m256i chunk = _mm256_loadu_si256((const __m256i*)(const void*)(input + i));
+            special = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)));
+            if (special != 0)
+            {
+                break;
+            }
+        }
+        _mm256_zeroupper();
+
+        if (special != 0)
+        {
+            return i + first_set_bit(special);
+        }
     }
-    else
+
+    return i + scalar_find_string_special(input + i, length - i);
+}
+
+static cJSON_bool cpu_supports_avx2(void)
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? true : false;
+}
+#endif /* CJSON_SIMD_AVX2 */
+
+static const scan_backend scalar_scan_backend = { "scalar", scalar_skip_whitespace, scalar_find_string_special, scalar_classify_block };
+#ifdef CJSON_SIMD_SSE2
+static const scan_backend sse2_scan_backend = { "sse2", sse2_skip_whitespace, sse2_find_string_special, sse2_classify_block };
+#endif
+#ifdef CJSON_SIMD_AVX2
+/* the classifier is called once per 64 byte block, the SSE2 one avoids a vzeroupper per call */
+static const scan_backend avx2_scan_backend = { "avx2", avx2_skip_whitespace, avx2_find_string_special, sse2_classify_block };
+#endif
+
+/* NULL until cJSON_SetScanBackend: parsers then detect the backend on every call instead of caching it, so
+ * parsing on several threads never writes shared state */
+static const scan_backend *active_scan_backend = NULL;
+
+static const scan_backend *detect_scan_backend(void)
+{
+#ifdef CJSON_SIMD_AVX2
+    if (cpu_supports_avx2())
     {
-        /* invalid unicode codepoint */
-        goto fail;
+        return &avx2_scan_backend;
     }
+#endif
+#ifdef CJSON_SIMD_SSE2
+    return &sse2_scan_backend;
+#else
+    return &scalar_scan_backend;
+#endif
+}
 
-    /* encode as utf8 */
-    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
+static const scan_backend *get_scan_backend(void)
+{
+    return (active_scan_backend != NULL) ? active_scan_backend : detect_scan_backend();
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_SetScanBackend(const char *name)
+{
+    if ((name == NULL) || (strcmp(name, "auto") == 0))
     {
-        /* 10xxxxxx */
-        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
-        codepoint >>= 6;
+        active_scan_backend = detect_scan_backend();
+        return true;
     }
-    /* encode first byte */
-    if (utf8_length > 1)
+    if (strcmp(name, "scalar") == 0)
     {
-        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+        active_scan_backend = &scalar_scan_backend;
+        return true;
     }
-    else
+#ifdef CJSON_SIMD_SSE2
+    if (strcmp(name, "sse2") == 0)
     {
-        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+        active_scan_backend = &sse2_scan_backend;
+        return true;
     }
+#endif
+#ifdef CJSON_SIMD_AVX2
+    if ((strcmp(name, "avx2") == 0) && cpu_supports_avx2())
+    {
+        active_scan_backend = &avx2_scan_backend;
+        return true;
+    }
+#endif
 
-    *output_pointer += utf8_length;
-
-    return sequence_length;
+    return false;
+}
 
-fail:
-    return 0;
+CJSON_PUBLIC(const char *) cJSON_GetScanBackend(void)
+{
+    return get_scan_backend()->name;
 }
 
-/* Parse the input text into an unescaped cinput, and populate item. */
-static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+typedef struct
 {
-    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
-    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
-    unsigned char *output_pointer = NULL;
-    unsigned char *output = NULL;
+    const unsigned char *content;
+    size_t length;
+    size_t offset;
+    size_t depth; /* How deeply nested (in arrays/objects) is the input at the current offset. */
+    internal_hooks hooks;
+    const scan_backend *scan;
+} parse_buffer;
 
-    /* not a string */
-    if (buffer_at_offset(input_buffer)[0] != '\"')
+/* check if the given size is left to read in a given parse buffer (starting with 1) */
+#define can_read(buffer, size) ((buffer != NULL) && (((buffer)->offset + size) <= (buffer)->length))
+/* check if the buffer can be accessed at the given index (starting with 0) */
+#define can_access_at_index(buffer, index) ((buffer != NULL) && (((buffer)->offset + index) < (buffer)->length))
+#define cannot_access_at_index(buffer, index) (!can_access_at_index(buffer, index))
+/* get a pointer to the buffer at the position */
+#define buffer_at_offset(buffer) ((buffer)->content + (buffer)->offset)
+
+/* exact powers of ten for the fast path, 10^22 is the largest one a double holds exactly */
+static const double exact_powers_of_ten[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#define is_digit(character) (((character) >= '0') && ((character) <= '9'))
+
+/* Parse a number in strict JSON form straight from the input, without strtod.
+ * Integers with up to 19 digits are converted exactly, decimals are handled when the
+ * mantissa fits in 53 bits and the decimal exponent in [-22, 22] (Clinger's fast path),
+ * where a single multiplication or division is correctly rounded.
+ * Returns false for anything else (long mantissas, huge exponents, non strict forms)
+ * so the caller can fall back to strtod. */
+static cJSON_bool parse_number_fast(const unsigned char * const input, size_t length, double * const number, size_t * const consumed)
+{
+    const unsigned char *pointer = input;
+    const unsigned char *end = input + length;
+    uint64_t mantissa = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    cJSON_bool negative = false;
+    cJSON_bool is_integer = true;
+
+    if ((pointer < end) && (*pointer == '-'))
     {
-        goto fail;
+        negative = true;
+        pointer++;
+    }
+    if ((pointer >= end) || !is_digit(*pointer))
+    {
+        return false;
     }
 
+    if (*pointer == '0')
     {
-        /* calculate approximate size of the output (overestimate) */
-        size_t allocation_length = 0;
-        size_t skipped_bytes = 0;
-        while (((size_t)(input_end - input_buffer->content) < input_buffer->length) && (*input_end != '\"'))
+        pointer++;
+        /* leading zeros aren't JSON, leave them to strtod */
+        if ((pointer < end) && is_digit(*pointer))
         {
-            /* is escape sequence */
-            if (input_end[0] == '\\')
+            return false;
+        }
+    }
+    else
+    {
+        while ((pointer < end) && is_digit(*pointer))
+        {
+            if (significant_digits == 19)
             {
-                if ((size_t)(input_end + 1 - input_buffer->content) >= input_buffer->length)
-                {
-                    /* prevent buffer overflow when last input character is a backslash */
-                    goto fail;
-                }
-                skipped_bytes++;
-                input_end++;
+                return false;
             }
-            input_end++;
+            mantissa = (mantissa * 10) + (uint64_t)(*pointer - '0');
+            significant_digits++;
+            pointer++;
         }
-        if (((size_t)(input_end - input_buffer->content) >= input_buffer->length) || (*input_end != '\"'))
+    }
+
+    if ((pointer < end) && (*pointer == '.'))
+    {
+        is_integer = false;
+        pointer++;
+        if ((pointer >= end) || !is_digit(*pointer))
         {
-            goto fail; /* string ended unexpectedly */
+            return false;
         }
-
-        /* This is at most how much we need for the output */
-        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
-        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
-        if (output == NULL)
+        while ((pointer < end) && is_digit(*pointer))
         {
-            goto fail; /* allocation failure */
+            /* zeros before the first significant digit only move the exponent */
+            if ((mantissa != 0) || (*pointer != '0'))
+            {
+                if (significant_digits == 19)
+                {
+                    return false;
+                }
+                mantissa = (mantissa * 10) + (uint64_t)(*pointer - '0');
+                significant_digits++;
+            }
+            exponent--;
+            pointer++;
         }
     }
 
-    output_pointer = output;
-    /* loop through the string literal */
-    while (input_pointer < input_end)
+    if ((pointer < end) && ((*pointer == 'e') || (*pointer == 'E')))
     {
-        if (*input_pointer != '\\')
+        cJSON_bool negative_exponent = false;
+        int exponent_value = 0;
+
+        is_integer = false;
+        pointer++;
+        if ((pointer < end) && ((*pointer == '+') || (*pointer == '-')))
         {
-            *output_pointer++ = *input_pointer++;
+            negative_exponent = (*pointer == '-');
+            pointer++;
         }
-        /* escape sequence */
-        else
+        if ((pointer >= end) || !is_digit(*pointer))
         {
-            unsigned char sequence_length = 2;
-            if ((input_end - input_pointer) < 1)
-            {
-                goto fail;
-            }
-
-            switch (input_pointer[1])
+            return false;
+        }
+        while ((pointer < end) && is_digit(*pointer))
+        {
+            /* anything this large is out of the fast path's range anyway */
+            if (exponent_value < 10000)
             {
-                case 'b':
-                    *output_pointer++ = '\b';
-                    break;
-                case 'f':
-                    *output_pointer++ = '\f';
-                    break;
-                case 'n':
-                    *output_pointer++ = '\n';
-                    break;
-                case 'r':
-                    *output_pointer++ = '\r';
-                    break;
-                case 't':
-                    *output_pointer++ = '\t';
-                    break;
-                case '\"':
-                case '\\':
-                case '/':
-                    *output_pointer++ = input_pointer[1];
-                    break;
-
-                /* UTF-16 literal */
-                case 'u':
-                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
-                    if (sequence_length == 0)
-                    {
-                        /* failed to convert UTF16-literal to UTF-8 */
-                        goto fail;
-                    }
-                    break;
-
-                default:
-                    goto fail;
+                exponent_value = (exponent_value * 10) + (*pointer - '0');
             }
-            input_pointer += sequence_length;
+            pointer++;
         }
+        exponent += negative_exponent ? -exponent_value : exponent_value;
     }
 
-    /* zero terminate the output */
-    *output_pointer = '\0';
-
-    item->type = cJSON_String;
-    item->valuestring = (char*)output;
+    if (is_integer || (mantissa == 0))
+    {
+        /* integer to double conversion is correctly rounded */
+        *number = (double)mantissa;
+    }
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+    else if ((mantissa <= ((uint64_t)1 << 53)) && (exponent >= -22) && (exponent <= 22))
+    {
+        *number = (double)mantissa;
+        if (exponent < 0)
+        {
+            *number /= exact_powers_of_ten[-exponent];
+        }
+        else
+        {
+            *number *= exact_powers_of_ten[exponent];
+        }
+    }
+#endif
+    else
+    {
+        return false;
+    }
 
-    input_buffer->offset = (size_t) (input_end - input_buffer->content);
-    input_buffer->offset++;
+    if (negative)
+    {
+        *number = -*number;
+    }
+    *consumed = (size_t)(pointer - input);
 
     return true;
+}
 
-fail:
-    if (output != NULL)
-    {
-        input_buffer->hooks.deallocate(output);
-        output = NULL;
-    }
+/* Parse the input text to generate a number, and populate the result into item. */
+static cJSON_bool parse_number(cJSON * const item, parse_buffer * const input_buffer)
+{
+    double number = 0;
+    unsigned char *after_end = NULL;
+    unsigned char local_c_string[64];
+    unsigned char *number_c_string;
+    unsigned char decimal_point;
+    size_t i = 0;
+    size_t number_string_length = 0;
+    size_t consumed = 0;
+    cJSON_bool has_decimal_point = false;
+
+    if ((input_buffer == NULL) || (input_buffer->content == NULL))
+    {
+        return false;
+    }
+
+    if (parse_number_fast(buffer_at_offset(input_buffer), input_buffer->length - input_buffer->offset, &number, &consumed))
+    {
+        goto success;
+    }
+
+    /* copy the number into a temporary buffer and replace '.' with the decimal point
+     * of the current locale (for strtod)
+     * This also takes care of '\0' not necessarily being available for marking the end of the input */
+    for (i = 0; can_access_at_index(input_buffer, i); i++)
+    {
+        switch (buffer_at_offset(input_buffer)[i])
+        {
+            case '0':
+            case '1':
+            case '2':
+            case '3':
+            case '4':
+            case '5':
+            case '6':
+            case '7':
+            case '8':
+            case '9':
+            case '+':
+            case '-':
+            case 'e':
+            case 'E':
+                number_string_length++;
+                break;
+
+            case '.':
+                number_string_length++;
+                has_decimal_point = true;
+                break;
+
+            default:
+                goto loop_end;
+        }
+    }
+loop_end:
+    /* only long numbers need a heap buffer, add 1 for '\0' */
+    number_c_string = local_c_string;
+    if (number_string_length >= sizeof(local_c_string))
+    {
+        number_c_string = (unsigned char *) input_buffer->hooks.allocate(number_string_length + 1);
+        if (number_c_string == NULL)
+        {
+            return false; /* allocation failure */
+        }
+    }
+
+    memcpy(number_c_string, buffer_at_offset(input_buffer), number_string_length);
+    number_c_string[number_string_length] = '\0';
+
+    if (has_decimal_point)
+    {
+        decimal_point = get_decimal_point();
+        for (i = 0; i < number_string_length; i++)
+        {
+            if (number_c_string[i] == '.')
+            {
+                /* replace '.' with the decimal point of the current locale (for strtod) */
+                number_c_string[i] = decimal_point;
+            }
+        }
+    }
+
+    number = strtod((const char*)number_c_string, (char**)&after_end);
+    consumed = (size_t)(after_end - number_c_string);
+    /* free the temporary buffer */
+    if (number_c_string != local_c_string)
+    {
+        input_buffer->hooks.deallocate(number_c_string);
+    }
+    if (consumed == 0)
+    {
+        return false; /* parse_error */
+    }
+
+success:
+    item->valuedouble = number;
+
+    /* use saturation in case of overflow */
+    if (number >= INT_MAX)
+    {
+        item->valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        item->valueint = INT_MIN;
+    }
+    else
+    {
+        item->valueint = (int)number;
+    }
+
+    item->type = cJSON_Number;
+
+    input_buffer->offset += consumed;
+    return true;
+}
+
+/* don't ask me, but the original cJSON_SetNumberValue returns an integer or double */
+CJSON_PUBLIC(double) cJSON_SetNumberHelper(cJSON *object, double number)
+{
+    if (number >= INT_MAX)
+    {
+        object->valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        object->valueint = INT_MIN;
+    }
+    else
+    {
+        object->valueint = (int)number;
+    }
+
+    return object->valuedouble = number;
+}
+
+/* Note: when passing a NULL valuestring, cJSON_SetValuestring treats this as an error and return NULL */
+CJSON_PUBLIC(char*) cJSON_SetValuestring(cJSON *object, const char *valuestring)
+{
+    char *copy = NULL;
+    size_t v1_len;
+    size_t v2_len;
+    /* if object's type is not cJSON_String or is cJSON_IsReference, it should not set valuestring */
+    if ((object == NULL) || !(object->type & cJSON_String) || (object->type & cJSON_IsReference))
+    {
+        return NULL;
+    }
+    /* return NULL if the object is corrupted or valuestring is NULL */
+    if (object->valuestring == NULL || valuestring == NULL)
+    {
+        return NULL;
+    }
+
+    v1_len = strlen(valuestring);
+    v2_len = strlen(object->valuestring);
+
+    if (v1_len <= v2_len)
+    {
+        /* strcpy does not handle overlapping string: [X1, X2] [Y1, Y2] => X2 < Y1 or Y2 < X1 */
+        if (!( valuestring + v1_len < object->valuestring || object->valuestring + v2_len < valuestring ))
+        {
+            return NULL;
+        }
+        strcpy(object->valuestring, valuestring);
+        return object->valuestring;
+    }
+    copy = (char*) cJSON_strdup((const unsigned char*)valuestring, &global_hooks);
+    if (copy == NULL)
+    {
+        return NULL;
+    }
+    if (object->valuestring != NULL)
+    {
+        cJSON_free(object->valuestring);
+    }
+    object->valuestring = copy;
+
+    return copy;
+}
+
+typedef struct
+{
+    unsigned char *buffer;
+    size_t length;
+    size_t offset;
+    size_t depth; /* current nesting depth (for formatted printing) */
+    cJSON_bool noalloc;
+    cJSON_bool format; /* is this print a formatted print */
+    internal_hooks hooks;
+} printbuffer;
+
+/* realloc printbuffer if necessary to have at least "needed" bytes more */
+static unsigned char* ensure(printbuffer * const p, size_t needed)
+{
+    unsigned char *newbuffer = NULL;
+    size_t newsize = 0;
+
+    if ((p == NULL) || (p->buffer == NULL))
+    {
+        return NULL;
+    }
+
+    if ((p->length > 0) && (p->offset >= p->length))
+    {
+        /* make sure that offset is valid */
+        return NULL;
+    }
+
+    if (needed > INT_MAX)
+    {
+        /* sizes bigger than INT_MAX are currently not supported */
+        return NULL;
+    }
+
+    needed += p->offset + 1;
+    if (needed <= p->length)
+    {
+        return p->buffer + p->offset;
+    }
+
+    if (p->noalloc) {
+        return NULL;
+    }
+
+    /* calculate new buffer size */
+    if (needed > (INT_MAX / 2))
+    {
+        /* overflow of int, use INT_MAX if possible */
+        if (needed <= INT_MAX)
+        {
+            newsize = INT_MAX;
+        }
+        else
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        newsize = needed * 2;
+    }
+
+    if (p->hooks.reallocate != NULL)
+    {
+        /* reallocate with realloc if available */
+        newbuffer = (unsigned char*)p->hooks.reallocate(p->buffer, newsize);
+        if (newbuffer == NULL)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+    }
+    else
+    {
+        /* otherwise reallocate manually */
+        newbuffer = (unsigned char*)p->hooks.allocate(newsize);
+        if (!newbuffer)
+        {
+            p->hooks.deallocate(p->buffer);
+            p->length = 0;
+            p->buffer = NULL;
+
+            return NULL;
+        }
+
+        memcpy(newbuffer, p->buffer, p->offset + 1);
+        p->hooks.deallocate(p->buffer);
+    }
+    p->length = newsize;
+    p->buffer = newbuffer;
+
+    return newbuffer + p->offset;
+}
+
+/* calculate the new length of the string in a printbuffer and update the offset */
+static void update_offset(printbuffer * const buffer)
+{
+    const unsigned char *buffer_pointer = NULL;
+    if ((buffer == NULL) || (buffer->buffer == NULL))
+    {
+        return;
+    }
+    buffer_pointer = buffer->buffer + buffer->offset;
+
+    buffer->offset += strlen((const char*)buffer_pointer);
+}
+
+/* securely comparison of floating-point variables */
+static cJSON_bool compare_double(double a, double b)
+{
+    double maxVal = fabs(a) > fabs(b) ? fabs(a) : fabs(b);
+    return (fabs(a - b) <= maxVal * DBL_EPSILON);
+}
+
+/* Render the number nicely from the given item into a string. */
+static cJSON_bool print_number(const cJSON * const item, printbuffer * const output_buffer)
+{
+    unsigned char *output_pointer = NULL;
+    double d = item->valuedouble;
+    int length = 0;
+    size_t i = 0;
+    unsigned char number_buffer[26] = {0}; /* temporary buffer to print the number into */
+    unsigned char decimal_point = get_decimal_point();
+    double test = 0.0;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* This checks for NaN and Infinity */
+    if (isnan(d) || isinf(d))
+    {
+        length = sprintf((char*)number_buffer, "null");
+    }
+    else if(d == (double)item->valueint)
+    {
+        length = sprintf((char*)number_buffer, "%d", item->valueint);
+    }
+    else
+    {
+        /* Try 15 decimal places of precision to avoid nonsignificant nonzero digits */
+        length = sprintf((char*)number_buffer, "%1.15g", d);
+
+        /* Check whether the original double can be recovered */
+        if ((sscanf((char*)number_buffer, "%lg", &test) != 1) || !compare_double((double)test, d))
+        {
+            /* If not, print with 17 decimal places of precision */
+            length = sprintf((char*)number_buffer, "%1.17g", d);
+        }
+    }
+
+    /* sprintf failed or buffer overrun occurred */
+    if ((length < 0) || (length > (int)(sizeof(number_buffer) - 1)))
+    {
+        return false;
+    }
+
+    /* reserve appropriate space in the output */
+    output_pointer = ensure(output_buffer, (size_t)length + sizeof(""));
+    if (output_pointer == NULL)
+    {
+        return false;
+    }
+
+    /* copy the printed number to the output and replace locale
+     * dependent decimal point with '.' */
+    for (i = 0; i < ((size_t)length); i++)
+    {
+        if (number_buffer[i] == decimal_point)
+        {
+            output_pointer[i] = '.';
+            continue;
+        }
+
+        output_pointer[i] = number_buffer[i];
+    }
+    output_pointer[i] = '\0';
+
+    output_buffer->offset += (size_t)length;
+
+    return true;
+}
+
+/* parse 4 digit hexadecimal number, PARSE_HEX4_INVALID if one of them is not a hex digit */
+#define PARSE_HEX4_INVALID 0xFFFFFFFFu
+static unsigned parse_hex4(const unsigned char * const input)
+{
+    unsigned int h = 0;
+    size_t i = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        /* parse digit */
+        if ((input[i] >= '0') && (input[i] <= '9'))
+        {
+            h += (unsigned int) input[i] - '0';
+        }
+        else if ((input[i] >= 'A') && (input[i] <= 'F'))
+        {
+            h += (unsigned int) 10 + input[i] - 'A';
+        }
+        else if ((input[i] >= 'a') && (input[i] <= 'f'))
+        {
+            h += (unsigned int) 10 + input[i] - 'a';
+        }
+        else /* invalid */
+        {
+            return PARSE_HEX4_INVALID;
+        }
+
+        if (i < 3)
+        {
+            /* shift left to make place for the next nibble */
+            h = h << 4;
+        }
+    }
+
+    return h;
+}
+
+/* converts a UTF-16 literal to UTF-8
+ * A literal can be one or two sequences of the form \uXXXX */
+static unsigned char utf16_literal_to_utf8(const unsigned char * const input_pointer, const unsigned char * const input_end, unsigned char **output_pointer)
+{
+    long unsigned int codepoint = 0;
+    unsigned int first_code = 0;
+    const unsigned char *first_sequence = input_pointer;
+    unsigned char utf8_length = 0;
+    unsigned char utf8_position = 0;
+    unsigned char sequence_length = 0;
+    unsigned char first_byte_mark = 0;
+
+    if ((input_end - first_sequence) < 6)
+    {
+        /* input ends unexpectedly */
+        goto fail;
+    }
+
+    /* get the first utf16 sequence */
+    first_code = parse_hex4(first_sequence + 2);
+
+    /* check that the code is valid */
+    if ((first_code == PARSE_HEX4_INVALID) || ((first_code >= 0xDC00) && (first_code <= 0xDFFF)))
+    {
+        goto fail;
+    }
+
+    /* UTF16 surrogate pair */
+    if ((first_code >= 0xD800) && (first_code <= 0xDBFF))
+    {
+        const unsigned char *second_sequence = first_sequence + 6;
+        unsigned int second_code = 0;
+        sequence_length = 12; /* \uXXXX\uXXXX */
+
+        if ((input_end - second_sequence) < 6)
+        {
+            /* input ends unexpectedly */
+            goto fail;
+        }
+
+        if ((second_sequence[0] != '\\') || (second_sequence[1] != 'u'))
+        {
+            /* missing second half of the surrogate pair */
+            goto fail;
+        }
+
+        /* get the second utf16 sequence */
+        second_code = parse_hex4(second_sequence + 2);
+        /* check that the code is valid */
+        if ((second_code < 0xDC00) || (second_code > 0xDFFF))
+        {
+            /* invalid second half of the surrogate pair */
+            goto fail;
+        }
+
+
+        /* calculate the unicode codepoint from the surrogate pair */
+        codepoint = 0x10000 + (((first_code & 0x3FF) << 10) | (second_code & 0x3FF));
+    }
+    else
+    {
+        sequence_length = 6; /* \uXXXX */
+        codepoint = first_code;
+    }
+
+    /* encode as UTF-8
+     * takes at maximum 4 bytes to encode:
+     * 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx */
+    if (codepoint < 0x80)
+    {
+        /* normal ascii, encoding 0xxxxxxx */
+        utf8_length = 1;
+    }
+    else if (codepoint < 0x800)
+    {
+        /* two bytes, encoding 110xxxxx 10xxxxxx */
+        utf8_length = 2;
+        first_byte_mark = 0xC0; /* 11000000 */
+    }
+    else if (codepoint < 0x10000)
+    {
+        /* three bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 3;
+        first_byte_mark = 0xE0; /* 11100000 */
+    }
+    else if (codepoint <= 0x10FFFF)
+    {
+        /* four bytes, encoding 1110xxxx 10xxxxxx 10xxxxxx 10xxxxxx */
+        utf8_length = 4;
+        first_byte_mark = 0xF0; /* 11110000 */
+    }
+    else
+    {
+        /* invalid unicode codepoint */
+        goto fail;
+    }
+
+    /* encode as utf8 */
+    for (utf8_position = (unsigned char)(utf8_length - 1); utf8_position > 0; utf8_position--)
+    {
+        /* 10xxxxxx */
+        (*output_pointer)[utf8_position] = (unsigned char)((codepoint | 0x80) & 0xBF);
+        codepoint >>= 6;
+    }
+    /* encode first byte */
+    if (utf8_length > 1)
+    {
+        (*output_pointer)[0] = (unsigned char)((codepoint | first_byte_mark) & 0xFF);
+    }
+    else
+    {
+        (*output_pointer)[0] = (unsigned char)(codepoint & 0x7F);
+    }
+
+    *output_pointer += utf8_length;
+
+    return sequence_length;
+
+fail:
+    return 0;
+}
+
+/* Decode the escaped body of a string literal (between the quotes) into output, which must have
+ * room for at least (input_end - input_pointer) bytes. Returns the end of the decoded text,
+ * or NULL with *failed_at pointing at the offending escape sequence. */
+static unsigned char *unescape_string(const unsigned char *input_pointer, const unsigned char * const input_end, unsigned char *output_pointer, const scan_backend * const scan, const unsigned char **failed_at)
+{
+    while (input_pointer < input_end)
+    {
+        /* copy the run up to the next escape sequence at once */
+        size_t run_length = scan->find_string_special(input_pointer, (size_t)(input_end - input_pointer));
+        memcpy(output_pointer, input_pointer, run_length);
+        output_pointer += run_length;
+        input_pointer += run_length;
+
+        if ((input_pointer < input_end) && (*input_pointer == '\"'))
+        {
+            /* the scan stops at quotes too; inside the body a quote is plain text */
+            *output_pointer++ = *input_pointer++;
+        }
+        else if (input_pointer < input_end)
+        {
+            /* escape sequence */
+            unsigned char sequence_length = 2;
+            if ((input_end - input_pointer) < 2)
+            {
+                goto fail;
+            }
+
+            switch (input_pointer[1])
+            {
+                case 'b':
+                    *output_pointer++ = '\b';
+                    break;
+                case 'f':
+                    *output_pointer++ = '\f';
+                    break;
+                case 'n':
+                    *output_pointer++ = '\n';
+                    break;
+                case 'r':
+                    *output_pointer++ = '\r';
+                    break;
+                case 't':
+                    *output_pointer++ = '\t';
+                    break;
+                case '\"':
+                case '\\':
+                case '/':
+                    *output_pointer++ = input_pointer[1];
+                    break;
+
+                /* UTF-16 literal */
+                case 'u':
+                    sequence_length = utf16_literal_to_utf8(input_pointer, input_end, &output_pointer);
+                    if (sequence_length == 0)
+                    {
+                        /* failed to convert UTF16-literal to UTF-8 */
+                        goto fail;
+                    }
+                    break;
+
+                default:
+                    goto fail;
+            }
+            input_pointer += sequence_length;
+        }
+    }
+
+    return output_pointer;
+
+fail:
+    *failed_at = input_pointer;
+    return NULL;
+}
+
+/* Parse the input text into an unescaped cinput, and populate item. */
+static cJSON_bool parse_string(cJSON * const item, parse_buffer * const input_buffer)
+{
+    const unsigned char *input_pointer = buffer_at_offset(input_buffer) + 1;
+    const unsigned char *input_end = buffer_at_offset(input_buffer) + 1;
+    unsigned char *output_pointer = NULL;
+    unsigned char *output = NULL;
+
+    /* not a string */
+    if (buffer_at_offset(input_buffer)[0] != '\"')
+    {
+        goto fail;
+    }
+
+    {
+        /* calculate approximate size of the output (overestimate) */
+        const unsigned char *content_end = input_buffer->content + input_buffer->length;
+        size_t allocation_length = 0;
+        size_t skipped_bytes = 0;
+        for (;;)
+        {
+            /* jump straight to the next quote or backslash */
+            input_end += input_buffer->scan->find_string_special(input_end, (size_t)(content_end - input_end));
+            if ((input_end >= content_end) || (*input_end == '\"'))
+            {
+                break;
+            }
+            /* is escape sequence */
+            if ((input_end + 1) >= content_end)
+            {
+                /* prevent buffer overflow when last input character is a backslash */
+                goto fail;
+            }
+            skipped_bytes++;
+            input_end += 2;
+        }
+        if ((input_end >= content_end) || (*input_end != '\"'))
+        {
+            goto fail; /* string ended unexpectedly */
+        }
+
+        /* This is at most how much we need for the output */
+        allocation_length = (size_t) (input_end - buffer_at_offset(input_buffer)) - skipped_bytes;
+        output = (unsigned char*)input_buffer->hooks.allocate(allocation_length + sizeof(""));
+        if (output == NULL)
+        {
+            goto fail; /* allocation failure */
+        }
+    }
+
+    output_pointer = unescape_string(input_pointer, input_end, output, input_buffer->scan, &input_pointer);
+    if (output_pointer == NULL)
+    {
+        goto fail;
+    }
+
+    /* zero terminate the output */
+    *output_pointer = '\0';
+
+    item->type = cJSON_String;
+    item->valuestring = (char*)output;
+
+    input_buffer->offset = (size_t) (input_end - input_buffer->content);
+    input_buffer->offset++;
+
+    return true;
+
+fail:
+    if (output != NULL)
+    {
+        input_buffer->hooks.deallocate(output);
+        output = NULL;
+    }
+
+    if (input_pointer != NULL)
+    {
+        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+    }
+
+    return false;
+}
+
+/* Render the cstring provided to an escaped version that can be printed. */
+static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+{
+    const unsigned char *input_pointer = NULL;
+    unsigned char *output = NULL;
+    unsigned char *output_pointer = NULL;
+    size_t output_length = 0;
+    /* numbers of additional characters needed for escaping */
+    size_t escape_characters = 0;
+
+    if (output_buffer == NULL)
+    {
+        return false;
+    }
+
+    /* empty string */
+    if (input == NULL)
+    {
+        output = ensure(output_buffer, sizeof("\"\""));
+        if (output == NULL)
+        {
+            return false;
+        }
+        strcpy((char*)output, "\"\"");
+
+        return true;
+    }
+
+    /* set "flag" to 1 if something needs to be escaped */
+    for (input_pointer = input; *input_pointer; input_pointer++)
+    {
+        switch (*input_pointer)
+        {
+            case '\"':
+            case '\\':
+            case '\b':
+            case '\f':
+            case '\n':
+            case '\r':
+            case '\t':
+                /* one character escape sequence */
+                escape_characters++;
+                break;
+            default:
+                if (*input_pointer < 32)
+                {
+                    /* UTF-16 escape sequence uXXXX */
+                    escape_characters += 5;
+                }
+                break;
+        }
+    }
+    output_length = (size_t)(input_pointer - input) + escape_characters;
+
+    output = ensure(output_buffer, output_length + sizeof("\"\""));
+    if (output == NULL)
+    {
+        return false;
+    }
+
+    /* no characters have to be escaped */
+    if (escape_characters == 0)
+    {
+        output[0] = '\"';
+        memcpy(output + 1, input, output_length);
+        output[output_length + 1] = '\"';
+        output[output_length + 2] = '\0';
+
+        return true;
+    }
+
+    output[0] = '\"';
+    output_pointer = output + 1;
+    /* copy the string */
+    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
+    {
+        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
+        {
+            /* normal character, copy */
+            *output_pointer = *input_pointer;
+        }
+        else
+        {
+            /* character needs to be escaped */
+            *output_pointer++ = '\\';
+            switch (*input_pointer)
+            {
+                case '\\':
+                    *output_pointer = '\\';
+                    break;
+                case '\"':
+                    *output_pointer = '\"';
+                    break;
+                case '\b':
+                    *output_pointer = 'b';
+                    break;
+                case '\f':
+                    *output_pointer = 'f';
+                    break;
+                case '\n':
+                    *output_pointer = 'n';
+                    break;
+                case '\r':
+                    *output_pointer = 'r';
+                    break;
+                case '\t':
+                    *output_pointer = 't';
+                    break;
+                default:
+                    /* escape and print as unicode codepoint */
+                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
+                    output_pointer += 4;
+                    break;
+            }
+        }
+    }
+    output[output_length + 1] = '\"';
+    output[output_length + 2] = '\0';
+
+    return true;
+}
+
+/* Invoke print_string_ptr (which is useful) on an item. */
+static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
+{
+    return print_string_ptr((unsigned char*)item->valuestring, p);
+}
+
+/* Predeclare these prototypes. */
+static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
+static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
+static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
+
+/* Utility to jump whitespace and cr/lf */
+static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL))
+    {
+        return NULL;
+    }
+
+    if (cannot_access_at_index(buffer, 0))
+    {
+        return buffer;
+    }
+
+    /* most tokens are not preceded by whitespace, only hand runs to the scanner */
+    if (buffer_at_offset(buffer)[0] <= 32)
+    {
+        buffer->offset += buffer->scan->skip_whitespace(buffer_at_offset(buffer), buffer->length - buffer->offset);
+    }
+
+    if (buffer->offset == buffer->length)
+    {
+        buffer->offset--;
+    }
+
+    return buffer;
+}
+
+/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
+static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+{
+    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
+    {
+        return NULL;
+    }
+
+    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+    {
+        buffer->offset += 3;
+    }
+
+    return buffer;
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    size_t buffer_length;
+
+    if (NULL == value)
+    {
+        return NULL;
+    }
+
+    /* Adding null character size due to require_null_terminated. */
+    buffer_length = strlen(value) + sizeof("");
+
+    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
+}
+
+/* Parse an object - create a new root, and populate. */
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+{
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, NULL };
+    cJSON *item = NULL;
+
+    /* reset error position */
+    global_error.json = NULL;
+    global_error.position = 0;
+
+    if (value == NULL || 0 == buffer_length)
+    {
+        goto fail;
+    }
+
+    buffer.content = (const unsigned char*)value;
+    buffer.length = buffer_length;
+    buffer.offset = 0;
+    buffer.hooks = global_hooks;
+    buffer.scan = get_scan_backend();
+
+    item = cJSON_New_Item(&global_hooks);
+    if (item == NULL) /* memory fail */
+    {
+        goto fail;
+    }
+
+    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    {
+        /* parse failure. ep is set. */
+        goto fail;
+    }
+
+    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
+    if (require_null_terminated)
+    {
+        buffer_skip_whitespace(&buffer);
+        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        {
+            goto fail;
+        }
+    }
+    if (return_parse_end)
+    {
+        *return_parse_end = (const char*)buffer_at_offset(&buffer);
+    }
+
+    return item;
+
+fail:
+    if (item != NULL)
+    {
+        cJSON_Delete(item);
+    }
+
+    if (value != NULL)
+    {
+        error local_error;
+        local_error.json = (const unsigned char*)value;
+        local_error.position = 0;
+
+        if (buffer.offset < buffer.length)
+        {
+            local_error.position = buffer.offset;
+        }
+        else if (buffer.length > 0)
+        {
+            local_error.position = buffer.length - 1;
+        }
+
+        if (return_parse_end != NULL)
+        {
+            *return_parse_end = (const char*)local_error.json + local_error.position;
+        }
+
+        global_error = local_error;
+    }
+
+    return NULL;
+}
+
+/* Default options for cJSON_Parse */
+CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+{
+    return cJSON_ParseWithOpts(value, 0, 0);
+}
+
+CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+{
+    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+}
+
+/* Event driven parsing: walks the input once and reports every token to a callback,
+ * without allocating a tree. Only the open containers are tracked, one bit per level. */
+typedef struct
+{
+    parse_buffer buffer;
+    cJSON_EventCallback callback;
+    void *user_data;
+    /* bit set for objects, clear for arrays */
+    unsigned char containers[(CJSON_NESTING_LIMIT + 7) / 8];
+    size_t depth;
+} event_parser;
+
+static void event_skip_whitespace(parse_buffer * const buffer)
+{
+    /* unlike buffer_skip_whitespace, never step back onto the last byte */
+    if ((buffer->offset < buffer->length) && (buffer_at_offset(buffer)[0] <= 32))
+    {
+        buffer->offset += buffer->scan->skip_whitespace(buffer_at_offset(buffer), buffer->length - buffer->offset);
+    }
+}
+
+static cJSON_bool event_in_object(const event_parser * const parser)
+{
+    size_t level = parser->depth - 1;
+    return (parser->containers[level / 8] >> (level % 8)) & 1;
+}
+
+static cJSON_bool emit_event(event_parser * const parser, cJSON_EventType type, const unsigned char *start, size_t length, cJSON_bool escaped, double number)
+{
+    cJSON_Event event;
+
+    event.type = type;
+    event.start = (const char*)start;
+    event.length = length;
+    event.escaped = escaped;
+    event.number = number;
+    event.depth = parser->depth;
+
+    return parser->callback(&event, parser->user_data);
+}
+
+/* Find the body of the string literal at the current offset without decoding it. */
+static cJSON_bool scan_string_literal(parse_buffer * const input_buffer, const unsigned char **start, size_t *length, cJSON_bool *escaped)
+{
+    const unsigned char *content_end = input_buffer->content + input_buffer->length;
+    const unsigned char *input_pointer = NULL;
+
+    if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != '\"'))
+    {
+        return false;
+    }
+
+    input_pointer = buffer_at_offset(input_buffer) + 1;
+    *start = input_pointer;
+    *escaped = false;
+    for (;;)
+    {
+        input_pointer += input_buffer->scan->find_string_special(input_pointer, (size_t)(content_end - input_pointer));
+        if (input_pointer >= content_end)
+        {
+            goto fail; /* string ended unexpectedly */
+        }
+        if (*input_pointer == '\"')
+        {
+            break;
+        }
+
+        /* escape sequence, checked here so that decoding the slice later can't fail */
+        if ((content_end - input_pointer) < 2)
+        {
+            goto fail;
+        }
+        switch (input_pointer[1])
+        {
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't':
+            case '\"':
+            case '\\':
+            case '/':
+                input_pointer += 2;
+                break;
+
+            /* UTF-16 literal, decoded into scratch space to apply the same checks as parse_string */
+            case 'u':
+            {
+                unsigned char scratch[4];
+                unsigned char *scratch_pointer = scratch;
+                unsigned char sequence_length = utf16_literal_to_utf8(input_pointer, content_end, &scratch_pointer);
+                if (sequence_length == 0)
+                {
+                    goto fail;
+                }
+                input_pointer += sequence_length;
+                break;
+            }
+
+            default:
+                goto fail;
+        }
+        *escaped = true;
+    }
+
+    *length = (size_t)(input_pointer - *start);
+    input_buffer->offset = (size_t)(input_pointer - input_buffer->content) + 1;
+    return true;
+
+fail:
+    input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+    return false;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseEvents(const char *value, size_t buffer_length, cJSON_EventCallback callback, void *user_data, const char **return_parse_end)
+{
+    event_parser parser;
+    parse_buffer * const buffer = &parser.buffer;
+    const unsigned char *token = NULL;
+    size_t token_length = 0;
+    cJSON_bool escaped = false;
+    cJSON_bool is_object = false;
+
+    /* reset error position */
+    global_error.json = NULL;
+    global_error.position = 0;
+
+    memset(&parser, '\0', sizeof(parser));
+    if ((value == NULL) || (buffer_length == 0) || (callback == NULL))
+    {
+        goto fail;
+    }
+
+    buffer->content = (const unsigned char*)value;
+    buffer->length = buffer_length;
+    buffer->hooks = global_hooks;
+    buffer->scan = get_scan_backend();
+    parser.callback = callback;
+    parser.user_data = user_data;
+
+    skip_utf8_bom(buffer);
+
+parse_value:
+    event_skip_whitespace(buffer);
+    if (cannot_access_at_index(buffer, 0))
+    {
+        goto fail;
+    }
+    token = buffer_at_offset(buffer);
+    switch (token[0])
+    {
+        case '{':
+        case '[':
+            if (parser.depth >= CJSON_NESTING_LIMIT)
+            {
+                goto fail; /* to deeply nested */
+            }
+            is_object = (token[0] == '{');
+            if (!emit_event(&parser, is_object ? cJSON_EventObjectBegin : cJSON_EventArrayBegin, token, 1, false, 0))
+            {
+                goto stopped;
+            }
+            if (is_object)
+            {
+                parser.containers[parser.depth / 8] |= (unsigned char)(1 << (parser.depth % 8));
+            }
+            else
+            {
+                parser.containers[parser.depth / 8] &= (unsigned char)~(1 << (parser.depth % 8));
+            }
+            parser.depth++;
+            buffer->offset++;
+
+            event_skip_whitespace(buffer);
+            if (cannot_access_at_index(buffer, 0))
+            {
+                goto fail;
+            }
+            if (buffer_at_offset(buffer)[0] == (is_object ? '}' : ']'))
+            {
+                goto end_container; /* empty */
+            }
+            if (is_object)
+            {
+                goto parse_key;
+            }
+            goto parse_value;
+
+        case '\"':
+            if (!scan_string_literal(buffer, &token, &token_length, &escaped))
+            {
+                goto fail;
+            }
+            if (!emit_event(&parser, cJSON_EventString, token, token_length, escaped, 0))
+            {
+                goto stopped;
+            }
+            break;
+
+        case 'n':
+        case 't':
+        case 'f':
+        {
+            cJSON_EventType type = cJSON_EventNull;
+            const char *literal = "null";
+            if (token[0] == 't')
+            {
+                type = cJSON_EventTrue;
+                literal = "true";
+            }
+            else if (token[0] == 'f')
+            {
+                type = cJSON_EventFalse;
+                literal = "false";
+            }
+            token_length = strlen(literal);
+            if (!can_read(buffer, token_length) || (strncmp((const char*)token, literal, token_length) != 0))
+            {
+                goto fail;
+            }
+            buffer->offset += token_length;
+            if (!emit_event(&parser, type, token, token_length, false, 0))
+            {
+                goto stopped;
+            }
+            break;
+        }
+
+        default:
+        {
+            cJSON number;
+            if ((token[0] != '-') && ((token[0] < '0') || (token[0] > '9')))
+            {
+                goto fail;
+            }
+            memset(&number, '\0', sizeof(number));
+            if (!parse_number(&number, buffer))
+            {
+                goto fail;
+            }
+            if (!emit_event(&parser, cJSON_EventNumber, token, (size_t)(buffer_at_offset(buffer) - token), false, number.valuedouble))
+            {
+                goto stopped;
+            }
+            break;
+        }
+    }
+
+after_value:
+    if (parser.depth == 0)
+    {
+        goto done;
+    }
+    event_skip_whitespace(buffer);
+    if (cannot_access_at_index(buffer, 0))
+    {
+        goto fail;
+    }
+    is_object = event_in_object(&parser);
+    if (buffer_at_offset(buffer)[0] == ',')
+    {
+        buffer->offset++;
+        if (is_object)
+        {
+            goto parse_key;
+        }
+        goto parse_value;
+    }
+    if (buffer_at_offset(buffer)[0] != (is_object ? '}' : ']'))
+    {
+        goto fail; /* expected end of object/array */
+    }
+
+end_container:
+    is_object = event_in_object(&parser);
+    parser.depth--;
+    token = buffer_at_offset(buffer);
+    buffer->offset++;
+    if (!emit_event(&parser, is_object ? cJSON_EventObjectEnd : cJSON_EventArrayEnd, token, 1, false, 0))
+    {
+        goto stopped;
+    }
+    goto after_value;
+
+parse_key:
+    event_skip_whitespace(buffer);
+    if (!scan_string_literal(buffer, &token, &token_length, &escaped))
+    {
+        goto fail; /* failed to parse name */
+    }
+    event_skip_whitespace(buffer);
+    if (cannot_access_at_index(buffer, 0) || (buffer_at_offset(buffer)[0] != ':'))
+    {
+        goto fail; /* invalid object */
+    }
+    buffer->offset++;
+    if (!emit_event(&parser, cJSON_EventKey, token, token_length, escaped, 0))
+    {
+        goto stopped;
+    }
+    goto parse_value;
+
+stopped:
+    /* the callback asked to stop, the input seen so far was valid */
+done:
+    if (return_parse_end != NULL)
+    {
+        *return_parse_end = (const char*)buffer_at_offset(buffer);
+    }
+
+    return true;
+
+fail:
+    if (value != NULL)
+    {
+        error local_error;
+        local_error.json = (const unsigned char*)value;
+        local_error.position = 0;
+
+        if (buffer->offset < buffer->length)
+        {
+            local_error.position = buffer->offset;
+        }
+        else if (buffer->length > 0)
+        {
+            local_error.position = buffer->length - 1;
+        }
+
+        if (return_parse_end != NULL)
+        {
+            *return_parse_end = (const char*)local_error.json + local_error.position;
+        }
+
+        global_error = local_error;
+    }
+
+    return false;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_UnescapeString(const char *start, size_t length, char *output, size_t output_size)
+{
+    const unsigned char *failed_at = NULL;
+    unsigned char *output_end = NULL;
+
+    /* the decoded text is never longer than the escaped one */
+    if ((start == NULL) || (output == NULL) || (output_size <= length))
+    {
+        return false;
+    }
+
+    output_end = unescape_string((const unsigned char*)start, (const unsigned char*)start + length, (unsigned char*)output, get_scan_backend(), &failed_at);
+    if (output_end == NULL)
+    {
+        output[0] = '\0';
+        return false;
+    }
+    *output_end = '\0';
+
+    return true;
+}
+
+/* Tape parsing, in two passes. Stage 1 classifies the input 64 bytes at a time and collects
+ * the offsets of every structural character, string start and scalar start. Stage 2 walks
+ * those offsets and lays the values out in document order as fixed size records.
+ * Containers remember where they end, so skipping a subtree is a single jump. */
+#define tape_key (1 << 12) /* member name, its value is the next record */
+#define tape_end (1 << 13) /* closes the innermost open container */
+
+typedef struct
+{
+    unsigned int type;
+    /* strings and keys: length in bytes, containers: number of children (saturated) */
+    unsigned int length;
+    union
+    {
+        /* containers: the record after the closing tape_end */
+        size_t after;
+        /* strings and keys: offset into the string buffer */
+        size_t string;
+        double number;
+    } as;
+} tape_entry;
+
+struct cJSON_Tape
+{
+    tape_entry *entries;
+    size_t count;
+    /* all strings and keys, decoded and NUL terminated */
+    char *strings;
+    internal_hooks hooks;
+};
+
+typedef struct
+{
+    const unsigned char *content;
+    size_t length;
+    const scan_backend *scan;
+    internal_hooks hooks;
+    /* stage 1 output */
+    uint32_t *positions;
+    size_t count;
+    size_t capacity;
+    /* stage 2 */
+    size_t next;
+    tape_entry *entries;
+    size_t entry_count;
+    unsigned char *strings;
+    size_t strings_used;
+    size_t error_position;
+} tape_builder;
+
+static size_t lowest_set_bit64(uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(mask);
+#elif defined(_MSC_VER) && defined(_M_X64) && defined(CJSON_SIMD_SSE2)
+    unsigned long index = 0;
+    _BitScanForward64(&index, mask);
+    return (size_t)index;
+#else
+    size_t index = 0;
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+/* bit i of the result is the xor of bits 0..i */
+static uint64_t prefix_xor(uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+
+    return bits;
+}
+
+/* stage 1: offsets of { } [ ] : , of opening quotes and of the first byte of every other token */
+static cJSON_bool find_structurals(tape_builder * const builder)
+{
+    const uint64_t even_bits = UINT64_C(0x5555555555555555);
+    /* carried from one block to the next */
+    uint64_t ends_odd_backslash = 0;
+    uint64_t in_string_carry = 0;
+    uint64_t separator_carry = 1; /* the start of the input separates like whitespace */
+    unsigned char padded[64];
+    size_t offset = 0;
+
+    if (builder->length > UINT32_MAX)
+    {
+        return false; /* offsets are stored in 32 bits */
+    }
+
+    builder->capacity = (builder->length / 8) + 64;
+    builder->positions = (uint32_t*)builder->hooks.allocate(builder->capacity * sizeof(uint32_t));
+    if (builder->positions == NULL)
+    {
+        return false;
+    }
+
+    for (offset = 0; offset < builder->length; offset += 64)
+    {
+        const unsigned char *block = builder->content + offset;
+        block_classes classes;
+        uint64_t escaped = 0;
+        uint64_t quotes = 0;
+        uint64_t in_string = 0;
+        uint64_t separators = 0;
+        uint64_t scalars = 0;
+        uint64_t structurals = 0;
+
+        if ((builder->length - offset) < 64)
+        {
+            /* pad the last block with whitespace */
+            memset(padded, ' ', sizeof(padded));
+            memcpy(padded, block, builder->length - offset);
+            block = padded;
+        }
+        builder->scan->classify_block(block, &classes);
+
+        /* characters escaped by an odd run of backslashes: add the run starts to the runs,
+         * the carry lands right after each run, on an odd or even bit depending on its length */
+        {
+            const uint64_t backslash = classes.backslash;
+            const uint64_t starts = backslash & ~(backslash << 1);
+            const uint64_t even_start_mask = even_bits ^ ends_odd_backslash;
+            const uint64_t even_carries = backslash + (starts & even_start_mask);
+            uint64_t odd_carries = backslash + (starts & ~even_start_mask);
+            const uint64_t odd_overflow = (odd_carries < backslash) ? 1 : 0;
+
+            odd_carries |= ends_odd_backslash;
+            ends_odd_backslash = odd_overflow;
+            escaped = ((even_carries & ~backslash) & ~even_bits) | ((odd_carries & ~backslash) & even_bits);
+        }
+
+        quotes = classes.quote & ~escaped;
+        /* set from each opening quote up to (not including) its closing quote */
+        in_string = prefix_xor(quotes) ^ in_string_carry;
+        in_string_carry = (uint64_t)0 - (in_string >> 63);
+
+        separators = classes.structural | classes.whitespace | quotes;
+        scalars = ~(separators | in_string);
+        structurals = (classes.structural & ~in_string)
+            | (quotes & in_string)
+            | (scalars & ((separators << 1) | separator_carry));
+        separator_carry = separators >> 63;
+
+        if ((builder->capacity - builder->count) < 64)
+        {
+            size_t new_capacity = builder->capacity * 2;
+            uint32_t *new_positions = (uint32_t*)builder->hooks.allocate(new_capacity * sizeof(uint32_t));
+            if (new_positions == NULL)
+            {
+                return false;
+            }
+            memcpy(new_positions, builder->positions, builder->count * sizeof(uint32_t));
+            builder->hooks.deallocate(builder->positions);
+            builder->positions = new_positions;
+            builder->capacity = new_capacity;
+        }
+
+        while (structurals != 0)
+        {
+            builder->positions[builder->count++] = (uint32_t)(offset + lowest_set_bit64(structurals));
+            structurals &= structurals - 1;
+        }
+    }
+
+    if (in_string_carry != 0)
+    {
+        builder->error_position = builder->length - 1;
+        return false; /* unterminated string */
+    }
+
+    return true;
+}
+
+/* a token ending at 'end' may only be followed by whitespace up to the next structural */
+static cJSON_bool tape_token_ends_at(const tape_builder * const builder, size_t end)
+{
+    const size_t expected = (builder->next < builder->count) ? builder->positions[builder->next] : builder->length;
+
+    if (end > expected)
+    {
+        return false;
+    }
+    end += builder->scan->skip_whitespace(builder->content + end, expected - end);
+
+    return end == expected;
+}
+
+static tape_entry *tape_append(tape_builder * const builder, unsigned int type)
+{
+    tape_entry *entry = &builder->entries[builder->entry_count++];
+    entry->type = type;
+    entry->length = 0;
+    entry->as.after = 0;
+
+    return entry;
+}
+
+static cJSON_bool tape_write_string(tape_builder * const builder, size_t position, unsigned int type)
+{
+    const unsigned char *content_end = builder->content + builder->length;
+    const unsigned char *start = builder->content + position + 1;
+    const unsigned char *end = start;
+    const unsigned char *failed_at = NULL;
+    unsigned char *output = builder->strings + builder->strings_used;
+    unsigned char *output_end = NULL;
+    tape_entry *entry = NULL;
+
+    for (;;)
+    {
+        end += builder->scan->find_string_special(end, (size_t)(content_end - end));
+        if (end >= content_end)
+        {
+            return false;
+        }
+        if (*end == '\"')
+        {
+            break;
+        }
+        if ((end + 1) >= content_end)
+        {
+            return false;
+        }
+        end += 2;
+    }
+
+    /* decoded text is never longer than the literal including its quotes */
+    output_end = unescape_string(start, end, output, builder->scan, &failed_at);
+    if ((output_end == NULL) || ((size_t)(output_end - output) > UINT_MAX))
+    {
+        return false;
+    }
+    *output_end = '\0';
+
+    entry = tape_append(builder, type);
+    entry->length = (unsigned int)(output_end - output);
+    entry->as.string = builder->strings_used;
+    builder->strings_used += (size_t)(output_end - output) + 1;
+
+    return tape_token_ends_at(builder, (size_t)(end - builder->content) + 1);
+}
+
+static cJSON_bool tape_write_scalar(tape_builder * const builder, size_t position)
+{
+    const unsigned char *token = builder->content + position;
+    const size_t available = builder->length - position;
+    size_t end = 0;
+
+    switch (token[0])
+    {
+        case 't':
+            if ((available < 4) || (memcmp(token, "true", 4) != 0))
+            {
+                return false;
+            }
+            tape_append(builder, cJSON_True);
+            end = position + 4;
+            break;
+
+        case 'f':
+            if ((available < 5) || (memcmp(token, "false", 5) != 0))
+            {
+                return false;
+            }
+            tape_append(builder, cJSON_False);
+            end = position + 5;
+            break;
+
+        case 'n':
+            if ((available < 4) || (memcmp(token, "null", 4) != 0))
+            {
+                return false;
+            }
+            tape_append(builder, cJSON_NULL);
+            end = position + 4;
+            break;
+
+        default:
+        {
+            parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, NULL };
+            cJSON item;
+
+            if ((token[0] != '-') && ((token[0] < '0') || (token[0] > '9')))
+            {
+                return false;
+            }
+            buffer.content = builder->content;
+            buffer.length = builder->length;
+            buffer.offset = position;
+            buffer.hooks = builder->hooks;
+            buffer.scan = builder->scan;
+            memset(&item, '\0', sizeof(item));
+            if (!parse_number(&item, &buffer))
+            {
+                return false;
+            }
+            tape_append(builder, cJSON_Number)->as.number = item.valuedouble;
+            end = buffer.offset;
+            break;
+        }
+    }
+
+    return tape_token_ends_at(builder, end);
+}
+
+/* stage 2: one record per value, key and container end */
+static cJSON_bool build_tape(tape_builder * const builder)
+{
+    size_t open_containers[CJSON_NESTING_LIMIT];
+    size_t depth = 0;
+    size_t position = 0;
+    cJSON_bool is_object = false;
+
+parse_value:
+    if (builder->next >= builder->count)
+    {
+        return false;
+    }
+    position = builder->positions[builder->next++];
+    builder->error_position = position;
+    switch (builder->content[position])
+    {
+        case '{':
+        case '[':
+            if (depth >= CJSON_NESTING_LIMIT)
+            {
+                return false; /* to deeply nested */
+            }
+            is_object = (builder->content[position] == '{');
+            open_containers[depth++] = builder->entry_count;
+            tape_append(builder, is_object ? cJSON_Object : cJSON_Array);
+
+            if (builder->next >= builder->count)
+            {
+                return false;
+            }
+            if (builder->content[builder->positions[builder->next]] == (is_object ? '}' : ']'))
+            {
+                builder->next++;
+                goto end_container; /* empty */
+            }
+            if (is_object)
+            {
+                goto parse_key;
+            }
+            goto parse_value;
+
+        case '\"':
+            if (!tape_write_string(builder, position, cJSON_String))
+            {
+                return false;
+            }
+            break;
+
+        default:
+            if (!tape_write_scalar(builder, position))
+            {
+                return false;
+            }
+            break;
+    }
+
+after_value:
+    if (depth == 0)
+    {
+        /* the whole input has to be one value */
+        return builder->next == builder->count;
+    }
+    {
+        tape_entry *container = &builder->entries[open_containers[depth - 1]];
+        if (container->length < UINT_MAX)
+        {
+            container->length++;
+        }
+        is_object = (container->type == cJSON_Object);
+    }
+    if (builder->next >= builder->count)
+    {
+        return false;
+    }
+    position = builder->positions[builder->next++];
+    builder->error_position = position;
+    if (builder->content[position] == ',')
+    {
+        if (is_object)
+        {
+            goto parse_key;
+        }
+        goto parse_value;
+    }
+    if (builder->content[position] != (is_object ? '}' : ']'))
+    {
+        return false; /* expected end of object/array */
+    }
+
+end_container:
+    depth--;
+    tape_append(builder, tape_end);
+    builder->entries[open_containers[depth]].as.after = builder->entry_count;
+    goto after_value;
+
+parse_key:
+    if (builder->next >= builder->count)
+    {
+        return false;
+    }
+    position = builder->positions[builder->next++];
+    builder->error_position = position;
+    if ((builder->content[position] != '\"') || !tape_write_string(builder, position, tape_key))
+    {
+        return false; /* failed to parse name */
+    }
+    if ((builder->next >= builder->count) || (builder->content[builder->positions[builder->next]] != ':'))
+    {
+        return false; /* invalid object */
+    }
+    builder->next++;
+    goto parse_value;
+}
+
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTape(const char *value, size_t buffer_length, const char **return_error)
+{
+    tape_builder builder;
+    cJSON_Tape *tape = NULL;
+    size_t bom_length = 0;
+
+    if (return_error != NULL)
+    {
+        *return_error = NULL;
+    }
+
+    memset(&builder, '\0', sizeof(builder));
+    if ((value == NULL) || (buffer_length == 0))
+    {
+        goto fail;
+    }
+
+    if ((buffer_length >= 3) && (strncmp(value, "\xEF\xBB\xBF", 3) == 0))
+    {
+        bom_length = 3;
+    }
+    builder.content = (const unsigned char*)value + bom_length;
+    builder.length = buffer_length - bom_length;
+    builder.hooks = global_hooks;
+    builder.scan = get_scan_backend();
+
+    if ((builder.length == 0) || !find_structurals(&builder) || (builder.count == 0))
+    {
+        goto fail;
+    }
+
+    /* every structural yields at most one record, strings shrink when decoded */
+    builder.entries = (tape_entry*)builder.hooks.allocate(builder.count * sizeof(tape_entry));
+    builder.strings = (unsigned char*)builder.hooks.allocate(builder.length + 1);
+    tape = (cJSON_Tape*)builder.hooks.allocate(sizeof(cJSON_Tape));
+    if ((builder.entries == NULL) || (builder.strings == NULL) || (tape == NULL))
+    {
+        goto fail;
+    }
+
+    if (!build_tape(&builder))
+    {
+        goto fail;
+    }
+
+    builder.hooks.deallocate(builder.positions);
+    if ((builder.hooks.reallocate != NULL) && (builder.strings_used > 0))
+    {
+        unsigned char *strings = (unsigned char*)builder.hooks.reallocate(builder.strings, builder.strings_used);
+        if (strings != NULL)
+        {
+            builder.strings = strings;
+        }
+    }
+
+    tape->entries = builder.entries;
+    tape->count = builder.entry_count;
+    tape->strings = (char*)builder.strings;
+    tape->hooks = builder.hooks;
+
+    return tape;
+
+fail:
+    if (builder.positions != NULL)
+    {
+        builder.hooks.deallocate(builder.positions);
+    }
+    if (builder.entries != NULL)
+    {
+        builder.hooks.deallocate(builder.entries);
+    }
+    if (builder.strings != NULL)
+    {
+        builder.hooks.deallocate(builder.strings);
+    }
+    if (tape != NULL)
+    {
+        builder.hooks.deallocate(tape);
+    }
+
+    if ((value != NULL) && (return_error != NULL))
+    {
+        *return_error = value + bom_length + builder.error_position;
+    }
+
+    return NULL;
+}
+
+CJSON_PUBLIC(void) cJSON_DeleteTape(cJSON_Tape *tape)
+{
+    if (tape == NULL)
+    {
+        return;
+    }
+
+    tape->hooks.deallocate(tape->entries);
+    tape->hooks.deallocate(tape->strings);
+    tape->hooks.deallocate(tape);
+}
+
+/* the record of a value, NULL for anything else */
+static const tape_entry *tape_value(const cJSON_Tape * const tape, size_t value)
+{
+    if ((tape == NULL) || (value >= tape->count) || (tape->entries[value].type & (tape_key | tape_end)))
+    {
+        return NULL;
+    }
+
+    return &tape->entries[value];
+}
+
+/* the value starting at record (stepping over its name), 0 where the container closes */
+static size_t tape_member(const cJSON_Tape * const tape, size_t record)
+{
+    if ((record >= tape->count) || (tape->entries[record].type == tape_end))
+    {
+        return 0;
+    }
+    if (tape->entries[record].type == tape_key)
+    {
+        return record + 1;
+    }
+
+    return record;
+}
+
+CJSON_PUBLIC(int) cJSON_TapeType(const cJSON_Tape *tape, size_t value)
+{
+    const tape_entry *entry = tape_value(tape, value);
+    return (entry != NULL) ? (int)entry->type : cJSON_Invalid;
+}
+
+CJSON_PUBLIC(int) cJSON_TapeSize(const cJSON_Tape *tape, size_t value)
+{
+    const tape_entry *entry = tape_value(tape, value);
+    if ((entry == NULL) || !(entry->type & (cJSON_Array | cJSON_Object)))
+    {
+        return 0;
+    }
+
+    return (entry->length > INT_MAX) ? INT_MAX : (int)entry->length;
+}
+
+CJSON_PUBLIC(size_t) cJSON_TapeChild(const cJSON_Tape *tape, size_t value)
+{
+    const tape_entry *entry = tape_value(tape, value);
+    if ((entry == NULL) || !(entry->type & (cJSON_Array | cJSON_Object)))
+    {
+        return 0;
+    }
+
+    return tape_member(tape, value + 1);
+}
+
+CJSON_PUBLIC(size_t) cJSON_TapeNext(const cJSON_Tape *tape, size_t value)
+{
+    const tape_entry *entry = tape_value(tape, value);
+    if ((entry == NULL) || (value == 0))
+    {
+        return 0;
+    }
+
+    return tape_member(tape, (entry->type & (cJSON_Array | cJSON_Object)) ? entry->as.after : value + 1);
+}
+
+CJSON_PUBLIC(const char *) cJSON_TapeKey(const cJSON_Tape *tape, size_t value)
+{
+    if ((tape_value(tape, value) == NULL) || (value == 0) || (tape->entries[value - 1].type != tape_key))
+    {
+        return NULL;
+    }
+
+    return tape->strings + tape->entries[value - 1].as.string;
+}
+
+CJSON_PUBLIC(size_t) cJSON_TapeGetObjectItem(const cJSON_Tape *tape, size_t object, const char *key)
+{
+    size_t member = 0;
+    size_t key_length = 0;
+
+    if ((key == NULL) || (cJSON_TapeType(tape, object) != cJSON_Object))
+    {
+        return 0;
+    }
+
+    key_length = strlen(key);
+    for (member = cJSON_TapeChild(tape, object); member != 0; member = cJSON_TapeNext(tape, member))
+    {
+        const tape_entry *name = &tape->entries[member - 1];
+        if ((name->length == key_length) && (memcmp(tape->strings + name->as.string, key, key_length) == 0))
+        {
+            return member;
+        }
+    }
+
+    return 0;
+}
+
+CJSON_PUBLIC(size_t) cJSON_TapeGetArrayItem(const cJSON_Tape *tape, size_t array, int index)
+{
+    size_t element = 0;
+
+    if ((index < 0) || (cJSON_TapeType(tape, array) != cJSON_Array))
+    {
+        return 0;
+    }
+
+    for (element = cJSON_TapeChild(tape, array); (element != 0) && (index > 0); index--)
+    {
+        element = cJSON_TapeNext(tape, element);
+    }
+
+    return element;
+}
+
+CJSON_PUBLIC(const char *) cJSON_TapeString(const cJSON_Tape *tape, size_t value)
+{
+    const tape_entry *entry = tape_value(tape, value);
+    if ((entry == NULL) || (entry->type != cJSON_String))
+    {
+        return NULL;
+    }
+
+    return tape->strings + entry->as.string;
+}
+
+CJSON_PUBLIC(double) cJSON_TapeNumber(const cJSON_Tape *tape, size_t value)
+{
+    const tape_entry *entry = tape_value(tape, value);
+    if ((entry == NULL) || (entry->type != cJSON_Number))
+    {
+        return (double) NAN;
+    }
+
+    return entry->as.number;
+}
+
+/* Lazy parsing: a value is only a position in the input. Looking something up skips over
+ * the values in front of it by matching quotes and brackets, nothing is decoded or allocated
+ * until it is asked for. Skipped subtrees are not validated beyond that. */
+static const unsigned char *lazy_skip_whitespace(const unsigned char *input, const unsigned char *end)
+{
+    if ((input < end) && (*input <= 32))
+    {
+        input += get_scan_backend()->skip_whitespace(input, (size_t)(end - input));
+    }
+
+    return input;
+}
 
-    if (input_pointer != NULL)
+/* input points at an opening quote, returns the closing one or NULL */
+static const unsigned char *lazy_string_end(const unsigned char *input, const unsigned char *end)
+{
+    const scan_backend *scan = get_scan_backend();
+
+    input++;
+    for (;;)
     {
-        input_buffer->offset = (size_t)(input_pointer - input_buffer->content);
+        input += scan->find_string_special(input, (size_t)(end - input));
+        if (input >= end)
+        {
+            return NULL;
+        }
+        if (*input == '\"')
+        {
+            return input;
+        }
+        if ((input + 1) >= end)
+        {
+            return NULL;
+        }
+        input += 2;
     }
-
-    return false;
 }
 
-/* Render the cstring provided to an escaped version that can be printed. */
-static cJSON_bool print_string_ptr(const unsigned char * const input, printbuffer * const output_buffer)
+/* returns the first byte after the value at input, or NULL if it is cut off */
+static const unsigned char *lazy_skip_value(const unsigned char *input, const unsigned char *end)
 {
-    const unsigned char *input_pointer = NULL;
-    unsigned char *output = NULL;
-    unsigned char *output_pointer = NULL;
-    size_t output_length = 0;
-    /* numbers of additional characters needed for escaping */
-    size_t escape_characters = 0;
+    size_t depth = 0;
 
-    if (output_buffer == NULL)
+    if (input >= end)
     {
-        return false;
+        return NULL;
     }
 
-    /* empty string */
-    if (input == NULL)
+    if ((*input != '{') && (*input != '[') && (*input != '\"'))
     {
-        output = ensure(output_buffer, sizeof("\"\""));
-        if (output == NULL)
+        /* scalars end at the next separator */
+        while ((input < end) && (*input > 32) && (*input != ',') && (*input != '}') && (*input != ']'))
         {
-            return false;
+            input++;
         }
-        strcpy((char*)output, "\"\"");
-
-        return true;
+        return input;
     }
 
-    /* set "flag" to 1 if something needs to be escaped */
-    for (input_pointer = input; *input_pointer; input_pointer++)
+    do
     {
-        switch (*input_pointer)
+        switch (*input)
         {
             case '\"':
-            case '\\':
-            case '\b':
-            case '\f':
-            case '\n':
-            case '\r':
-            case '\t':
-                /* one character escape sequence */
-                escape_characters++;
-                break;
-            default:
-                if (*input_pointer < 32)
+                input = lazy_string_end(input, end);
+                if (input == NULL)
                 {
-                    /* UTF-16 escape sequence uXXXX */
-                    escape_characters += 5;
+                    return NULL;
                 }
                 break;
+            case '{':
+            case '[':
+                depth++;
+                break;
+            case '}':
+            case ']':
+                depth--;
+                break;
+            default:
+                break;
         }
-    }
-    output_length = (size_t)(input_pointer - input) + escape_characters;
+        input++;
+    } while ((depth > 0) && (input < end));
 
-    output = ensure(output_buffer, output_length + sizeof("\"\""));
-    if (output == NULL)
-    {
-        return false;
-    }
+    return (depth == 0) ? input : NULL;
+}
 
-    /* no characters have to be escaped */
-    if (escape_characters == 0)
-    {
-        output[0] = '\"';
-        memcpy(output + 1, input, output_length);
-        output[output_length + 1] = '\"';
-        output[output_length + 2] = '\0';
+/* fill item with the container member starting at input (a name for objects), false at the end */
+static cJSON_bool lazy_member(const unsigned char *input, const unsigned char *end, cJSON_bool in_object, cJSON_Lazy *item)
+{
+    const unsigned char *key_end = NULL;
 
-        return true;
+    input = lazy_skip_whitespace(input, end);
+    if (input >= end)
+    {
+        return false;
     }
 
-    output[0] = '\"';
-    output_pointer = output + 1;
-    /* copy the string */
-    for (input_pointer = input; *input_pointer != '\0'; (void)input_pointer++, output_pointer++)
+    item->key = NULL;
+    item->key_length = 0;
+    if (in_object)
     {
-        if ((*input_pointer > 31) && (*input_pointer != '\"') && (*input_pointer != '\\'))
+        if ((*input != '\"') || ((key_end = lazy_string_end(input, end)) == NULL))
         {
-            /* normal character, copy */
-            *output_pointer = *input_pointer;
+            return false;
         }
-        else
+        item->key = (const char*)input + 1;
+        item->key_length = (size_t)(key_end - input) - 1;
+
+        input = lazy_skip_whitespace(key_end + 1, end);
+        if ((input >= end) || (*input != ':'))
         {
-            /* character needs to be escaped */
-            *output_pointer++ = '\\';
-            switch (*input_pointer)
-            {
-                case '\\':
-                    *output_pointer = '\\';
-                    break;
-                case '\"':
-                    *output_pointer = '\"';
-                    break;
-                case '\b':
-                    *output_pointer = 'b';
-                    break;
-                case '\f':
-                    *output_pointer = 'f';
-                    break;
-                case '\n':
-                    *output_pointer = 'n';
-                    break;
-                case '\r':
-                    *output_pointer = 'r';
-                    break;
-                case '\t':
-                    *output_pointer = 't';
-                    break;
-                default:
-                    /* escape and print as unicode codepoint */
-                    sprintf((char*)output_pointer, "u%04x", *input_pointer);
-                    output_pointer += 4;
-                    break;
-            }
+            return false;
         }
+        input = lazy_skip_whitespace(input + 1, end);
+    }
+    if ((input >= end) || (*input == '}') || (*input == ']') || (*input == ','))
+    {
+        return false;
     }
-    output[output_length + 1] = '\"';
-    output[output_length + 2] = '\0';
+
+    item->value = (const char*)input;
+    item->end = (const char*)end;
 
     return true;
 }
 
-/* Invoke print_string_ptr (which is useful) on an item. */
-static cJSON_bool print_string(const cJSON * const item, printbuffer * const p)
+static cJSON_bool lazy_key_equals(const cJSON_Lazy * const item, const char *name, size_t name_length)
 {
-    return print_string_ptr((unsigned char*)item->valuestring, p);
-}
-
-/* Predeclare these prototypes. */
-static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_value(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_array(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_array(const cJSON * const item, printbuffer * const output_buffer);
-static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer);
-static cJSON_bool print_object(const cJSON * const item, printbuffer * const output_buffer);
+    unsigned char local_key[128];
+    unsigned char *key = local_key;
+    unsigned char *key_end = NULL;
+    const unsigned char *failed_at = NULL;
+    cJSON_bool equal = false;
 
-/* Utility to jump whitespace and cr/lf */
-static parse_buffer *buffer_skip_whitespace(parse_buffer * const buffer)
-{
-    if ((buffer == NULL) || (buffer->content == NULL))
+    if (memchr(item->key, '\\', item->key_length) == NULL)
     {
-        return NULL;
+        return (item->key_length == name_length) && (memcmp(item->key, name, name_length) == 0);
     }
 
-    if (cannot_access_at_index(buffer, 0))
+    /* escaped names are decoded first, they are never longer than the literal */
+    if (item->key_length < name_length)
     {
-        return buffer;
+        return false;
     }
-
-    while (can_access_at_index(buffer, 0) && (buffer_at_offset(buffer)[0] <= 32))
+    if (item->key_length >= sizeof(local_key))
     {
-       buffer->offset++;
+        key = (unsigned char*)global_hooks.allocate(item->key_length + 1);
+        if (key == NULL)
+        {
+            return false;
+        }
     }
-
-    if (buffer->offset == buffer->length)
+    key_end = unescape_string((const unsigned char*)item->key, (const unsigned char*)item->key + item->key_length, key, get_scan_backend(), &failed_at);
+    equal = (key_end != NULL) && ((size_t)(key_end - key) == name_length) && (memcmp(key, name, name_length) == 0);
+    if (key != local_key)
     {
-        buffer->offset--;
+        global_hooks.deallocate(key);
     }
 
-    return buffer;
+    return equal;
 }
 
-/* skip the UTF-8 BOM (byte order mark) if it is at the beginning of a buffer */
-static parse_buffer *skip_utf8_bom(parse_buffer * const buffer)
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyParse(const char *value, size_t buffer_length, cJSON_Lazy *root)
 {
-    if ((buffer == NULL) || (buffer->content == NULL) || (buffer->offset != 0))
+    const unsigned char *input = (const unsigned char*)value;
+    const unsigned char *end = input + buffer_length;
+
+    if ((value == NULL) || (root == NULL) || (buffer_length == 0))
     {
-        return NULL;
+        return false;
     }
 
-    if (can_access_at_index(buffer, 4) && (strncmp((const char*)buffer_at_offset(buffer), "\xEF\xBB\xBF", 3) == 0))
+    if ((buffer_length >= 3) && (strncmp(value, "\xEF\xBB\xBF", 3) == 0))
     {
-        buffer->offset += 3;
+        input += 3;
+    }
+    input = lazy_skip_whitespace(input, end);
+    if (input >= end)
+    {
+        return false;
     }
 
-    return buffer;
+    root->value = (const char*)input;
+    root->end = (const char*)end;
+    root->key = NULL;
+    root->key_length = 0;
+
+    return cJSON_LazyType(root) != cJSON_Invalid;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated)
+CJSON_PUBLIC(int) cJSON_LazyType(const cJSON_Lazy *item)
 {
-    size_t buffer_length;
+    if ((item == NULL) || (item->value == NULL) || (item->value >= item->end))
+    {
+        return cJSON_Invalid;
+    }
 
-    if (NULL == value)
+    switch (item->value[0])
     {
-        return NULL;
+        case '{':
+            return cJSON_Object;
+        case '[':
+            return cJSON_Array;
+        case '\"':
+            return cJSON_String;
+        case 't':
+            return cJSON_True;
+        case 'f':
+            return cJSON_False;
+        case 'n':
+            return cJSON_NULL;
+        default:
+            if ((item->value[0] == '-') || ((item->value[0] >= '0') && (item->value[0] <= '9')))
+            {
+                return cJSON_Number;
+            }
+            return cJSON_Invalid;
     }
+}
 
-    /* Adding null character size due to require_null_terminated. */
-    buffer_length = strlen(value) + sizeof("");
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyChild(const cJSON_Lazy *container, cJSON_Lazy *item)
+{
+    const int type = cJSON_LazyType(container);
 
-    return cJSON_ParseWithLengthOpts(value, buffer_length, return_parse_end, require_null_terminated);
+    if (((type != cJSON_Object) && (type != cJSON_Array)) || (item == NULL))
+    {
+        return false;
+    }
+
+    return lazy_member((const unsigned char*)container->value + 1, (const unsigned char*)container->end, type == cJSON_Object, item);
 }
 
-/* Parse an object - create a new root, and populate. */
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated)
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyNext(const cJSON_Lazy *item, cJSON_Lazy *next)
 {
-    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 } };
-    cJSON *item = NULL;
-
-    /* reset error position */
-    global_error.json = NULL;
-    global_error.position = 0;
+    const unsigned char *end = NULL;
+    const unsigned char *input = NULL;
 
-    if (value == NULL || 0 == buffer_length)
+    if ((cJSON_LazyType(item) == cJSON_Invalid) || (next == NULL))
     {
-        goto fail;
+        return false;
     }
 
-    buffer.content = (const unsigned char*)value;
-    buffer.length = buffer_length;
-    buffer.offset = 0;
-    buffer.hooks = global_hooks;
-
-    item = cJSON_New_Item(&global_hooks);
-    if (item == NULL) /* memory fail */
+    end = (const unsigned char*)item->end;
+    input = lazy_skip_value((const unsigned char*)item->value, end);
+    if (input == NULL)
     {
-        goto fail;
+        return false;
+    }
+    input = lazy_skip_whitespace(input, end);
+    if ((input >= end) || (*input != ','))
+    {
+        return false;
     }
 
-    if (!parse_value(item, buffer_skip_whitespace(skip_utf8_bom(&buffer))))
+    return lazy_member(input + 1, end, item->key != NULL, next);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyGetObjectItem(const cJSON_Lazy *object, const char *name, cJSON_Lazy *item)
+{
+    cJSON_Lazy member;
+    size_t name_length = 0;
+    cJSON_bool found = false;
+
+    if ((name == NULL) || (item == NULL) || (cJSON_LazyType(object) != cJSON_Object))
     {
-        /* parse failure. ep is set. */
-        goto fail;
+        return false;
     }
 
-    /* if we require null-terminated JSON without appended garbage, skip and then check for a null terminator */
-    if (require_null_terminated)
+    name_length = strlen(name);
+    for (found = cJSON_LazyChild(object, &member); found; found = cJSON_LazyNext(&member, &member))
     {
-        buffer_skip_whitespace(&buffer);
-        if ((buffer.offset >= buffer.length) || buffer_at_offset(&buffer)[0] != '\0')
+        if (lazy_key_equals(&member, name, name_length))
         {
-            goto fail;
+            *item = member;
+            return true;
         }
     }
-    if (return_parse_end)
-    {
-        *return_parse_end = (const char*)buffer_at_offset(&buffer);
-    }
 
-    return item;
+    return false;
+}
 
-fail:
-    if (item != NULL)
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyGetArrayItem(const cJSON_Lazy *array, int index, cJSON_Lazy *item)
+{
+    cJSON_Lazy element;
+    cJSON_bool found = false;
+
+    if ((index < 0) || (item == NULL) || (cJSON_LazyType(array) != cJSON_Array))
     {
-        cJSON_Delete(item);
+        return false;
     }
 
-    if (value != NULL)
+    for (found = cJSON_LazyChild(array, &element); found && (index > 0); index--)
     {
-        error local_error;
-        local_error.json = (const unsigned char*)value;
-        local_error.position = 0;
+        found = cJSON_LazyNext(&element, &element);
+    }
+    if (found)
+    {
+        *item = element;
+    }
 
-        if (buffer.offset < buffer.length)
-        {
-            local_error.position = buffer.offset;
-        }
-        else if (buffer.length > 0)
-        {
-            local_error.position = buffer.length - 1;
-        }
+    return found;
+}
 
-        if (return_parse_end != NULL)
-        {
-            *return_parse_end = (const char*)local_error.json + local_error.position;
-        }
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyGetString(const cJSON_Lazy *item, char *buffer, size_t buffer_size)
+{
+    const unsigned char *string_end = NULL;
 
-        global_error = local_error;
+    if (cJSON_LazyType(item) != cJSON_String)
+    {
+        return false;
+    }
+
+    string_end = lazy_string_end((const unsigned char*)item->value, (const unsigned char*)item->end);
+    if (string_end == NULL)
+    {
+        return false;
     }
 
-    return NULL;
+    return cJSON_UnescapeString(item->value + 1, (size_t)((const char*)string_end - item->value) - 1, buffer, buffer_size);
 }
 
-/* Default options for cJSON_Parse */
-CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value)
+CJSON_PUBLIC(double) cJSON_LazyGetNumber(const cJSON_Lazy *item)
 {
-    return cJSON_ParseWithOpts(value, 0, 0);
+    parse_buffer buffer = { 0, 0, 0, 0, { 0, 0, 0 }, NULL };
+    cJSON number;
+
+    if (cJSON_LazyType(item) != cJSON_Number)
+    {
+        return (double) NAN;
+    }
+
+    buffer.content = (const unsigned char*)item->value;
+    buffer.length = (size_t)(item->end - item->value);
+    buffer.hooks = global_hooks;
+    buffer.scan = get_scan_backend();
+    memset(&number, '\0', sizeof(number));
+    if (!parse_number(&number, &buffer))
+    {
+        return (double) NAN;
+    }
+
+    return number.valuedouble;
 }
 
-CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_length)
+CJSON_PUBLIC(cJSON *) cJSON_LazyMaterialize(const cJSON_Lazy *item)
 {
-    return cJSON_ParseWithLengthOpts(value, buffer_length, 0, 0);
+    if (cJSON_LazyType(item) == cJSON_Invalid)
+    {
+        return NULL;
+    }
+
+    /* parses just this value, whatever follows it is left alone */
+    return cJSON_ParseWithLengthOpts(item->value, (size_t)(item->end - item->value), NULL, false);
 }
 
 #define cjson_min(a, b) (((a) < (b)) ? (a) : (b))
@@ -1359,6 +3799,339 @@ CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, cons
     return print_value(item, &p);
 }
 
+/* Streaming writer: a fixed printbuffer over the caller's memory plus one bit per open container */
+static cJSON_bool writer_in_object(const cJSON_Writer * const writer)
+{
+    size_t level = writer->depth - 1;
+    return (writer->objects[level / 8] >> (level % 8)) & 1;
+}
+
+static cJSON_bool writer_fail(cJSON_Writer * const writer)
+{
+    writer->failed = true;
+    if ((writer->buffer != NULL) && (writer->size > 0))
+    {
+        /* drop whatever a failed call managed to render */
+        writer->buffer[writer->length] = '\0';
+    }
+
+    return false;
+}
+
+/* slack: print_string_ptr and print_number ask ensure() for one byte more than they write,
+ * so they get to see the buffer one byte larger to make an exactly sized buffer work */
+static void writer_printbuffer(const cJSON_Writer * const writer, printbuffer * const output_buffer, size_t slack)
+{
+    output_buffer->buffer = (unsigned char*)writer->buffer;
+    output_buffer->length = writer->size + slack;
+    output_buffer->offset = writer->length;
+    output_buffer->depth = 0;
+    output_buffer->noalloc = true;
+    output_buffer->format = false;
+    output_buffer->hooks = global_hooks;
+}
+
+static cJSON_bool writer_append(cJSON_Writer * const writer, const char *text, size_t length)
+{
+    /* keep room for the terminator */
+    if (length >= (writer->size - writer->length))
+    {
+        return writer_fail(writer);
+    }
+    memcpy(writer->buffer + writer->length, text, length);
+    writer->length += length;
+    writer->buffer[writer->length] = '\0';
+
+    return true;
+}
+
+/* emit the separator in front of a value, and check that a value is allowed here */
+static cJSON_bool writer_begin_value(cJSON_Writer * const writer)
+{
+    size_t level = 0;
+
+    if (writer->failed)
+    {
+        return false;
+    }
+
+    if (writer->depth == 0)
+    {
+        /* only a single root value */
+        return (writer->length == 0) ? true : writer_fail(writer);
+    }
+
+    if (writer_in_object(writer))
+    {
+        /* the key already took care of the comma */
+        if (!writer->expect_value)
+        {
+            return writer_fail(writer);
+        }
+        writer->expect_value = false;
+        return true;
+    }
+
+    level = writer->depth - 1;
+    if ((writer->has_items[level / 8] >> (level % 8)) & 1)
+    {
+        return writer_append(writer, ",", 1);
+    }
+    writer->has_items[level / 8] |= (unsigned char)(1 << (level % 8));
+
+    return true;
+}
+
+static cJSON_bool writer_begin_container(cJSON_Writer * const writer, cJSON_bool is_object)
+{
+    size_t level = writer->depth;
+
+    if (!writer_begin_value(writer))
+    {
+        return false;
+    }
+    if (level >= CJSON_NESTING_LIMIT)
+    {
+        return writer_fail(writer);
+    }
+    if (!writer_append(writer, is_object ? "{" : "[", 1))
+    {
+        return false;
+    }
+
+    if (is_object)
+    {
+        writer->objects[level / 8] |= (unsigned char)(1 << (level % 8));
+    }
+    else
+    {
+        writer->objects[level / 8] &= (unsigned char)~(1 << (level % 8));
+    }
+    writer->has_items[level / 8] &= (unsigned char)~(1 << (level % 8));
+    writer->depth++;
+
+    return true;
+}
+
+static cJSON_bool writer_end_container(cJSON_Writer * const writer, cJSON_bool is_object)
+{
+    if (writer->failed)
+    {
+        return false;
+    }
+    if ((writer->depth == 0) || (writer_in_object(writer) != is_object) || writer->expect_value)
+    {
+        return writer_fail(writer);
+    }
+    if (!writer_append(writer, is_object ? "}" : "]", 1))
+    {
+        return false;
+    }
+    writer->depth--;
+
+    return true;
+}
+
+CJSON_PUBLIC(void) cJSON_WriterInit(cJSON_Writer *writer, char *buffer, size_t size)
+{
+    if (writer == NULL)
+    {
+        return;
+    }
+
+    memset(writer, '\0', sizeof(*writer));
+    writer->buffer = buffer;
+    writer->size = size;
+    if ((buffer == NULL) || (size == 0) || (size > INT_MAX))
+    {
+        writer->failed = true;
+        return;
+    }
+    buffer[0] = '\0';
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteObjectBegin(cJSON_Writer *writer)
+{
+    return (writer != NULL) && writer_begin_container(writer, true);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteObjectEnd(cJSON_Writer *writer)
+{
+    return (writer != NULL) && writer_end_container(writer, true);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteArrayBegin(cJSON_Writer *writer)
+{
+    return (writer != NULL) && writer_begin_container(writer, false);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteArrayEnd(cJSON_Writer *writer)
+{
+    return (writer != NULL) && writer_end_container(writer, false);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteKey(cJSON_Writer *writer, const char *key)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    size_t level = 0;
+
+    if ((writer == NULL) || writer->failed)
+    {
+        return false;
+    }
+    if ((key == NULL) || (writer->depth == 0) || !writer_in_object(writer) || writer->expect_value)
+    {
+        return writer_fail(writer);
+    }
+
+    level = writer->depth - 1;
+    if (((writer->has_items[level / 8] >> (level % 8)) & 1) && !writer_append(writer, ",", 1))
+    {
+        return false;
+    }
+    writer->has_items[level / 8] |= (unsigned char)(1 << (level % 8));
+
+    writer_printbuffer(writer, &p, 1);
+    if (!print_string_ptr((const unsigned char*)key, &p))
+    {
+        return writer_fail(writer);
+    }
+    update_offset(&p);
+    writer->length = p.offset;
+    if (!writer_append(writer, ":", 1))
+    {
+        return false;
+    }
+    writer->expect_value = true;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteString(cJSON_Writer *writer, const char *string)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+
+    if ((writer == NULL) || !writer_begin_value(writer))
+    {
+        return false;
+    }
+
+    writer_printbuffer(writer, &p, 1);
+    if (!print_string_ptr((const unsigned char*)string, &p))
+    {
+        return writer_fail(writer);
+    }
+    update_offset(&p);
+    writer->length = p.offset;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteNumber(cJSON_Writer *writer, double number)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+    cJSON item;
+
+    if ((writer == NULL) || !writer_begin_value(writer))
+    {
+        return false;
+    }
+
+    memset(&item, '\0', sizeof(item));
+    item.type = cJSON_Number;
+    item.valuedouble = number;
+    /* use saturation in case of overflow, like cJSON_CreateNumber */
+    if (number >= INT_MAX)
+    {
+        item.valueint = INT_MAX;
+    }
+    else if (number <= (double)INT_MIN)
+    {
+        item.valueint = INT_MIN;
+    }
+    else
+    {
+        item.valueint = (int)number;
+    }
+
+    writer_printbuffer(writer, &p, 1);
+    if (!print_number(&item, &p))
+    {
+        return writer_fail(writer);
+    }
+    writer->length = p.offset;
+
+    return true;
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteBool(cJSON_Writer *writer, cJSON_bool boolean)
+{
+    if ((writer == NULL) || !writer_begin_value(writer))
+    {
+        return false;
+    }
+
+    return boolean ? writer_append(writer, "true", 4) : writer_append(writer, "false", 5);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteNull(cJSON_Writer *writer)
+{
+    if ((writer == NULL) || !writer_begin_value(writer))
+    {
+        return false;
+    }
+
+    return writer_append(writer, "null", 4);
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteRaw(cJSON_Writer *writer, const char *json)
+{
+    if ((writer == NULL) || !writer_begin_value(writer))
+    {
+        return false;
+    }
+    if (json == NULL)
+    {
+        return writer_fail(writer);
+    }
+
+    return writer_append(writer, json, strlen(json));
+}
+
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteItem(cJSON_Writer *writer, const cJSON *item)
+{
+    printbuffer p = { 0, 0, 0, 0, 0, 0, { 0, 0, 0 } };
+
+    if ((writer == NULL) || !writer_begin_value(writer))
+    {
+        return false;
+    }
+    if (item == NULL)
+    {
+        return writer_fail(writer);
+    }
+
+    writer_printbuffer(writer, &p, 0);
+    if (!print_value(item, &p))
+    {
+        return writer_fail(writer);
+    }
+    update_offset(&p);
+    writer->length = p.offset;
+
+    return true;
+}
+
+CJSON_PUBLIC(const char *) cJSON_WriterFinish(const cJSON_Writer *writer)
+{
+    if ((writer == NULL) || writer->failed || (writer->depth != 0) || (writer->length == 0))
+    {
+        return NULL;
+    }
+
+    return writer->buffer;
+}
+
 /* Parser core - when encountering text, process appropriately. */
 static cJSON_bool parse_value(cJSON * const item, parse_buffer * const input_buffer)
 {
@@ -1649,10 +4422,46 @@ static cJSON_bool print_array(const cJSON * const item, printbuffer * const outp
 }
 
 /* Build an object from the text. */
+/* Parse the name of an object member into item->string. Names without escapes are
+ * shared through the intern table when that is enabled. */
+static cJSON_bool parse_key(cJSON * const item, parse_buffer * const input_buffer)
+{
+    if (key_intern_table.enabled && can_access_at_index(input_buffer, 0) && (buffer_at_offset(input_buffer)[0] == '\"'))
+    {
+        const unsigned char *start = buffer_at_offset(input_buffer) + 1;
+        const size_t available = input_buffer->length - input_buffer->offset - 1;
+        const size_t length = input_buffer->scan->find_string_special(start, available);
+        if ((length < available) && (start[length] == '\"'))
+        {
+            const char *interned = intern_key(start, length);
+            if (interned != NULL)
+            {
+                item->string = (char*)interned;
+                item->type |= cJSON_StringIsConst;
+                input_buffer->offset += length + 2;
+                return true;
+            }
+        }
+    }
+
+    if (!parse_string(item, input_buffer))
+    {
+        return false;
+    }
+
+    /* swap valuestring and string, because we parsed the name */
+    item->string = item->valuestring;
+    item->valuestring = NULL;
+
+    return true;
+}
+
 static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_buffer)
 {
     cJSON *head = NULL; /* linked list head */
     cJSON *current_item = NULL;
+    int key_flags = 0;
+    cJSON_bool parsed = false;
 
     if (input_buffer->depth >= CJSON_NESTING_LIMIT)
     {
@@ -1713,16 +4522,13 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         /* parse the name of the child */
         input_buffer->offset++;
         buffer_skip_whitespace(input_buffer);
-        if (!parse_string(current_item, input_buffer))
+        if (!parse_key(current_item, input_buffer))
         {
             goto fail; /* failed to parse name */
         }
+        key_flags = current_item->type & cJSON_StringIsConst;
         buffer_skip_whitespace(input_buffer);
 
-        /* swap valuestring and string, because we parsed the name */
-        current_item->string = current_item->valuestring;
-        current_item->valuestring = NULL;
-
         if (cannot_access_at_index(input_buffer, 0) || (buffer_at_offset(input_buffer)[0] != ':'))
         {
             goto fail; /* invalid object */
@@ -1731,7 +4537,10 @@ static cJSON_bool parse_object(cJSON * const item, parse_buffer * const input_bu
         /* parse the value */
         input_buffer->offset++;
         buffer_skip_whitespace(input_buffer);
-        if (!parse_value(current_item, input_buffer))
+        parsed = parse_value(current_item, input_buffer);
+        /* parse_value assigns the type, keep the interned name flagged */
+        current_item->type |= key_flags;
+        if (!parsed)
         {
             goto fail; /* failed to parse value */
         }
@@ -1884,6 +4693,7 @@ static cJSON_bool print_object(const cJSON * const item, printbuffer * const out
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 {
     cJSON *child = NULL;
+    const container_index *index = NULL;
     size_t size = 0;
 
     if (array == NULL)
@@ -1891,6 +4701,12 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
         return 0;
     }
 
+    index = find_container_index(array);
+    if (index != NULL)
+    {
+        return (int)index->count;
+    }
+
     child = array->child;
 
     while(child != NULL)
@@ -1907,18 +4723,27 @@ CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array)
 static cJSON* get_array_item(const cJSON *array, size_t index)
 {
     cJSON *current_child = NULL;
+    const container_index *lookup_index = NULL;
+    size_t visited = 0;
 
     if (array == NULL)
     {
         return NULL;
     }
 
+    lookup_index = find_container_index(array);
+    if (lookup_index != NULL)
+    {
+        return (index < lookup_index->count) ? lookup_index->items[index] : NULL;
+    }
+
     current_child = array->child;
-    while ((current_child != NULL) && (index > 0))
+    while ((current_child != NULL) && (visited < index))
     {
-        index--;
+        visited++;
         current_child = current_child->next;
     }
+    maybe_index_container(array, visited);
 
     return current_child;
 }
@@ -1936,17 +4761,26 @@ CJSON_PUBLIC(cJSON *) cJSON_GetArrayItem(const cJSON *array, int index)
 static cJSON *get_object_item(const cJSON * const object, const char * const name, const cJSON_bool case_sensitive)
 {
     cJSON *current_element = NULL;
+    const container_index *index = NULL;
+    size_t visited = 0;
 
     if ((object == NULL) || (name == NULL))
     {
         return NULL;
     }
 
+    index = find_container_index(object);
+    if ((index != NULL) && (index->slots != NULL))
+    {
+        return index_get_object_item(index, name, case_sensitive);
+    }
+
     current_element = object->child;
     if (case_sensitive)
     {
         while ((current_element != NULL) && (current_element->string != NULL) && (strcmp(name, current_element->string) != 0))
         {
+            visited++;
             current_element = current_element->next;
         }
     }
@@ -1954,9 +4788,14 @@ static cJSON *get_object_item(const cJSON * const object, const char * const nam
     {
         while ((current_element != NULL) && (case_insensitive_strcmp((const unsigned char*)name, (const unsigned char*)(current_element->string)) != 0))
         {
+            visited++;
             current_element = current_element->next;
         }
     }
+    if (cJSON_IsObject(object))
+    {
+        maybe_index_container(object, visited);
+    }
 
     if ((current_element == NULL) || (current_element->string == NULL)) {
         return NULL;
@@ -2018,6 +4857,7 @@ static cJSON_bool add_item_to_array(cJSON *array, cJSON *item)
         return false;
     }
 
+    invalidate_container_index(array);
     child = array->child;
     /*
      * To find the last item in array quickly, we use prev in array
@@ -2247,6 +5087,8 @@ CJSON_PUBLIC(cJSON *) cJSON_DetachItemViaPointer(cJSON *parent, cJSON * const it
         return NULL;
     }
 
+    invalidate_container_index(parent);
+
     if (item != parent->child)
     {
         /* not the first element */
@@ -2336,6 +5178,8 @@ CJSON_PUBLIC(cJSON_bool) cJSON_InsertItemInArray(cJSON *array, int which, cJSON
         return false;
     }
 
+    invalidate_container_index(array);
+
     newitem->next = after_inserted;
     newitem->prev = after_inserted->prev;
     after_inserted->prev = newitem;
@@ -2362,6 +5206,7 @@ CJSON_PUBLIC(cJSON_bool) cJSON_ReplaceItemViaPointer(cJSON * const parent, cJSON
         return true;
     }
 
+    invalidate_container_index(parent);
     replacement->next = item->next;
     replacement->prev = item->prev;
 
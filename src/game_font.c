@@ -0,0 +1,210 @@
+/**
+ * @file game_font.c
+ * @author Grupo 1
+ * @brief Implementação da fonte do jogo desenhada por campo de distância (SDF).
+ * @version 1.1
+ * @copyright Copyright (c) 2025
+ *
+ * Os glyphs SDF vêm do stb_truetype (LoadFontData com FONT_SDF), já com a margem que o
+ * campo precisa; o atlas é filtrado bilinearmente, porque o shader interpola a distância.
+ * Os avanços horizontais são os mesmos de LoadFontEx no mesmo tamanho, então MeasureTextEx
+ * e as quebras de linha do pack continuam valendo.
+ *
+ * Os tamanhos de GAME_FONT_BAKED_SIZES são rasterizados cada um no seu tamanho e empacotados
+ * juntos num só atlas: cada Font aponta para a sua fatia dos glyphs e retângulos, e todas
+ * dividem a textura (por isso são liberadas aqui, e não com UnloadFont).
+ */
+
+#include "raylib/game_font.h"
+#include "raylib/rlgl.h"
+#include <stdio.h>
+#include <string.h>
+
+//---------------------------------------------
+// Variáveis Estáticas (Privadas ao Módulo)
+//---------------------------------------------
+static Font gameFont = { 0 };
+static Shader sdfShader = { 0 };
+static bool usingSdf = false;
+
+static const int bakedSizes[] = { GAME_FONT_BAKED_SIZES };
+#define BAKED_SIZE_COUNT (int)(sizeof(bakedSizes) / sizeof(bakedSizes[0]))
+static Font bakedFonts[BAKED_SIZE_COUNT];      // glyphs e recs de bakedFonts[0] são os de todas
+static bool bakedLoaded = false;
+
+//---------------------------------------------
+// Funções Privadas
+//---------------------------------------------
+static bool LoadSdfFont(void) {
+    Shader shader = LoadShader(NULL, GAME_FONT_SDF_SHADER);
+    if (shader.id == 0 || shader.id == rlGetShaderIdDefault()) return false;   // LoadShader devolve o padrão se falhar
+
+    int fileSize = 0;
+    unsigned char *fileData = LoadFileData(GAME_FONT_PATH, &fileSize);
+    Font font = { 0 };
+    font.baseSize = GAME_FONT_SDF_SIZE;
+    font.glyphCount = GAME_FONT_GLYPH_COUNT;
+    font.glyphs = (fileData != NULL) ? LoadFontData(fileData, fileSize, GAME_FONT_SDF_SIZE, NULL, GAME_FONT_GLYPH_COUNT, FONT_SDF) : NULL;
+    UnloadFileData(fileData);
+    if (font.glyphs == NULL) {
+        UnloadShader(shader);
+        return false;
+    }
+    Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, GAME_FONT_GLYPH_COUNT, GAME_FONT_SDF_SIZE, 0, 1);
+    font.texture = LoadTextureFromImage(atlas);
+    UnloadImage(atlas);
+    if (font.texture.id == 0) {
+        UnloadFont(font);
+        UnloadShader(shader);
+        return false;
+    }
+    SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+    gameFont = font;
+    sdfShader = shader;
+    return true;
+}
+
+// Altura média dos glyphs (com a margem), ponderada pela largura. GenImageFontAtlas estima
+// a área do atlas como soma das larguras x fontSize; com a altura do maior tamanho, o atlas
+// de todos os tamanhos sairia com o dobro ou o quádruplo do necessário.
+static int AtlasRowHeight(const GlyphInfo *glyphs, int count, int padding) {
+    double area = 0.0, width = 0.0;
+    for (int i = 0; i < count; i++) {
+        double w = glyphs[i].image.width + 2 * padding;
+        area += w * (glyphs[i].image.height + 2 * padding);
+        width += w;
+    }
+    return (width > 0.0) ? (int)(area / width) + 1 : 1;
+}
+
+static bool AllGlyphsPacked(const Rectangle *recs, int count, Image atlas) {
+    for (int i = 0; i < count; i++) {
+        if (recs[i].x < 0 || recs[i].y < 0 || recs[i].x + recs[i].width > atlas.width || recs[i].y + recs[i].height > atlas.height) return false;
+    }
+    return true;
+}
+
+static bool LoadBakedFonts(void) {
+    int fileSize = 0;
+    unsigned char *fileData = LoadFileData(GAME_FONT_PATH, &fileSize);
+    if (fileData == NULL) return false;
+    int total = BAKED_SIZE_COUNT * GAME_FONT_GLYPH_COUNT;
+    GlyphInfo *glyphs = MemAlloc((unsigned int)(total * sizeof(GlyphInfo)));
+    for (int s = 0; s < BAKED_SIZE_COUNT && glyphs != NULL; s++) {
+        GlyphInfo *sized = LoadFontData(fileData, fileSize, bakedSizes[s], NULL, GAME_FONT_GLYPH_COUNT, FONT_DEFAULT);
+        if (sized == NULL) {
+            UnloadFontData(glyphs, s * GAME_FONT_GLYPH_COUNT);
+            glyphs = NULL;
+            break;
+        }
+        memcpy(glyphs + s * GAME_FONT_GLYPH_COUNT, sized, GAME_FONT_GLYPH_COUNT * sizeof(GlyphInfo));
+        MemFree(sized);     // as imagens passaram para 'glyphs'
+    }
+    UnloadFileData(fileData);
+    if (glyphs == NULL) return false;
+
+    // O skyline quase sempre cabe na estimativa; se sobrar glyph de fora, tenta com o dobro.
+    Rectangle *recs = NULL;
+    Image atlas = { 0 };
+    int rowHeight = AtlasRowHeight(glyphs, total, GAME_FONT_BAKED_PADDING);
+    for (int attempt = 0; attempt < 2 && atlas.data == NULL; attempt++, rowHeight *= 2) {
+        atlas = GenImageFontAtlas(glyphs, &recs, total, rowHeight, GAME_FONT_BAKED_PADDING, 1);
+        if (atlas.data != NULL && !AllGlyphsPacked(recs, total, atlas)) {
+            UnloadImage(atlas);
+            MemFree(recs);
+            atlas = (Image){ 0 };
+            recs = NULL;
+        }
+    }
+    Texture2D texture = (atlas.data != NULL) ? LoadTextureFromImage(atlas) : (Texture2D){ 0 };
+    for (int i = 0; i < total; i++) {
+        UnloadImage(glyphs[i].image);   // DrawTextEx só usa o atlas
+        glyphs[i].image = (Image){ 0 };
+    }
+    if (texture.id == 0) {
+        UnloadImage(atlas);
+        MemFree(recs);
+        UnloadFontData(glyphs, total);
+        return false;
+    }
+    fprintf(stderr, "[GameFont] %d tamanhos pré-rasterizados (atlas %dx%d).\n", BAKED_SIZE_COUNT, atlas.width, atlas.height);
+    UnloadImage(atlas);
+    for (int s = 0; s < BAKED_SIZE_COUNT; s++) {
+        bakedFonts[s] = (Font){ bakedSizes[s], GAME_FONT_GLYPH_COUNT, GAME_FONT_BAKED_PADDING, texture,
+                                recs + s * GAME_FONT_GLYPH_COUNT, glyphs + s * GAME_FONT_GLYPH_COUNT };
+    }
+    return true;
+}
+
+static void UnloadBakedFonts(void) {
+    if (!bakedLoaded) return;
+    UnloadTexture(bakedFonts[0].texture);
+    MemFree(bakedFonts[0].recs);
+    UnloadFontData(bakedFonts[0].glyphs, BAKED_SIZE_COUNT * GAME_FONT_GLYPH_COUNT);
+    memset(bakedFonts, 0, sizeof(bakedFonts));
+    bakedLoaded = false;
+}
+
+// A fonte pré-rasterizada de 'fontSize', ou NULL se esse tamanho não foi gerado.
+static const Font *FindBakedFont(float fontSize) {
+    for (int s = 0; bakedLoaded && s < BAKED_SIZE_COUNT; s++) {
+        if ((float)bakedSizes[s] == fontSize) return &bakedFonts[s];
+    }
+    return NULL;
+}
+
+//---------------------------------------------
+// Implementação das Funções Públicas
+//---------------------------------------------
+
+void LoadGameFont(void) {
+    usingSdf = LoadSdfFont();
+    if (usingSdf) {
+        fprintf(stderr, "[GameFont] Fonte SDF de %d px (atlas %dx%d).\n", gameFont.baseSize, gameFont.texture.width, gameFont.texture.height);
+    } else {
+        fprintf(stderr, "[GameFont] Aviso: sem o shader SDF; usando o atlas de %d px.\n", GAME_FONT_BITMAP_SIZE);
+        gameFont = LoadFontEx(GAME_FONT_PATH, GAME_FONT_BITMAP_SIZE, NULL, GAME_FONT_GLYPH_COUNT);
+    }
+    bakedLoaded = LoadBakedFonts();
+    if (!bakedLoaded) fprintf(stderr, "[GameFont] Aviso: sem os tamanhos pré-rasterizados; todo texto usa a fonte principal.\n");
+}
+
+void UnloadGameFont(void) {
+    UnloadBakedFonts();
+    UnloadFont(gameFont);
+    if (usingSdf) UnloadShader(sdfShader);
+    gameFont = (Font){ 0 };
+    usingSdf = false;
+}
+
+Font GetGameFont(void) {
+    return gameFont;
+}
+
+Font GetGameFontForSize(float fontSize) {
+    const Font *baked = FindBakedFont(fontSize);
+    return (baked != NULL) ? *baked : gameFont;
+}
+
+Vector2 MeasureGameText(const char *text, float fontSize, float spacing) {
+    return MeasureTextEx(GetGameFontForSize(fontSize), text, fontSize, spacing);
+}
+
+void BeginGameText(void) {
+    if (usingSdf) BeginShaderMode(sdfShader);
+}
+
+void EndGameText(void) {
+    if (usingSdf) EndShaderMode();
+}
+
+void DrawGameText(const char *text, Vector2 position, float fontSize, float spacing, Color color) {
+    const Font *baked = FindBakedFont(fontSize);
+    if (baked != NULL) {
+        DrawTextEx(*baked, text, position, fontSize, spacing, color);     // 1:1, sem o shader
+        return;
+    }
+    BeginGameText();
+    DrawTextEx(gameFont, text, position, fontSize, spacing, color);
+    EndGameText();
+}
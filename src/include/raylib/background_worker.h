@@ -0,0 +1,48 @@
+/**
+ * @file background_worker.h
+ * @author Grupo 1
+ * @brief Interface para uma thread de tarefas em segundo plano.
+ * @version 1.0
+ * @copyright Copyright (c) 2025
+ *
+ * O jogo entrega tarefas (ponteiros opacos) a uma thread, que as executa em ordem e as
+ * devolve numa fila de prontas; o jogo recolhe as prontas a cada frame, sem esperar.
+ * Uma tarefa pertence à thread do envio até ser recolhida, então quem a usa não precisa
+ * de travas. Fica em um módulo separado para que os módulos que usam a raylib nas
+ * tarefas (decodificar imagens, por exemplo) não incluam pthread.h junto com raylib.h.
+ */
+
+#ifndef BACKGROUND_WORKER_H
+#define BACKGROUND_WORKER_H
+
+#include <stdbool.h>
+
+//---------------------------------------------
+// Definições e Tipos Públicos
+//---------------------------------------------
+
+typedef void (*BackgroundJobFunc)(void *job);
+
+typedef struct {
+    void *state;    // thread, trava e filas; opaco para não levar pthread.h ao raylib.h
+} BackgroundWorker;
+
+//---------------------------------------------
+// Protótipos de Funções Públicas
+//---------------------------------------------
+
+// Inicia a thread; cada tarefa enviada é passada a 'run' na própria thread.
+bool StartBackgroundWorker(BackgroundWorker *worker, BackgroundJobFunc run);
+
+// Põe 'job' no fim da fila. Retorna false se a thread não estiver rodando.
+bool SubmitBackgroundJob(BackgroundWorker *worker, void *job);
+
+// Se uma tarefa já foi executada, passa-a para 'job' (que volta a ser de quem chamou)
+// e retorna true. Não espera pela thread.
+bool TakeFinishedBackgroundJob(BackgroundWorker *worker, void **job);
+
+// Para a thread depois da tarefa em execução e entrega a 'discard' cada tarefa que
+// não foi recolhida, executada ou não. Pode ser chamada com um worker zerado.
+void StopBackgroundWorker(BackgroundWorker *worker, BackgroundJobFunc discard);
+
+#endif // BACKGROUND_WORKER_H
@@ -149,6 +149,12 @@ CJSON_PUBLIC(const char*) cJSON_Version(void);
 /* Supply malloc, realloc and free functions to cJSON */
 CJSON_PUBLIC(void) cJSON_InitHooks(cJSON_Hooks* hooks);
 
+/* Select the byte scanning routines used while parsing: "auto" (or NULL), "scalar", "sse2" or "avx2".
+ * "auto" picks the widest one the CPU supports. Returns 0 if the backend isn't available in this build/CPU. */
+CJSON_PUBLIC(cJSON_bool) cJSON_SetScanBackend(const char *name);
+/* returns the name of the scanning backend currently in use */
+CJSON_PUBLIC(const char *) cJSON_GetScanBackend(void);
+
 /* Memory Management: the caller is always responsible to free the results from all variants of cJSON_Parse (with cJSON_Delete) and cJSON_Print (with stdlib free, cJSON_Hooks.free_fn, or cJSON_free as appropriate). The exception is cJSON_PrintPreallocated, where the caller has full responsibility of the buffer. */
 /* Supply a block of JSON, and this returns a cJSON object you can interrogate. */
 CJSON_PUBLIC(cJSON *) cJSON_Parse(const char *value);
@@ -158,6 +164,96 @@ CJSON_PUBLIC(cJSON *) cJSON_ParseWithLength(const char *value, size_t buffer_len
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithOpts(const char *value, const char **return_parse_end, cJSON_bool require_null_terminated);
 CJSON_PUBLIC(cJSON *) cJSON_ParseWithLengthOpts(const char *value, size_t buffer_length, const char **return_parse_end, cJSON_bool require_null_terminated);
 
+/* Event (SAX style) parsing: reports each token to a callback instead of building a tree, so nothing is allocated.
+ * Strings, keys and numbers are slices into the input (strings without the quotes, still escaped).
+ * depth is the number of enclosing containers; begin/end events carry the depth of the container itself. */
+typedef enum
+{
+    cJSON_EventObjectBegin,
+    cJSON_EventObjectEnd,
+    cJSON_EventArrayBegin,
+    cJSON_EventArrayEnd,
+    cJSON_EventKey,
+    cJSON_EventString,
+    cJSON_EventNumber,
+    cJSON_EventTrue,
+    cJSON_EventFalse,
+    cJSON_EventNull
+} cJSON_EventType;
+
+typedef struct cJSON_Event
+{
+    cJSON_EventType type;
+    const char *start;
+    size_t length;
+    /* the key/string slice contains escape sequences, decode it with cJSON_UnescapeString */
+    cJSON_bool escaped;
+    /* value of cJSON_EventNumber */
+    double number;
+    size_t depth;
+} cJSON_Event;
+
+/* Return 0 from the callback to stop parsing early. */
+typedef cJSON_bool (*cJSON_EventCallback)(const cJSON_Event *event, void *user_data);
+
+/* Returns 0 on malformed input (see cJSON_GetErrorPtr), events up to that point have already been delivered.
+ * return_parse_end gets the byte after the last token read, also when the callback stopped the parse. */
+CJSON_PUBLIC(cJSON_bool) cJSON_ParseEvents(const char *value, size_t buffer_length, cJSON_EventCallback callback, void *user_data, const char **return_parse_end);
+/* Decode an escaped key/string slice into output, which needs at least length + 1 bytes. */
+CJSON_PUBLIC(cJSON_bool) cJSON_UnescapeString(const char *start, size_t length, char *output, size_t output_size);
+
+/* Tape parsing: for large documents that are only read. The input is indexed in one vectorized pass and the
+ * values are then stored as flat records in document order (16 bytes each) instead of linked cJSON items.
+ * The whole buffer must hold exactly one value. Free the result with cJSON_DeleteTape.
+ * On failure return_error (if not NULL) gets the position of the error. Unlike the other parsers this leaves
+ * cJSON_GetErrorPtr alone, so tapes can be parsed on a worker thread while other threads use cJSON. */
+typedef struct cJSON_Tape cJSON_Tape;
+CJSON_PUBLIC(cJSON_Tape *) cJSON_ParseTape(const char *value, size_t buffer_length, const char **return_error);
+CJSON_PUBLIC(void) cJSON_DeleteTape(cJSON_Tape *tape);
+/* Values are addressed by their position on the tape. The root is 0, everywhere else 0 means "none". */
+/* cJSON_Object, cJSON_Array, cJSON_String, ... or cJSON_Invalid */
+CJSON_PUBLIC(int) cJSON_TapeType(const cJSON_Tape *tape, size_t value);
+CJSON_PUBLIC(int) cJSON_TapeSize(const cJSON_Tape *tape, size_t value);
+/* first element/member of a container, and the next one after value; subtrees are skipped in O(1) */
+CJSON_PUBLIC(size_t) cJSON_TapeChild(const cJSON_Tape *tape, size_t value);
+CJSON_PUBLIC(size_t) cJSON_TapeNext(const cJSON_Tape *tape, size_t value);
+/* name of an object member, NULL for array elements */
+CJSON_PUBLIC(const char *) cJSON_TapeKey(const cJSON_Tape *tape, size_t value);
+/* case sensitive */
+CJSON_PUBLIC(size_t) cJSON_TapeGetObjectItem(const cJSON_Tape *tape, size_t object, const char *key);
+CJSON_PUBLIC(size_t) cJSON_TapeGetArrayItem(const cJSON_Tape *tape, size_t array, int index);
+CJSON_PUBLIC(const char *) cJSON_TapeString(const cJSON_Tape *tape, size_t value);
+CJSON_PUBLIC(double) cJSON_TapeNumber(const cJSON_Tape *tape, size_t value);
+
+/* Lazy parsing: a cJSON_Lazy is just a position in the input, which has to stay alive. Lookups skip over the
+ * values in front of the one asked for by matching quotes and brackets; nothing is decoded or allocated until
+ * it is read. Skipped subtrees are only checked for balanced brackets and closed strings. */
+typedef struct cJSON_Lazy
+{
+    /* first byte of the value, and end of the whole input */
+    const char *value;
+    const char *end;
+    /* name of an object member, still escaped; NULL for array elements and the root */
+    const char *key;
+    size_t key_length;
+} cJSON_Lazy;
+
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyParse(const char *value, size_t buffer_length, cJSON_Lazy *root);
+/* cJSON_Object, cJSON_Array, cJSON_String, ... from the first byte, or cJSON_Invalid */
+CJSON_PUBLIC(int) cJSON_LazyType(const cJSON_Lazy *item);
+/* iteration: first element/member of a container, then the following ones; item and next may be the same */
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyChild(const cJSON_Lazy *container, cJSON_Lazy *item);
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyNext(const cJSON_Lazy *item, cJSON_Lazy *next);
+/* case sensitive; item may be the same handle as object/array */
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyGetObjectItem(const cJSON_Lazy *object, const char *name, cJSON_Lazy *item);
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyGetArrayItem(const cJSON_Lazy *array, int index, cJSON_Lazy *item);
+/* decodes a string value into buffer, which needs room for the escaped length + 1 */
+CJSON_PUBLIC(cJSON_bool) cJSON_LazyGetString(const cJSON_Lazy *item, char *buffer, size_t buffer_size);
+/* NAN if item isn't a number */
+CJSON_PUBLIC(double) cJSON_LazyGetNumber(const cJSON_Lazy *item);
+/* fully parses the value (and only it) into a regular cJSON tree, free with cJSON_Delete */
+CJSON_PUBLIC(cJSON *) cJSON_LazyMaterialize(const cJSON_Lazy *item);
+
 /* Render a cJSON entity to text for transfer/storage. */
 CJSON_PUBLIC(char *) cJSON_Print(const cJSON *item);
 /* Render a cJSON entity to text for transfer/storage without any formatting. */
@@ -167,9 +263,61 @@ CJSON_PUBLIC(char *) cJSON_PrintBuffered(const cJSON *item, int prebuffer, cJSON
 /* Render a cJSON entity to text using a buffer already allocated in memory with given length. Returns 1 on success and 0 on failure. */
 /* NOTE: cJSON is not always 100% accurate in estimating how much memory it will use, so to be safe allocate 5 bytes more than you actually need */
 CJSON_PUBLIC(cJSON_bool) cJSON_PrintPreallocated(cJSON *item, char *buffer, const int length, const cJSON_bool format);
+
+/* Streaming writer: renders JSON straight into a caller provided buffer, without building a tree or allocating.
+ * The writer adds the commas, escapes strings and keeps the output NUL terminated. If the buffer runs out (or the
+ * calls don't nest properly) that call and every later one return 0, and cJSON_WriterFinish returns NULL. */
+typedef struct cJSON_Writer
+{
+    char *buffer;
+    size_t size;
+    size_t length;
+    size_t depth;
+    /* one bit per open container: is it an object, does it have items yet */
+    unsigned char objects[(CJSON_NESTING_LIMIT + 7) / 8];
+    unsigned char has_items[(CJSON_NESTING_LIMIT + 7) / 8];
+    /* a key was written, its value comes next */
+    cJSON_bool expect_value;
+    cJSON_bool failed;
+} cJSON_Writer;
+
+CJSON_PUBLIC(void) cJSON_WriterInit(cJSON_Writer *writer, char *buffer, size_t size);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteObjectBegin(cJSON_Writer *writer);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteObjectEnd(cJSON_Writer *writer);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteArrayBegin(cJSON_Writer *writer);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteArrayEnd(cJSON_Writer *writer);
+/* inside an object every value must be preceded by its key */
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteKey(cJSON_Writer *writer, const char *key);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteString(cJSON_Writer *writer, const char *string);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteNumber(cJSON_Writer *writer, double number);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteBool(cJSON_Writer *writer, cJSON_bool boolean);
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteNull(cJSON_Writer *writer);
+/* copies already rendered JSON verbatim (not checked) */
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteRaw(cJSON_Writer *writer, const char *json);
+/* renders an existing item (unformatted) as the next value, needs a few bytes of slack like cJSON_PrintPreallocated */
+CJSON_PUBLIC(cJSON_bool) cJSON_WriteItem(cJSON_Writer *writer, const cJSON *item);
+/* Returns the finished document, or NULL if something failed or a container is still open. */
+CJSON_PUBLIC(const char *) cJSON_WriterFinish(const cJSON_Writer *writer);
 /* Delete a cJSON entity and all subentities. */
 CJSON_PUBLIC(void) cJSON_Delete(cJSON *item);
 
+/* Optional lookup index: arrays/objects with at least threshold children get an item array
+ * (and a key hash for objects) built on the first lookup that walks that far, making
+ * cJSON_GetArrayItem, cJSON_GetArraySize and cJSON_GetObjectItem* O(1) afterwards.
+ * The index is dropped whenever cJSON relinks the container's children; code that edits
+ * next/prev/child pointers by hand must not rely on it. 0 (the default) disables indexing
+ * and frees the existing indexes. */
+CJSON_PUBLIC(void) cJSON_SetIndexThreshold(int threshold);
+
+/* Memory reuse across parses, both off by default.
+ * With key interning, object names without escapes share one copy per distinct name (flagged cJSON_StringIsConst).
+ * Those copies are only freed by cJSON_ReleasePools or cJSON_InitHooks, so call them when no tree parsed with
+ * interning on is alive anymore. The item pool keeps up to max_free_items deleted items for the next parse or
+ * cJSON_Create*; 0 turns it off and frees what it holds. */
+CJSON_PUBLIC(void) cJSON_SetKeyInterning(cJSON_bool enable);
+CJSON_PUBLIC(void) cJSON_SetItemPoolLimit(size_t max_free_items);
+CJSON_PUBLIC(void) cJSON_ReleasePools(void);
+
 /* Returns the number of items in an array (or object). */
 CJSON_PUBLIC(int) cJSON_GetArraySize(const cJSON *array);
 /* Retrieve item number "index" from array "array". Returns NULL if unsuccessful. */
@@ -0,0 +1,68 @@
+/**
+ * @file game_font.h
+ * @author Grupo 1
+ * @brief Interface para a fonte do jogo (Montserrat), desenhada por campo de distância (SDF).
+ * @version 1.1
+ * @copyright Copyright (c) 2025
+ *
+ * Em vez de um atlas de 256 px reduzido a cada frame para 25 a 80 px, os glyphs são
+ * gerados uma vez como campos de distância em GAME_FONT_SDF_SIZE px e desenhados com o
+ * shader GAME_FONT_SDF_SHADER, que recorta a borda na resolução da tela: um atlas pequeno
+ * serve todos os tamanhos com bordas nítidas, e a carga é mais rápida. Se o shader não
+ * carregar, a fonte volta a ser o atlas comum de GAME_FONT_BITMAP_SIZE px.
+ *
+ * Todo texto desenhado com GetGameFont() precisa estar entre BeginGameText e EndGameText
+ * (ou ser desenhado por DrawGameText), para o shader estar ativo.
+ *
+ * Os tamanhos fixos da interface (GAME_FONT_BAKED_SIZES) também são rasterizados no próprio
+ * tamanho, num atlas compartilhado: DrawGameText desenha esses textos 1:1, sem o shader e
+ * sem reduzir glyphs, e usa a fonte SDF só para os demais tamanhos.
+ */
+
+#ifndef GAME_FONT_H
+#define GAME_FONT_H
+
+#include "raylib/raylib.h"
+
+//---------------------------------------------
+// Definições e Tipos Públicos
+//---------------------------------------------
+
+#define GAME_FONT_PATH "resources/montserrat.ttf"
+#define GAME_FONT_SDF_SHADER "resources/shaders/sdf.fs"
+#define GAME_FONT_GLYPH_COUNT 250       // a partir do espaço
+#define GAME_FONT_SDF_SIZE 64           // também o tamanho base dos layouts do pack (tools/question_compiler.c)
+#define GAME_FONT_BITMAP_SIZE 256       // atlas comum, sem o shader
+#define GAME_FONT_BAKED_SIZES 25, 30, 35, 40, 50, 60, 73, 80    // tamanhos usados com DrawGameText
+#define GAME_FONT_BAKED_PADDING 1       // desenhados 1:1 com filtro de ponto: 1 px basta
+
+//---------------------------------------------
+// Protótipos de Funções Públicas
+//---------------------------------------------
+
+// Gera a fonte SDF e carrega o shader (sem eles, carrega o atlas comum) e os tamanhos fixos.
+// Chamar depois de InitWindow.
+void LoadGameFont(void);
+
+// Libera as fontes e o shader.
+void UnloadGameFont(void);
+
+// A fonte principal (SDF), para desenhos entre BeginGameText e EndGameText.
+Font GetGameFont(void);
+
+// A fonte que DrawGameText usa para 'fontSize': a pré-rasterizada, se houver, ou a principal.
+Font GetGameFontForSize(float fontSize);
+
+// MeasureTextEx com a fonte que DrawGameText usaria; os avanços de cada tamanho são arredondados
+// no próprio tamanho, então medir com a fonte principal desalinharia textos centralizados.
+Vector2 MeasureGameText(const char *text, float fontSize, float spacing);
+
+// Ativa e desativa o shader da fonte em volta de desenhos com GetGameFont().
+void BeginGameText(void);
+void EndGameText(void);
+
+// DrawTextEx com a fonte do jogo: 1:1 nos tamanhos fixos, ou a SDF com o shader já ativo.
+// Não chamar entre BeginGameText e EndGameText.
+void DrawGameText(const char *text, Vector2 position, float fontSize, float spacing, Color color);
+
+#endif // GAME_FONT_H
@@ -0,0 +1,29 @@
+/**
+ * @file mapped_file.h
+ * @author Grupo 1
+ * @brief Mapeamento de arquivos somente leitura na memória (mmap / MapViewOfFile).
+ * @version 1.0
+ * @copyright Copyright (c) 2025
+ *
+ * As páginas são carregadas sob demanda pelo sistema e compartilhadas entre os
+ * processos que mapeiam o mesmo arquivo.
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <stddef.h>
+
+typedef struct {
+    const void *data;
+    size_t size;
+    void *handle;       // HANDLE do mapeamento no Windows; não usado no POSIX
+} MappedFile;
+
+// Mapeia o arquivo inteiro. Retorna 0 (e zera 'file') se não existir, estiver vazio ou falhar.
+int MapFile(MappedFile *file, const char *path);
+
+// Desfaz o mapeamento; pode ser chamada com um MappedFile zerado.
+void UnmapFile(MappedFile *file);
+
+#endif // MAPPED_FILE_H
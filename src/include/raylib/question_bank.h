@@ -0,0 +1,178 @@
+/**
+ * @file question_bank.h
+ * @author Grupo 1
+ * @brief Interface para o carregamento do Banco de Questões a partir de arquivo.
+ * @version 2.7
+ * @copyright Copyright (c) 2025
+ *
+ * O banco é editado em JSON (resources/questions.json) e usado no formato empacotado
+ * (resources/questions.qpk): cabeçalho, um registro de tamanho fixo por pergunta com
+ * deslocamentos, e uma única tabela de textos UTF-8 sem repetições. O pack é mapeado
+ * na memória (mmap), então o custo de carga e a memória residente não crescem com o
+ * tamanho do banco, e as páginas são compartilhadas entre instâncias do jogo.
+ *
+ * Se o JSON mudar (ou o pack faltar), ele é validado e o pack é regravado.
+ * Sem o JSON, qualquer pack íntegro é usado como está. O pack gerado na compilação
+ * (make questions) traz também as quebras de linha de cada texto já calculadas.
+ *
+ * As perguntas podem ter categoria e tópico; o pack guarda, para cada um, a lista das
+ * perguntas já separada por dificuldade, então filtrar um quiz não percorre o banco.
+ * Cada pergunta tem também uma nota de dificuldade na escala Elo, e o pack traz as
+ * perguntas ordenadas por essa nota, para o modo adaptativo achar por busca binária a
+ * pergunta certa para o jogador.
+ *
+ * Cada idioma tem o seu JSON e o seu pack (resources/questions.en.json, ...), com os
+ * mesmos ids e marcações do banco em português; só o pack do idioma em uso é mapeado.
+ *
+ * Uma pergunta pode ter uma imagem ("image" no JSON), com o caminho relativo a
+ * QUESTION_IMAGE_DIR; o pack guarda só o caminho, e a imagem é carregada pelo jogo
+ * em segundo plano (question_images.c).
+ */
+
+#ifndef QUESTION_BANK_H
+#define QUESTION_BANK_H
+
+#include "raylib/questions.h"
+#include "raylib/mapped_file.h"
+#include <stdint.h>
+
+//---------------------------------------------
+// Definições e Tipos Públicos
+//---------------------------------------------
+
+#define QUESTION_BANK_SOURCE "resources/questions.json"
+#define QUESTION_BANK_PACK "resources/questions.qpk"
+#define QUESTION_LOCALE_DEFAULT "pt"    // o de QUESTION_BANK_SOURCE e QUESTION_BANK_PACK
+#define QUESTION_BANK_PATH_SIZE 256
+#define QUESTION_IMAGE_DIR "resources/"
+
+#define LAYOUT_STYLE_COUNT 2    // enunciado e alternativas
+
+// Nota Elo de uma pergunta sem "rating" no JSON.
+#define QUESTION_RATING_EASY 1300.0f
+#define QUESTION_RATING_MEDIUM 1500.0f
+#define QUESTION_RATING_HARD 1700.0f
+#define QUESTION_RATING_MIN 100.0f
+#define QUESTION_RATING_MAX 3000.0f
+
+typedef struct {
+    TextLayout question;
+    TextLayout options[4];
+} QuestionLayout;
+
+// Campos opcionais de uma pergunta no JSON.
+typedef struct {
+    const char *category;   // NULL se não tiver
+    const char *topic;      // NULL se não tiver
+    float rating;           // nota Elo; 0 = a padrão da dificuldade
+    const char *image;      // relativo a QUESTION_IMAGE_DIR; NULL se não tiver
+} QuestionMeta;
+
+// Entrada do índice por nota: as perguntas do banco em ordem crescente de 'rating'.
+typedef struct {
+    float rating;
+    uint32_t index;
+} QuestionRating;
+
+typedef enum {
+    TAG_CATEGORY,
+    TAG_TOPIC
+} QuestionTagKind;
+
+// Conjunto de perguntas de uma dificuldade: indices[0..count-1], ou, se indices for NULL,
+// o intervalo contínuo first..first+count-1 (os registros do pack já vêm agrupados).
+typedef struct {
+    const uint32_t *indices;
+    int first;
+    int count;
+} QuestionPool;
+
+// Layouts calculados por tools/question_compiler.c, na mesma ordem das perguntas.
+typedef struct {
+    const QuestionLayout *layouts;
+    int fontBaseSize;
+    unsigned long long fontHash;
+    TextStyle styles[LAYOUT_STYLE_COUNT];   // QUESTION_TEXT_STYLE e OPTION_TEXT_STYLE
+} QuestionLayoutSet;
+
+// O JSON de um banco como foi lido: o conteúdo e a data do arquivo aberto, que o pack
+// gravado a partir dele guarda para saber quando o JSON mudou.
+typedef struct {
+    char *json;                 // terminado em '\0'
+    size_t size;
+    long long modified;         // st_mtime do mesmo arquivo lido (fstat)
+} QuestionSource;
+
+typedef struct {
+    MappedFile file;            // pack mapeado
+    char *image;                // pack em memória, se não foi possível gravá-lo e mapeá-lo
+    const void *records;
+    const char *strings;
+    unsigned int stringsSize;
+    int count;
+    int difficultyFirst[3];     // os registros ficam agrupados por dificuldade
+    int difficultyCount[3];
+    const QuestionLayout *layouts;          // NULL se o pack não tiver layouts
+    int layoutFontBaseSize;
+    TextStyle layoutStyles[LAYOUT_STYLE_COUNT];
+    const void *tagEntries;     // categorias e depois tópicos, cada grupo em ordem de nome
+    int tagCount[2];
+    const uint32_t *tagIndices;
+    unsigned int tagIndexCount;
+    const QuestionRating *ratings;  // 'count' entradas, em ordem de nota
+} QuestionBank;
+
+//---------------------------------------------
+// Protótipos de Funções Públicas
+//---------------------------------------------
+
+// Mapeia o pack, reconstruindo-o a partir do JSON se ele estiver desatualizado.
+// Retorna false se não houver um banco com ao menos uma pergunta válida.
+bool LoadQuestionBank(QuestionBank *bank, const char *sourcePath, const char *packPath);
+
+// Como LoadQuestionBank, mas sempre lê o JSON e compara o hash com o do pack, em vez de
+// confiar no tamanho e na data: para recargas, logo depois de o arquivo ser gravado.
+bool ReloadQuestionBank(QuestionBank *bank, const char *sourcePath, const char *packPath);
+
+// Caminhos do JSON e do pack do idioma 'locale' (por exemplo "en"). Retorna false se o
+// código não for válido (só letras, dígitos, '-' e '_', até 8 caracteres).
+bool GetQuestionBankPaths(const char *locale, char *sourcePath, char *packPath, size_t pathSize);
+
+// Desfaz o mapeamento e libera o banco.
+void UnloadQuestionBank(QuestionBank *bank);
+
+// Visão da pergunta 'index': os textos apontam para dentro do pack, nada é copiado.
+Question GetBankQuestion(const QuestionBank *bank, int index);
+
+// Nota Elo da pergunta 'index'.
+float GetBankRating(const QuestionBank *bank, int index);
+
+// Caminho da imagem da pergunta 'index' (relativo a QUESTION_IMAGE_DIR), ou NULL.
+const char *GetBankImage(const QuestionBank *bank, int index);
+
+// O caminho de imagem é aceitável? Precisa ser relativo e não pode sair de QUESTION_IMAGE_DIR.
+bool IsValidQuestionImagePath(const char *path);
+
+// Layouts da pergunta 'index', ou NULL se o pack não os tiver.
+const QuestionLayout *GetBankLayout(const QuestionBank *bank, int index);
+
+// Perguntas com a categoria ou o tópico 'name', uma QuestionPool por dificuldade.
+// Busca binária sobre o índice do pack; retorna false se o nome não existir.
+bool FindBankTag(const QuestionBank *bank, QuestionTagKind kind, const char *name, QuestionPool pools[3]);
+
+// Lê o JSON de um banco inteiro. Retorna false se não conseguir.
+bool ReadQuestionSource(const char *path, QuestionSource *source);
+
+// Libera o que ReadQuestionSource leu.
+void FreeQuestionSource(QuestionSource *source);
+
+// Monta um pack em memória a partir de perguntas já validadas; 'meta' e 'layoutSet' podem ser NULL.
+// 'source' (ou NULL) é o JSON lido de onde vieram as perguntas: o pack guarda o tamanho, a data
+// e o hash desse conteúdo, e não do arquivo como estiver agora, para o jogo saber quando ele mudou.
+char *BuildQuestionPack(const Question *questions, const QuestionMeta *meta, int count, const QuestionLayoutSet *layoutSet,
+                        const QuestionSource *source, size_t *packSize);
+
+// Grava o pack por meio de um arquivo temporário, para nunca deixar um pack pela metade.
+bool WriteQuestionPack(const char *packPath, const char *pack, size_t packSize);
+
+#endif // QUESTION_BANK_H
@@ -0,0 +1,62 @@
+/**
+ * @file question_history.h
+ * @author Grupo 1
+ * @brief Interface para o histórico das perguntas sorteadas recentemente.
+ * @version 1.1
+ * @copyright Copyright (c) 2025
+ *
+ * Guarda as últimas perguntas sorteadas (uma janela de tamanho fixo, em um buffer
+ * circular) e um bitset com um bit por pergunta do banco, para o sorteio saber em O(1)
+ * se uma candidata saiu há pouco. O histórico é salvo em arquivo a cada quiz, então
+ * jogadores seguidos e o mesmo jogador em outra visita veem perguntas diferentes
+ * mesmo depois de o jogo ser reiniciado.
+ */
+
+#ifndef QUESTION_HISTORY_H
+#define QUESTION_HISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//---------------------------------------------
+// Definições e Tipos Públicos
+//---------------------------------------------
+
+#define QUESTION_HISTORY_PATH "resources/question_history.bin"
+#define QUESTION_HISTORY_MAX_WINDOW 4096
+
+typedef struct {
+    unsigned char *recent;  // bitset: bit i ligado = a pergunta i está na janela
+    int *ring;              // perguntas da janela, da mais antiga para a mais nova a partir de 'head'
+    int *ids;               // ids das perguntas do buffer, para conferir o arquivo ao carregar
+    int capacity;
+    int size;
+    int head;
+    int questionCount;
+} QuestionHistory;
+
+//---------------------------------------------
+// Protótipos de Funções Públicas
+//---------------------------------------------
+
+// Prepara um histórico vazio para um banco de 'questionCount' perguntas, lembrando as
+// últimas 'window' (limitada a QUESTION_HISTORY_MAX_WINDOW).
+bool InitQuestionHistory(QuestionHistory *history, int questionCount, int window);
+
+// Libera o histórico; pode ser chamada com um histórico zerado.
+void FreeQuestionHistory(QuestionHistory *history);
+
+// A pergunta 'index' saiu entre as últimas 'window'?
+bool IsRecentQuestion(const QuestionHistory *history, int index);
+
+// Registra que a pergunta 'index' (de identificador 'id') foi sorteada.
+void MarkQuestionServed(QuestionHistory *history, int index, int id);
+
+// Lê o histórico salvo. 'findQuestion' devolve a posição atual da pergunta 'id', gravada
+// em 'position', ou -1; as entradas de perguntas que não existem mais são descartadas.
+void LoadQuestionHistory(QuestionHistory *history, const char *path, int (*findQuestion)(uint32_t position, uint32_t id));
+
+// Salva o histórico por meio de um arquivo temporário.
+bool SaveQuestionHistory(const QuestionHistory *history, const char *path);
+
+#endif // QUESTION_HISTORY_H
@@ -0,0 +1,53 @@
+/**
+ * @file question_images.h
+ * @author Grupo 1
+ * @brief Interface para as imagens das perguntas (carga em segundo plano e cache).
+ * @version 1.0
+ * @copyright Copyright (c) 2025
+ *
+ * Nada aqui espera por disco ou decodificação: uma thread lê e decodifica cada imagem
+ * (já reduzida e em RGBA), e o jogo a envia para a GPU em faixas de linhas, até
+ * QUESTION_IMAGE_UPLOAD_BYTES por frame. Pedir uma imagem que ainda não está pronta
+ * só a coloca na fila; ela aparece alguns frames depois, sem travar a tela. Pedir a
+ * imagem da próxima pergunta antes da hora (PrefetchQuestionImage) faz ela já estar na
+ * GPU quando a pergunta abrir.
+ *
+ * As texturas ficam num cache de QUESTION_IMAGE_CACHE_SIZE posições; quando ele enche,
+ * sai a imagem usada há mais tempo.
+ */
+
+#ifndef QUESTION_IMAGES_H
+#define QUESTION_IMAGES_H
+
+#include "raylib/raylib.h"
+
+//---------------------------------------------
+// Definições e Tipos Públicos
+//---------------------------------------------
+
+#define QUESTION_IMAGE_CACHE_SIZE 8
+#define QUESTION_IMAGE_MAX_SIZE 1024            // maior lado depois da decodificação
+#define QUESTION_IMAGE_UPLOAD_BYTES (1 << 20)   // envio para a GPU por frame (512x512 RGBA)
+
+//---------------------------------------------
+// Protótipos de Funções Públicas
+//---------------------------------------------
+
+// Inicia a thread de decodificação. Chamar depois de InitWindow.
+void InitQuestionImages(void);
+
+// Para a thread e libera imagens e texturas. Chamar antes de CloseWindow.
+void UnloadQuestionImages(void);
+
+// Recolhe as imagens decodificadas e as envia para a GPU dentro do orçamento do frame.
+// Chamar uma vez por frame.
+void UpdateQuestionImages(void);
+
+// Textura da imagem 'path' (relativo a resources/), ou NULL se ela ainda não estiver
+// pronta (a carga começa na primeira chamada) ou não puder ser carregada.
+const Texture2D *RequestQuestionImage(const char *path);
+
+// Começa a carregar 'path' sem usá-la ainda. 'path' pode ser NULL (pergunta sem imagem).
+void PrefetchQuestionImage(const char *path);
+
+#endif // QUESTION_IMAGES_H
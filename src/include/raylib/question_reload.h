@@ -0,0 +1,53 @@
+/**
+ * @file question_reload.h
+ * @author Grupo 1
+ * @brief Interface para a recarga do Banco de Questões com o jogo aberto.
+ * @version 1.2
+ * @copyright Copyright (c) 2025
+ *
+ * Uma thread observa o JSON do banco (inotify no Linux; nos outros sistemas, stat a
+ * cada segundo). Quando ele muda e para de mudar, a própria thread valida o JSON e
+ * monta o pack novo; o jogo só troca o banco pronto entre um quiz e outro, então a
+ * partida em andamento não trava nem muda de perguntas. A troca de idioma usa o mesmo
+ * caminho: a thread passa a observar o banco do outro idioma e o carrega na hora.
+ */
+
+#ifndef QUESTION_RELOAD_H
+#define QUESTION_RELOAD_H
+
+#include "raylib/question_bank.h"
+#include <stdbool.h>
+
+//---------------------------------------------
+// Definições e Tipos Públicos
+//---------------------------------------------
+
+typedef struct {
+    void *worker;   // thread e trava; opaco para não levar pthread.h ao raylib.h
+} QuestionReloader;
+
+//---------------------------------------------
+// Protótipos de Funções Públicas
+//---------------------------------------------
+
+// Começa a observar 'sourcePath'; os bancos recarregados usam 'packPath' como o LoadQuestionBank.
+bool StartQuestionReloader(QuestionReloader *reloader, const char *sourcePath, const char *packPath);
+
+// Passa a observar outro banco; uma recarga do banco anterior ainda não pega é descartada.
+// Com 'load', o banco novo é carregado em segundo plano sem esperar uma mudança e fica
+// pronto para TakeReloadedQuestionBank como uma recarga (ou, se falhar, para
+// TakeFailedQuestionReload). Retorna false se a thread não estiver rodando.
+bool RetargetQuestionReloader(QuestionReloader *reloader, const char *sourcePath, const char *packPath, bool load);
+
+// Retorna true, uma vez, se o banco pedido por RetargetQuestionReloader com 'load' não carregou.
+bool TakeFailedQuestionReload(QuestionReloader *reloader);
+
+// Para a thread e descarta um banco recarregado que não tenha sido usado. Pode ser
+// chamada com um reloader zerado.
+void StopQuestionReloader(QuestionReloader *reloader);
+
+// Se um banco novo estiver pronto, passa-o para 'bank' (que passa a ser de quem chamou)
+// e retorna true. Não espera pela thread.
+bool TakeReloadedQuestionBank(QuestionReloader *reloader, QuestionBank *bank);
+
+#endif // QUESTION_RELOAD_H
@@ -0,0 +1,57 @@
+/**
+ * @file question_stats.h
+ * @author Grupo 1
+ * @brief Interface para as estatísticas de respostas por pergunta.
+ * @version 1.1
+ * @copyright Copyright (c) 2025
+ *
+ * Para cada pergunta do banco: quantas vezes saiu, quantas foi acertada, quantas vezes
+ * cada alternativa foi escolhida e a soma (e a soma dos quadrados) do tempo de resposta,
+ * de onde saem média e desvio padrão. Cada grandeza é uma coluna (um array indexado pela
+ * posição da pergunta no banco), então registrar uma resposta é O(1).
+ *
+ * Uma thread grava as estatísticas em disco periodicamente (e ao fechar o jogo), fora do
+ * laço de frames; o arquivo guarda só as perguntas que já saíram.
+ */
+
+#ifndef QUESTION_STATS_H
+#define QUESTION_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+//---------------------------------------------
+// Definições e Tipos Públicos
+//---------------------------------------------
+
+#define QUESTION_STATS_PATH "resources/question_stats.bin"
+#define QUESTION_STATS_FLUSH_SECONDS 30
+
+typedef struct {
+    int count;
+    uint32_t *ids;              // 0 até a pergunta sair pela primeira vez
+    uint32_t *served;
+    uint32_t *correct;
+    uint32_t *chosen[4];        // respostas em cada alternativa; o que faltar para 'served' é tempo esgotado
+    double *timeSum;            // segundos
+    double *timeSquares;
+    void *flusher;              // thread de gravação e trava das colunas; opaco para não levar pthread.h ao raylib.h
+} QuestionStats;
+
+//---------------------------------------------
+// Protótipos de Funções Públicas
+//---------------------------------------------
+
+// Cria as colunas para um banco de 'count' perguntas, soma o que estiver salvo em 'path'
+// e inicia a thread de gravação. 'findQuestion' devolve a posição atual da pergunta 'id',
+// gravada em 'position' (-1 se saiu do banco), para reconhecer as perguntas do arquivo
+// mesmo que o banco tenha sido reordenado.
+bool InitQuestionStats(QuestionStats *stats, int count, const char *path, int (*findQuestion)(uint32_t position, uint32_t id));
+
+// Para a thread, grava o que faltar e libera as colunas. Pode ser chamada com stats zerado.
+void FreeQuestionStats(QuestionStats *stats);
+
+// Registra uma resposta à pergunta 'index'; 'option' é -1 se o tempo acabou. O(1).
+void RecordQuestionAnswer(QuestionStats *stats, int index, int id, int option, bool correct, float responseTime);
+
+#endif // QUESTION_STATS_H
@@ -2,7 +2,7 @@
  * @file questions.h
  * @author Grupo 1
  * @brief Interface para o módulo do Banco de Questões.
- * @version 1.0
+ * @version 2.1
  * @copyright Copyright (c) 2025
  */
 
@@ -29,19 +29,121 @@ typedef struct {
     int correctOption;
     Difficulty difficulty;
     int points;
+    int id;             // identificador estável da pergunta no banco
 } Question;
 
+// Restrição dos quizzes a uma categoria ou a um tópico do banco.
+typedef enum {
+    QUIZ_FILTER_NONE,
+    QUIZ_FILTER_CATEGORY,
+    QUIZ_FILTER_TOPIC
+} QuizFilter;
+
+// Estilo de um texto quebrado em linhas e centralizado na tela de pergunta.
+typedef struct {
+    float fontSize;
+    float spacing;
+    float width;        // largura máxima de uma linha
+    float maxHeight;    // altura que o texto pode ocupar sem invadir outro elemento da tela
+} TextStyle;
+
+// Enunciado e alternativas (até 4 linhas cada); o compilador do banco (tools/question_compiler.c)
+// precomputa as linhas nesses estilos.
+#define QUESTION_TEXT_STYLE CLITERAL(TextStyle){ 40.0f, 5.0f, 1595.0f, 200.0f }
+#define OPTION_TEXT_STYLE CLITERAL(TextStyle){ 36.0f, 3.0f, 500.0f, 153.0f }
+
+#define TEXT_LAYOUT_MAX_LINES 4
+
+typedef struct {
+    unsigned short start;   // em bytes, a partir do início do texto
+    unsigned short length;
+    float width;            // o mesmo que MeasureTextEx daria para a linha
+} TextLayoutLine;
+
+// Quebra de linhas de um texto; lineCount 0 indica que não há layout precomputado.
+typedef struct {
+    int lineCount;
+    TextLayoutLine lines[TEXT_LAYOUT_MAX_LINES];
+} TextLayout;
+
+// Pergunta do quiz em andamento, montada uma única vez quando entra no quiz: os textos
+// apontam para o banco e o que a tela deriva dela (layouts, rótulo da dificuldade) já vem
+// resolvido, então o laço de frames não copia nem recalcula nada.
+typedef struct {
+    Question question;
+    int bankIndex;                      // posição no banco (o valor em questionOrder)
+    const char *image;                  // relativo a resources/; NULL se não tiver
+    const char *difficultyLabel;        // "FACIL", "MEDIA" ou "DIFICIL"
+    Color difficultyColor;
+    const TextLayout *textLayout;       // enunciado em QUESTION_TEXT_STYLE; NULL sem layout no pack
+    const TextLayout *optionLayouts[4]; // alternativas em OPTION_TEXT_STYLE
+    int layoutFontBaseSize;             // os layouts só valem para uma fonte carregada com esse tamanho
+} QuestionView;
+
 //---------------------------------------------
 // Protótipos de Funções Públicas
 //---------------------------------------------
 
-// Carrega todas as perguntas na memória
+// Carrega todas as perguntas na memória (de resources/questions.json, ou as embutidas)
+// e passa a observar o JSON, para recarregar o banco quando ele for editado.
 void InitializeQuestions(void);
 
-// Seleciona e embaralha as perguntas para um novo quiz
+// Libera o banco carregado por InitializeQuestions
+void UnloadQuestions(void);
+
+// Restringe os próximos quizzes às perguntas da categoria ou do tópico 'name'
+// (QUIZ_FILTER_NONE volta ao banco inteiro). Sem perguntas suficientes de cada
+// dificuldade, o filtro é ignorado e a função retorna false.
+bool SetQuizFilter(QuizFilter filter, const char *name);
+
+// Pede a troca do idioma das perguntas ("pt", "en", "es"...). O banco do idioma é
+// carregado em segundo plano e entra no próximo quiz; só um idioma fica carregado por vez.
+// Se o banco não carregar ou não montar um quiz, o pedido é esquecido e o idioma atual
+// continua. Retorna false se não houver banco para o idioma.
+bool SetQuestionLocale(const char *locale);
+
+// Idioma das perguntas em uso.
+const char *GetQuestionLocale(void);
+
+// Idioma pedido por último: o que ainda está carregando, ou o em uso se não houver pedido.
+const char *GetRequestedQuestionLocale(void);
+
+// Seleciona e embaralha as perguntas para um novo quiz; o custo depende só do
+// tamanho do quiz, não do banco. No modo adaptativo (QUIZ_ADAPTIVE=1) só a primeira
+// é escolhida aqui, e RecordQuizAnswer escolhe cada uma das seguintes. Se o JSON foi
+// editado e o banco novo já está pronto, é aqui, entre um quiz e outro, que ele entra.
 void SelectAndShuffleQuizQuestions(int *questionOrder);
 
-// Retorna uma pergunta específica com base no índice da ordem do quiz
+// Registra a resposta à pergunta questionOrder[position] ('selectedOption' = -1 se o tempo
+// acabou) nas estatísticas por pergunta. No modo adaptativo, atualiza também a estimativa
+// (Elo) da habilidade do jogador e escolhe questionOrder[position + 1] por busca binária no
+// índice de notas do banco, em vez da mistura fixa 8/8/4.
+void RecordQuizAnswer(int *questionOrder, int position, int selectedOption, float responseTime);
+
+// Encerra o quiz em andamento: no fim do jogo, na volta ao menu ou ao fechar o jogo. No
+// modo adaptativo, grava o histórico com as perguntas escolhidas durante o quiz, mesmo
+// que ele tenha sido abandonado no meio. Sem quiz em andamento, não faz nada.
+void FinishQuiz(void);
+
+// Pergunta 'position' (0 a QUIZ_QUESTION_COUNT - 1) do quiz sorteado por último. O ponteiro
+// não muda durante o quiz e vale até o próximo SelectAndShuffleQuizQuestions; no modo
+// adaptativo, a pergunta seguinte só é definitiva depois de RecordQuizAnswer.
+const QuestionView *GetQuizQuestion(int position);
+
+// A pergunta 'position' do quiz já está escolhida? No modo adaptativo, só as respondidas
+// e a seguinte; as demais posições guardam uma cópia provisória da primeira.
+bool IsQuizQuestionChosen(int position);
+
+// Retorna uma pergunta específica com base no índice da ordem do quiz.
+// Os textos apontam para o banco carregado (não são copiados).
 Question GetQuestionFromOrder(int orderIndex);
 
+// Caminho da imagem da pergunta (relativo a resources/), ou NULL se ela não tiver imagem.
+// Aponta para o banco carregado, como os textos de GetQuestionFromOrder.
+const char *GetQuestionImage(int orderIndex);
+
+// Layout precomputado do enunciado (option = -1) ou de uma alternativa, para uma fonte carregada
+// com 'fontBaseSize'. Retorna NULL se o banco não tiver layout para esse estilo e fonte.
+const TextLayout *GetQuestionTextLayout(int orderIndex, int option, TextStyle style, int fontBaseSize);
+
 #endif // QUESTIONS_H
\ No newline at end of file
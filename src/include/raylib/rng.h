@@ -0,0 +1,67 @@
+/**
+ * @file rng.h
+ * @author Grupo 1
+ * @brief Gerador de números aleatórios do jogo (PCG32), com um fluxo por subsistema.
+ * @version 1.0
+ * @copyright Copyright (c) 2025
+ *
+ * Todos os fluxos derivam de uma única semente (QUIZ_SEED, ou o relógio): com a mesma
+ * semente, os sorteios de cada subsistema se repetem exatamente, e um subsistema que
+ * sorteia mais ou menos vezes não altera a sequência dos outros.
+ * Cada fluxo deve ser usado por uma única thread.
+ */
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+//---------------------------------------------
+// Definições e Tipos Públicos
+//---------------------------------------------
+
+typedef struct {
+    uint64_t state;
+    uint64_t increment;     // ímpar; distingue os fluxos
+} Rng;
+
+typedef enum {
+    RNG_QUESTIONS,      // sorteio e ordem das perguntas
+    RNG_MUSIC,          // ordem da playlist
+    RNG_WATER_FX,       // gotas e chuva
+    RNG_STREAM_COUNT
+} RngStream;
+
+//---------------------------------------------
+// Protótipos de Funções Públicas
+//---------------------------------------------
+
+// Semeia todos os fluxos com QUIZ_SEED, se definida, ou com o relógio; a semente usada
+// é mostrada no log para que a partida possa ser repetida.
+void InitRandomStreams(void);
+
+// Semeia todos os fluxos a partir de 'seed' (benchmarks e replays).
+void SeedRandomStreams(uint64_t seed);
+
+// Semente usada na última inicialização.
+uint64_t GetRandomSeed(void);
+
+// Fluxo de um subsistema.
+Rng *GetRandomStream(RngStream stream);
+
+// 32 bits uniformes.
+uint32_t RngNext(Rng *rng);
+
+// Inteiro uniforme em [0, bound), sem o viés de 'rand() % bound'; bound > 0.
+uint32_t RngBelow(Rng *rng, uint32_t bound);
+
+// Inteiro uniforme em [min, max], como GetRandomValue do raylib.
+int RngRange(Rng *rng, int min, int max);
+
+// Float uniforme em [min, max).
+float RngFloat(Rng *rng, float min, float max);
+
+// Fisher-Yates sobre os 'size' primeiros elementos.
+void RngShuffle(Rng *rng, int *array, int size);
+
+#endif // RNG_H
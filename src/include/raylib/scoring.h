@@ -2,7 +2,7 @@
  * @file scoring.h
  * @author Grupo 1
  * @brief Interface para o módulo de Pontuação.
- * @version 1.0
+ * @version 1.1
  * @copyright Copyright (c) 2025
  */
 
@@ -18,7 +18,7 @@
 void ResetPlayerScore(void);
 
 // Calcula os pontos ganhos para uma questão com base no tempo restante.
-int CalculatePointsEarned(Question q, float timeRemaining);
+int CalculatePointsEarned(const Question *q, float timeRemaining);
 
 // Adiciona os pontos calculados à pontuação total do jogador.
 void AddToPlayerScore(int points);
@@ -0,0 +1,45 @@
+/**
+ * @file text_layout.h
+ * @author Grupo 1
+ * @brief Interface para o desenho de textos quebrados em linhas e centralizados, com cache.
+ * @version 1.0
+ * @copyright Copyright (c) 2025
+ *
+ * O primeiro desenho de um texto quebra as linhas (ou usa as do pack), decodifica o UTF-8,
+ * acha cada glyph na fonte e guarda o retângulo de origem (no atlas da fonte) e de destino
+ * (na tela) de cada caractere. Os desenhos seguintes do mesmo texto, com a mesma fonte,
+ * tamanho, espaçamento e retângulo, só repetem esses retângulos, sem medir nada.
+ * O cache guarda TEXT_LAYOUT_CACHE_SIZE textos e descarta o usado há mais tempo.
+ */
+
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include "raylib/raylib.h"
+#include "raylib/questions.h"
+
+//---------------------------------------------
+// Definições e Tipos Públicos
+//---------------------------------------------
+
+#define TEXT_LAYOUT_CACHE_SIZE 16   // a tela de pergunta usa 5 (enunciado e alternativas)
+#define WRAP_MAX_LINES 20           // linhas de um texto quebrado na hora (sem layout do pack)
+
+//---------------------------------------------
+// Protótipos de Funções Públicas
+//---------------------------------------------
+
+// Quebra 'text' por palavras para caber em 'maxWidth'; cada linha é um trecho do texto.
+// Retorna o número de linhas (no máximo 'maxLines').
+int WrapTextLines(Font font, const char *text, float fontSize, float spacing, float maxWidth, TextLayoutLine *lines, int maxLines);
+
+// Desenha 'text' quebrado em linhas e centralizado em 'rec'.
+void DrawTextWrappedCentered(Font font, const char *text, Rectangle rec, float fontSize, float spacing, Color color);
+
+// Mesmo desenho de DrawTextWrappedCentered, mas com as linhas e larguras já calculadas.
+void DrawTextLayoutCentered(Font font, const char *text, const TextLayout *layout, Rectangle rec, float fontSize, float spacing, Color color);
+
+// Libera o cache. Chamar antes de descarregar uma fonte usada nos desenhos.
+void UnloadTextLayoutCache(void);
+
+#endif // TEXT_LAYOUT_H
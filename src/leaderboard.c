@@ -2,7 +2,7 @@
  * @file leaderboard.c
  * @author Grupo 1
  * @brief Implementação do módulo de Leaderboard (placar) conectado ao Firebase Firestore.
- * @version 2.2
+ * @version 2.3
  * @copyright Copyright (c) 2025
  *
  * @note Mudanças da v2.2 (Correção de Conflito):
@@ -39,6 +39,22 @@ struct MemoryStruct {
   size_t size;
 };
 
+// Caminho lido na resposta de /scores: documents[].fields.{name,score}.{stringValue,integerValue}
+#define SCORES_PATH_DEPTH 6
+
+// Estado do decodificador por eventos: só guarda a chave ativa de cada nível, não monta a árvore JSON.
+typedef struct {
+    PlayerScore entries[LEADERBOARD_SIZE];
+    int count;
+    int documentsFound;
+    const char *keys[SCORES_PATH_DEPTH];
+    size_t keyLengths[SCORES_PATH_DEPTH];
+    char name[MAX_NAME_LENGTH + 1];
+    int score;
+    int hasName;
+    int hasScore;
+} ScoresDecoder;
+
 //---------------------------------------------
 // Protótipos de Funções Privadas
 //---------------------------------------------
@@ -46,6 +62,8 @@ static void FetchLeaderboardFromCloud(void);
 static void SubmitScoreToCloud(const char* name, int score);
 static int FetchPlayerRank(int score);
 static size_t WriteCallback(void *contents, size_t size, size_t nmemb, void *userp);
+static cJSON_bool DecodeScoresEvent(const cJSON_Event *event, void *userData);
+static void WriteFirestoreValue(cJSON_Writer *writer, const char *field, const char *type, const char *value);
 
 //---------------------------------------------
 // Função Callback do cURL
@@ -65,6 +83,80 @@ static size_t WriteCallback(void *contents, size_t size, size_t nmemb, void *use
     return realsize;
 }
 
+//---------------------------------------------
+// Decodificação da Resposta do Firestore
+//---------------------------------------------
+static int KeyIs(const ScoresDecoder *decoder, size_t depth, const char *key) {
+    size_t length = strlen(key);
+    return decoder->keys[depth] != NULL && decoder->keyLengths[depth] == length && memcmp(decoder->keys[depth], key, length) == 0;
+}
+
+// Copia o texto de um evento (trecho da entrada, talvez com escapes) truncando em destSize - 1.
+static void CopyEventText(char *dest, size_t destSize, const cJSON_Event *event) {
+    char text[64];
+    const char *source = event->start;
+    size_t length = event->length;
+    if (event->escaped && length < sizeof(text) && cJSON_UnescapeString(event->start, event->length, text, sizeof(text))) {
+        source = text;
+        length = strlen(text);
+    }
+    if (length > destSize - 1) length = destSize - 1;
+    memcpy(dest, source, length);
+    dest[length] = '\0';
+}
+
+static cJSON_bool DecodeScoresEvent(const cJSON_Event *event, void *userData) {
+    ScoresDecoder *decoder = (ScoresDecoder *)userData;
+    size_t depth = event->depth;
+
+    if (event->type == cJSON_EventKey) {
+        if (depth < SCORES_PATH_DEPTH) {
+            decoder->keys[depth] = event->start;
+            decoder->keyLengths[depth] = event->length;
+        }
+        return 1;
+    }
+    // Filhos de um container novo ainda não têm chave (e itens de array nunca terão).
+    if ((event->type == cJSON_EventObjectBegin || event->type == cJSON_EventArrayBegin) && depth + 1 < SCORES_PATH_DEPTH) {
+        decoder->keys[depth + 1] = NULL;
+    }
+
+    if (depth == 0 || depth >= SCORES_PATH_DEPTH || !KeyIs(decoder, 1, "documents")) return 1;
+    if (depth == 1) {
+        if (event->type == cJSON_EventArrayBegin) decoder->documentsFound = 1;
+        return 1;
+    }
+    if (!decoder->documentsFound) return 1;
+
+    if (depth == 2) {
+        if (event->type == cJSON_EventObjectBegin) {
+            decoder->hasName = 0;
+            decoder->hasScore = 0;
+        } else if (event->type == cJSON_EventObjectEnd && decoder->hasName && decoder->hasScore) {
+            PlayerScore *entry = &decoder->entries[decoder->count++];
+            strcpy(entry->name, decoder->name);
+            entry->score = decoder->score;
+            fprintf(stderr, "[FetchLeaderboard] Lido: %s - %d\n", entry->name, entry->score);
+            // Placar cheio: o resto da resposta nem precisa ser lido.
+            if (decoder->count >= LEADERBOARD_SIZE) return 0;
+        }
+        return 1;
+    }
+
+    if (depth == 5 && event->type == cJSON_EventString && KeyIs(decoder, 3, "fields")) {
+        if (KeyIs(decoder, 4, "name") && KeyIs(decoder, 5, "stringValue")) {
+            CopyEventText(decoder->name, sizeof(decoder->name), event);
+            decoder->hasName = 1;
+        } else if (KeyIs(decoder, 4, "score") && KeyIs(decoder, 5, "integerValue")) {
+            char digits[24];
+            CopyEventText(digits, sizeof(digits), event);
+            decoder->score = atoi(digits);
+            decoder->hasScore = 1;
+        }
+    }
+    return 1;
+}
+
 //---------------------------------------------
 // Implementação das Funções Públicas
 //---------------------------------------------
@@ -98,6 +190,18 @@ int GetPlayerRank(int score) {
 }
 
 
+//---------------------------------------------
+// Montagem dos Payloads
+//---------------------------------------------
+// Escreve "field": {"type": "value"}, o formato de valor tipado do Firestore.
+static void WriteFirestoreValue(cJSON_Writer *writer, const char *field, const char *type, const char *value) {
+    cJSON_WriteKey(writer, field);
+    cJSON_WriteObjectBegin(writer);
+    cJSON_WriteKey(writer, type);
+    cJSON_WriteString(writer, value);
+    cJSON_WriteObjectEnd(writer);
+}
+
 //---------------------------------------------
 // Funções de Comunicação com Firebase
 //---------------------------------------------
@@ -112,14 +216,29 @@ static void SubmitScoreToCloud(const char* name, int score) {
     struct curl_slist *headers = NULL;
     char url[512];
     char json_payload[256];
+    char score_text[16];
+    cJSON_Writer writer;
     struct MemoryStruct chunk;
+
+    snprintf(url, sizeof(url), "%s/scores", FIRESTORE_BASE_URL);
+    snprintf(score_text, sizeof(score_text), "%d", score);
+
+    // O writer escapa o nome e avisa se o payload não couber no buffer.
+    cJSON_WriterInit(&writer, json_payload, sizeof(json_payload));
+    cJSON_WriteObjectBegin(&writer);
+    cJSON_WriteKey(&writer, "fields");
+    cJSON_WriteObjectBegin(&writer);
+    WriteFirestoreValue(&writer, "name", "stringValue", name);
+    WriteFirestoreValue(&writer, "score", "integerValue", score_text);
+    cJSON_WriteObjectEnd(&writer);
+    cJSON_WriteObjectEnd(&writer);
+    if (cJSON_WriterFinish(&writer) == NULL) {
+        fprintf(stderr, "[SubmitScore] Erro: payload não coube em %zu bytes.\n", sizeof(json_payload));
+        return;
+    }
+
     chunk.memory = malloc(1);
     chunk.size = 0;
-    
-    snprintf(url, sizeof(url), "%s/scores", FIRESTORE_BASE_URL);
-    snprintf(json_payload, sizeof(json_payload),
-             "{\"fields\": {\"name\": {\"stringValue\": \"%s\"}, \"score\": {\"integerValue\": \"%d\"}}}",
-             name, score);
 
     fprintf(stderr, "[SubmitScore] URL: %s\n", url);
     fprintf(stderr, "[SubmitScore] Payload: %s\n", json_payload);
@@ -187,43 +306,25 @@ static void FetchLeaderboardFromCloud(void) {
         
         if (response_code == 200) {
             fprintf(stderr, "[FetchLeaderboard] Resposta recebida (tamanho: %zu bytes). Analisando JSON...\n", chunk.size);
-            cJSON *json = cJSON_Parse(chunk.memory);
-            if (json == NULL) {
+            ScoresDecoder decoder;
+            memset(&decoder, 0, sizeof(decoder));
+            if (!cJSON_ParseEvents(chunk.memory, chunk.size, DecodeScoresEvent, &decoder, NULL)) {
                 const char *error_ptr = cJSON_GetErrorPtr();
                 if (error_ptr != NULL) {
                     fprintf(stderr, "[FetchLeaderboard] Erro ao parsear JSON: %s\n", error_ptr);
                 } else {
                     fprintf(stderr, "[FetchLeaderboard] Erro ao parsear JSON, mas cJSON_GetErrorPtr() retornou NULL.\n");
                 }
+            } else if (!decoder.documentsFound) {
+                fprintf(stderr, "[FetchLeaderboard] Resposta JSON não contém um array 'documents'.\n");
             } else {
-                cJSON *documents = cJSON_GetObjectItemCaseSensitive(json, "documents");
-                if (!cJSON_IsArray(documents)) {
-                     fprintf(stderr, "[FetchLeaderboard] Resposta JSON não contém um array 'documents'.\n");
-                } else {
-                    cJSON *doc = NULL;
-                    int count = 0;
-                    cJSON_ArrayForEach(doc, documents) {
-                        if (count >= LEADERBOARD_SIZE) break;
-                        cJSON *fields = cJSON_GetObjectItemCaseSensitive(doc, "fields");
-                        cJSON *nameObj = cJSON_GetObjectItemCaseSensitive(fields, "name");
-                        cJSON *scoreObj = cJSON_GetObjectItemCaseSensitive(fields, "score");
-                        if (cJSON_IsObject(nameObj) && cJSON_IsObject(scoreObj)) {
-                            cJSON *nameVal = cJSON_GetObjectItemCaseSensitive(nameObj, "stringValue");
-                            cJSON *scoreVal = cJSON_GetObjectItemCaseSensitive(scoreObj, "integerValue");
-                            if (cJSON_IsString(nameVal) && (nameVal->valuestring != NULL) && cJSON_IsString(scoreVal)) {
-                                strncpy(leaderboard[count].name, nameVal->valuestring, MAX_NAME_LENGTH);
-                                leaderboard[count].name[MAX_NAME_LENGTH] = '\0';
-                                leaderboard[count].score = atoi(scoreVal->valuestring);
-                                fprintf(stderr, "[FetchLeaderboard] Lido: %s - %d\n", leaderboard[count].name, leaderboard[count].score);
-                                count++;
-                            }
-                        }
-                    }
-                    cJSON_Delete(json);
-                    fprintf(stderr, "[FetchLeaderboard] Leitura do JSON concluída. %d scores carregados.\n", count);
-                    for (int i = count; i < LEADERBOARD_SIZE; i++) {
-                         strcpy(leaderboard[i].name, "---");
-                         leaderboard[i].score = 0;
+                fprintf(stderr, "[FetchLeaderboard] Leitura do JSON concluída. %d scores carregados.\n", decoder.count);
+                for (int i = 0; i < LEADERBOARD_SIZE; i++) {
+                    if (i < decoder.count) {
+                        leaderboard[i] = decoder.entries[i];
+                    } else {
+                        strcpy(leaderboard[i].name, "---");
+                        leaderboard[i].score = 0;
                     }
                 }
             }
@@ -245,16 +346,62 @@ static int FetchPlayerRank(int score) {
     struct curl_slist *headers = NULL;
     char url[512];
     char json_payload[512];
+    char score_text[16];
+    cJSON_Writer writer;
     struct MemoryStruct chunk;
-    chunk.memory = malloc(1);
-    chunk.size = 0;
     int rank = -1;
 
     snprintf(url, sizeof(url), "%s:runAggregationQuery", FIRESTORE_BASE_URL);
+    snprintf(score_text, sizeof(score_text), "%d", score);
+
+    // Conta quantos scores são maiores que o do jogador.
+    cJSON_WriterInit(&writer, json_payload, sizeof(json_payload));
+    cJSON_WriteObjectBegin(&writer);
+    cJSON_WriteKey(&writer, "structuredAggregationQuery");
+    cJSON_WriteObjectBegin(&writer);
+    cJSON_WriteKey(&writer, "structuredQuery");
+    cJSON_WriteObjectBegin(&writer);
+    cJSON_WriteKey(&writer, "from");
+    cJSON_WriteArrayBegin(&writer);
+    cJSON_WriteObjectBegin(&writer);
+    cJSON_WriteKey(&writer, "collectionId");
+    cJSON_WriteString(&writer, "scores");
+    cJSON_WriteObjectEnd(&writer);
+    cJSON_WriteArrayEnd(&writer);
+    cJSON_WriteKey(&writer, "where");
+    cJSON_WriteObjectBegin(&writer);
+    cJSON_WriteKey(&writer, "fieldFilter");
+    cJSON_WriteObjectBegin(&writer);
+    cJSON_WriteKey(&writer, "field");
+    cJSON_WriteObjectBegin(&writer);
+    cJSON_WriteKey(&writer, "fieldPath");
+    cJSON_WriteString(&writer, "score");
+    cJSON_WriteObjectEnd(&writer);
+    cJSON_WriteKey(&writer, "op");
+    cJSON_WriteString(&writer, "GREATER_THAN");
+    WriteFirestoreValue(&writer, "value", "integerValue", score_text);
+    cJSON_WriteObjectEnd(&writer);
+    cJSON_WriteObjectEnd(&writer);
+    cJSON_WriteObjectEnd(&writer);
+    cJSON_WriteKey(&writer, "aggregations");
+    cJSON_WriteArrayBegin(&writer);
+    cJSON_WriteObjectBegin(&writer);
+    cJSON_WriteKey(&writer, "count");
+    cJSON_WriteObjectBegin(&writer);
+    cJSON_WriteObjectEnd(&writer);
+    cJSON_WriteKey(&writer, "alias");
+    cJSON_WriteString(&writer, "total_count");
+    cJSON_WriteObjectEnd(&writer);
+    cJSON_WriteArrayEnd(&writer);
+    cJSON_WriteObjectEnd(&writer);
+    cJSON_WriteObjectEnd(&writer);
+    if (cJSON_WriterFinish(&writer) == NULL) {
+        fprintf(stderr, "[FetchPlayerRank] Erro: payload não coube em %zu bytes.\n", sizeof(json_payload));
+        return -1;
+    }
 
-    snprintf(json_payload, sizeof(json_payload),
-             "{\"structuredAggregationQuery\": {\"structuredQuery\": {\"from\": [{\"collectionId\": \"scores\"}], \"where\": {\"fieldFilter\": {\"field\": {\"fieldPath\": \"score\"}, \"op\": \"GREATER_THAN\", \"value\": {\"integerValue\": \"%d\"}}}}, \"aggregations\": [{\"count\": {}, \"alias\": \"total_count\"}]}}",
-             score);
+    chunk.memory = malloc(1);
+    chunk.size = 0;
 
     fprintf(stderr, "[FetchPlayerRank] URL: %s\n", url);
     fprintf(stderr, "[FetchPlayerRank] Payload: %s\n", json_payload);
@@ -280,17 +427,16 @@ static int FetchPlayerRank(int score) {
         fprintf(stderr, "[FetchPlayerRank] HTTP Response Code: %ld\n", response_code);
 
         if (response_code == 200) {
-            cJSON *json_array = cJSON_Parse(chunk.memory);
-            cJSON *json = cJSON_GetArrayItem(json_array, 0); 
-
-            if (json) {
-                cJSON *result = cJSON_GetObjectItemCaseSensitive(json, "result");
-                cJSON *aggregateFields = cJSON_GetObjectItemCaseSensitive(result, "aggregateFields");
-                cJSON *totalCountObj = cJSON_GetObjectItemCaseSensitive(aggregateFields, "total_count");
-                cJSON *countVal = cJSON_GetObjectItemCaseSensitive(totalCountObj, "integerValue");
-
-                if (cJSON_IsString(countVal)) {
-                    int count = atoi(countVal->valuestring);
+            // Só o caminho [0].result.aggregateFields.total_count.integerValue é lido, o resto da resposta é pulado.
+            cJSON_Lazy response, item;
+            char count_text[24];
+            if (cJSON_LazyParse(chunk.memory, chunk.size, &response) && cJSON_LazyGetArrayItem(&response, 0, &item)) {
+                if (cJSON_LazyGetObjectItem(&item, "result", &item)
+                    && cJSON_LazyGetObjectItem(&item, "aggregateFields", &item)
+                    && cJSON_LazyGetObjectItem(&item, "total_count", &item)
+                    && cJSON_LazyGetObjectItem(&item, "integerValue", &item)
+                    && cJSON_LazyGetString(&item, count_text, sizeof(count_text))) {
+                    int count = atoi(count_text);
                     rank = count + 1; 
                     fprintf(stderr, "[FetchPlayerRank] %d scores maiores. Rank do jogador: %d\n", count, rank);
                 } else {
@@ -299,7 +445,6 @@ static int FetchPlayerRank(int score) {
             } else {
                 fprintf(stderr, "[FetchPlayerRank] Erro ao parsear JSON da resposta.\n");
             }
-            cJSON_Delete(json_array);
         } else {
             fprintf(stderr, "[FetchPlayerRank] Erro na consulta. Resposta do servidor:\n%s\n", chunk.memory ? chunk.memory : "(sem corpo)");
         }
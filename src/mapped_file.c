@@ -0,0 +1,75 @@
+/**
+ * @file mapped_file.c
+ * @author Grupo 1
+ * @brief Implementação do mapeamento de arquivos somente leitura.
+ * @version 1.0
+ * @copyright Copyright (c) 2025
+ *
+ * Fica em um módulo separado para que windows.h nunca seja incluído junto com raylib.h.
+ */
+
+#if defined(_WIN32)
+    #define NOGDI
+    #define NOMINMAX
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #define _POSIX_C_SOURCE 200112L
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "raylib/mapped_file.h"
+#include <string.h>
+
+int MapFile(MappedFile *file, const char *path) {
+    memset(file, 0, sizeof(*file));
+#if defined(_WIN32)
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) return 0;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart <= 0 || (unsigned long long)size.QuadPart > (size_t)-1) {
+        CloseHandle(handle);
+        return 0;
+    }
+    HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(handle); // o mapeamento mantém o arquivo aberto
+    if (mapping == NULL) return 0;
+    const void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL) {
+        CloseHandle(mapping);
+        return 0;
+    }
+    file->data = data;
+    file->size = (size_t)size.QuadPart;
+    file->handle = mapping;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return 0;
+    }
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // o mapeamento continua válido
+    if (data == MAP_FAILED) return 0;
+    file->data = data;
+    file->size = (size_t)info.st_size;
+#endif
+    return 1;
+}
+
+void UnmapFile(MappedFile *file) {
+    if (file->data != NULL) {
+#if defined(_WIN32)
+        UnmapViewOfFile(file->data);
+        CloseHandle((HANDLE)file->handle);
+#else
+        munmap((void *)file->data, file->size);
+#endif
+    }
+    memset(file, 0, sizeof(*file));
+}
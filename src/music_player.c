@@ -12,6 +12,7 @@
 
 #include "raylib/raylib.h"
 #include "raylib/music_player.h"
+#include "raylib/rng.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <time.h>
@@ -58,7 +59,6 @@ static float playerAnimationTimer = 0.0f;
 static float sliderAnimationTimer = 0.0f;
 
 // Protótipos de funções internas
-static void ShuffleIntArray(int *array, int size);
 static void PlayNextSong(void);
 static void PlayPreviousSong(void);
 static float Clamp(float value, float min, float max);
@@ -95,7 +95,7 @@ void InitMusicPlayer(void) {
     for (int i = 0; i < TOTAL_MUSICS - 1; i++) {
         playlistOrder[i] = i + 1;
     }
-    ShuffleIntArray(playlistOrder, TOTAL_MUSICS - 1);
+    RngShuffle(GetRandomStream(RNG_MUSIC), playlistOrder, TOTAL_MUSICS - 1);
     PlayMusicStream(musicPlaylist[currentMusicIndex]);
     UpdateMusicVolume();
 }
@@ -340,24 +340,15 @@ void UpdateMusicVolume(void) {
     SetMusicVolume(musicPlaylist[currentMusicIndex], scaledVolume);
 }
 
-static void ShuffleIntArray(int *array, int size) {
-    for (int i = size - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
-        int temp = array[i];
-        array[i] = array[j];
-        array[j] = temp;
-    }
-}
-
 static void PlayNextSong(void) {
     StopMusicStream(musicPlaylist[currentMusicIndex]);
     if (currentPlaylistPosition == -1) {
-        ShuffleIntArray(playlistOrder, TOTAL_MUSICS - 1);
+        RngShuffle(GetRandomStream(RNG_MUSIC), playlistOrder, TOTAL_MUSICS - 1);
         currentPlaylistPosition = 0;
     } else {
         currentPlaylistPosition++;
         if (currentPlaylistPosition >= TOTAL_MUSICS - 1) {
-            ShuffleIntArray(playlistOrder, TOTAL_MUSICS - 1);
+            RngShuffle(GetRandomStream(RNG_MUSIC), playlistOrder, TOTAL_MUSICS - 1);
             currentPlaylistPosition = 0;
         }
     }
@@ -0,0 +1,681 @@
+/**
+ * @file question_bank.c
+ * @author Grupo 1
+ * @brief Implementação do carregamento do Banco de Questões (JSON + pack mapeado).
+ * @version 2.9
+ * @copyright Copyright (c) 2025
+ *
+ * Formato do pack (ordem de bytes da máquina):
+ * - PackHeader: assinatura, versão, identificação do JSON de origem (tamanho, data de
+ *   modificação e hash FNV-1a 64), quantidade de perguntas por dificuldade e tamanho
+ *   da tabela de textos;
+ * - um PackRecord por pergunta, agrupados por dificuldade (fáceis, médias, difíceis),
+ *   com os textos (e o caminho da imagem, se houver) guardados como deslocamentos na tabela;
+ * - o índice por nota: um QuestionRating por pergunta, em ordem crescente de nota;
+ * - opcionalmente, um QuestionLayout por pergunta, na mesma ordem dos registros, com a
+ *   fonte e os estilos para os quais foi calculado (gerado por tools/question_compiler.c);
+ * - o índice de categorias e tópicos: um PackTag por nome (categorias e depois tópicos,
+ *   cada grupo em ordem de nome), apontando para listas de registros em que as perguntas
+ *   de cada dificuldade estão contíguas, seguido dessas listas (uint32);
+ * - a tabela de textos (UTF-8, cada um terminado em '\0'); textos iguais são gravados
+ *   uma única vez.
+ * Na carga só o cabeçalho é conferido; os deslocamentos são checados a cada acesso,
+ * então nenhuma página de registros ou textos é tocada antes de ser usada.
+ */
+
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "raylib/question_bank.h"
+#include "raylib/cJSON.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+//---------------------------------------------
+// Definições e Constantes (Privadas ao Módulo)
+//---------------------------------------------
+#define PACK_MAGIC "QPAK"
+#define PACK_VERSION 6
+#define OPTION_COUNT 4
+#define MAX_POINTS 65535
+#define DIFFICULTY_COUNT 3
+#define PACK_NO_TEXT UINT32_MAX    // campo de texto opcional ausente
+
+#if defined(_WIN32)
+    #define FILE_DESCRIPTOR(file) _fileno(file)
+#else
+    #define FILE_DESCRIPTOR(file) fileno(file)
+#endif
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceHash;
+    uint64_t sourceSize;
+    int64_t sourceModified;
+    uint32_t questionCount;
+    uint32_t stringsSize;
+    uint32_t difficultyCount[DIFFICULTY_COUNT];
+    uint32_t layoutFontBaseSize;    // 0 = sem layouts
+    uint64_t layoutFontHash;
+    float layoutStyles[LAYOUT_STYLE_COUNT][3];  // tamanho, espaçamento e largura
+    uint32_t tagCount[2];           // categorias e tópicos
+    uint32_t tagIndexCount;
+} PackHeader;
+
+typedef struct {
+    uint32_t id;
+    uint32_t text;
+    uint32_t options[OPTION_COUNT];
+    uint8_t correctOption;
+    uint8_t difficulty;
+    uint16_t points;
+    float rating;
+    uint32_t image;         // PACK_NO_TEXT se a pergunta não tiver imagem
+} PackRecord;
+
+typedef struct {
+    uint32_t name;                          // deslocamento na tabela de textos
+    uint32_t first[DIFFICULTY_COUNT];       // na lista de índices do pack
+    uint32_t count[DIFFICULTY_COUNT];
+} PackTag;
+
+// Uma pergunta marcada com um nome, ao montar o índice.
+typedef struct {
+    const char *name;
+    uint32_t record;
+} TagRef;
+
+// Tabela de textos em construção, com um hash aberto para não repetir textos.
+typedef struct {
+    char *data;
+    size_t used;
+    uint32_t *slots;    // deslocamento + 1; 0 = vazio
+    size_t slotMask;
+} StringTable;
+
+static const char *difficultyNames[DIFFICULTY_COUNT] = { "easy", "medium", "hard" };
+static const float defaultRatings[DIFFICULTY_COUNT] = { QUESTION_RATING_EASY, QUESTION_RATING_MEDIUM, QUESTION_RATING_HARD };
+
+//---------------------------------------------
+// Funções Privadas
+//---------------------------------------------
+// FNV-1a de 64 bits.
+static uint64_t HashBytes(const char *data, size_t size) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool ReadInteger(const cJSON_Tape *tape, size_t value, int min, int max, int *out) {
+    if (value == 0 || cJSON_TapeType(tape, value) != cJSON_Number) return false;
+    double number = cJSON_TapeNumber(tape, value);
+    if (number < min || number > max || number != (double)(int)number) return false;
+    *out = (int)number;
+    return true;
+}
+
+static const char *ReadText(const cJSON_Tape *tape, size_t value) {
+    if (value == 0 || cJSON_TapeType(tape, value) != cJSON_String) return NULL;
+    const char *text = cJSON_TapeString(tape, value);
+    return (text != NULL && text[0] != '\0') ? text : NULL;
+}
+
+// Campo opcional: ausente vira NULL; presente, precisa ser um texto não vazio.
+static bool ReadOptionalText(const cJSON_Tape *tape, size_t value, const char **out) {
+    *out = (value != 0) ? ReadText(tape, value) : NULL;
+    return value == 0 || *out != NULL;
+}
+
+// Lê uma pergunta do JSON; os textos apontam para dentro da tape.
+static bool ReadSourceEntry(const cJSON_Tape *tape, size_t item, Question *entry, QuestionMeta *meta) {
+    if (cJSON_TapeType(tape, item) != cJSON_Object) return false;
+    if (!ReadInteger(tape, cJSON_TapeGetObjectItem(tape, item, "id"), 1, INT32_MAX, &entry->id)) return false;
+    if (!ReadInteger(tape, cJSON_TapeGetObjectItem(tape, item, "correct"), 0, OPTION_COUNT - 1, &entry->correctOption)) return false;
+    if (!ReadInteger(tape, cJSON_TapeGetObjectItem(tape, item, "points"), 1, MAX_POINTS, &entry->points)) return false;
+    if ((entry->questionText = ReadText(tape, cJSON_TapeGetObjectItem(tape, item, "text"))) == NULL) return false;
+    if (!ReadOptionalText(tape, cJSON_TapeGetObjectItem(tape, item, "category"), &meta->category)) return false;
+    if (!ReadOptionalText(tape, cJSON_TapeGetObjectItem(tape, item, "topic"), &meta->topic)) return false;
+    if (!ReadOptionalText(tape, cJSON_TapeGetObjectItem(tape, item, "image"), &meta->image)) return false;
+    if (meta->image != NULL && !IsValidQuestionImagePath(meta->image)) return false;
+    size_t rating = cJSON_TapeGetObjectItem(tape, item, "rating");
+    meta->rating = 0.0f;
+    if (rating != 0) {
+        if (cJSON_TapeType(tape, rating) != cJSON_Number) return false;
+        double value = cJSON_TapeNumber(tape, rating);
+        if (value < QUESTION_RATING_MIN || value > QUESTION_RATING_MAX) return false;
+        meta->rating = (float)value;
+    }
+
+    size_t options = cJSON_TapeGetObjectItem(tape, item, "options");
+    if (options == 0 || cJSON_TapeType(tape, options) != cJSON_Array || cJSON_TapeSize(tape, options) != OPTION_COUNT) return false;
+    for (int i = 0; i < OPTION_COUNT; i++) {
+        if ((entry->options[i] = ReadText(tape, cJSON_TapeGetArrayItem(tape, options, i))) == NULL) return false;
+    }
+
+    const char *difficulty = ReadText(tape, cJSON_TapeGetObjectItem(tape, item, "difficulty"));
+    if (difficulty == NULL) return false;
+    for (int d = EASY; d <= HARD; d++) {
+        if (strcmp(difficulty, difficultyNames[d]) == 0) {
+            entry->difficulty = (Difficulty)d;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool InitStringTable(StringTable *table, size_t maxBytes, size_t maxStrings) {
+    size_t slots = 16;
+    while (slots < maxStrings * 2) slots *= 2;
+    table->data = malloc(maxBytes);
+    table->slots = calloc(slots, sizeof(uint32_t));
+    table->slotMask = slots - 1;
+    table->used = 0;
+    return table->data != NULL && table->slots != NULL;
+}
+
+static void FreeStringTable(StringTable *table) {
+    free(table->data);
+    free(table->slots);
+}
+
+// Retorna o deslocamento do texto, gravando-o só se ainda não estiver na tabela.
+static uint32_t InternString(StringTable *table, const char *text) {
+    size_t length = strlen(text) + 1;
+    size_t slot = (size_t)HashBytes(text, length) & table->slotMask;
+    while (table->slots[slot] != 0) {
+        uint32_t offset = table->slots[slot] - 1;
+        if (strcmp(table->data + offset, text) == 0) return offset;
+        slot = (slot + 1) & table->slotMask;
+    }
+    uint32_t offset = (uint32_t)table->used;
+    memcpy(table->data + table->used, text, length);
+    table->used += length;
+    table->slots[slot] = offset + 1;
+    return offset;
+}
+
+static int CompareTagRefs(const void *a, const void *b) {
+    const TagRef *x = a, *y = b;
+    int order = strcmp(x->name, y->name);
+    if (order != 0) return order;
+    return (x->record > y->record) - (x->record < y->record);
+}
+
+// Ordena as marcações por nome e grava um PackTag por nome distinto. Dentro de um nome os
+// registros ficam em ordem crescente, ou seja, já separados por dificuldade.
+static uint32_t BuildTagIndex(TagRef *refs, size_t refCount, const PackRecord *records, StringTable *table,
+                              PackTag *tags, uint32_t *indices, uint32_t *indexCount) {
+    if (refCount > 1) qsort(refs, refCount, sizeof(TagRef), CompareTagRefs);
+    uint32_t tagCount = 0;
+    for (size_t i = 0; i < refCount; i++) {
+        if (i == 0 || strcmp(refs[i].name, refs[i - 1].name) != 0) {
+            PackTag *tag = &tags[tagCount++];
+            memset(tag, 0, sizeof(*tag));
+            tag->name = InternString(table, refs[i].name);
+            for (int d = 0; d < DIFFICULTY_COUNT; d++) tag->first[d] = *indexCount;
+        }
+        PackTag *tag = &tags[tagCount - 1];
+        int d = records[refs[i].record].difficulty;
+        if (tag->count[d]++ == 0) tag->first[d] = *indexCount;
+        indices[(*indexCount)++] = refs[i].record;
+    }
+    return tagCount;
+}
+
+static int CompareRatings(const void *a, const void *b) {
+    const QuestionRating *x = a, *y = b;
+    if (x->rating != y->rating) return (x->rating > y->rating) - (x->rating < y->rating);
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+// Valida o JSON e monta o pack em memória. Perguntas inválidas são descartadas com aviso.
+static char *BuildPackFromSource(const QuestionSource *source, size_t *packSize) {
+    const char *json = source->json;
+    size_t jsonSize = source->size;
+    const char *error = NULL;
+    cJSON_Tape *tape = cJSON_ParseTape(json, jsonSize, &error);    // não mexe em cJSON_GetErrorPtr: roda na thread de recarga
+    if (tape == NULL) {
+        int line = 1;
+        for (const char *p = json; error != NULL && p < error && p < json + jsonSize; p++) line += (*p == '\n');
+        if (error != NULL) fprintf(stderr, "[QuestionBank] Erro: JSON inválido (linha %d).\n", line);
+        else fprintf(stderr, "[QuestionBank] Erro: JSON inválido.\n");
+        return NULL;
+    }
+    size_t list = cJSON_TapeGetObjectItem(tape, 0, "questions");
+    if (list == 0 || cJSON_TapeType(tape, list) != cJSON_Array) {
+        fprintf(stderr, "[QuestionBank] Erro: array 'questions' não encontrado.\n");
+        cJSON_DeleteTape(tape);
+        return NULL;
+    }
+
+    size_t capacity = (size_t)cJSON_TapeSize(tape, list) + 1;
+    Question *entries = malloc(capacity * sizeof(Question));
+    QuestionMeta *meta = malloc(capacity * sizeof(QuestionMeta));
+    if (entries == NULL || meta == NULL) {
+        free(entries);
+        free(meta);
+        cJSON_DeleteTape(tape);
+        return NULL;
+    }
+    int validCount = 0, position = 0;
+    for (size_t item = cJSON_TapeChild(tape, list); item != 0; item = cJSON_TapeNext(tape, item), position++) {
+        if (ReadSourceEntry(tape, item, &entries[validCount], &meta[validCount])) validCount++;
+        else fprintf(stderr, "[QuestionBank] Aviso: pergunta %d inválida, ignorada.\n", position);
+    }
+
+    char *pack = (validCount > 0) ? BuildQuestionPack(entries, meta, validCount, NULL, source, packSize) : NULL;
+    free(entries);
+    free(meta);
+    cJSON_DeleteTape(tape); // só depois de montar o pack: os textos estão na tape
+    return pack;
+}
+
+static size_t RatingSectionSize(const PackHeader *header) {
+    return (size_t)header->questionCount * sizeof(QuestionRating);
+}
+
+static size_t LayoutSectionSize(const PackHeader *header) {
+    return (header->layoutFontBaseSize != 0) ? (size_t)header->questionCount * sizeof(QuestionLayout) : 0;
+}
+
+static size_t TagSectionSize(const PackHeader *header) {
+    return ((size_t)header->tagCount[TAG_CATEGORY] + header->tagCount[TAG_TOPIC]) * sizeof(PackTag)
+         + (size_t)header->tagIndexCount * sizeof(uint32_t);
+}
+
+// Confere apenas o cabeçalho e os tamanhos; é O(1) qualquer que seja o banco.
+static bool PackIsUsable(const char *pack, size_t size) {
+    if (size < sizeof(PackHeader)) return false;
+    const PackHeader *header = (const PackHeader *)pack;
+    if (memcmp(header->magic, PACK_MAGIC, sizeof(header->magic)) != 0 || header->version != PACK_VERSION) return false;
+    if (header->questionCount == 0 || header->questionCount > INT32_MAX || header->stringsSize == 0) return false;
+    uint64_t total = 0;
+    for (int d = 0; d < DIFFICULTY_COUNT; d++) total += header->difficultyCount[d];
+    if (total != header->questionCount) return false;
+    if (header->tagCount[TAG_CATEGORY] > header->questionCount || header->tagCount[TAG_TOPIC] > header->questionCount) return false;
+    if (header->tagIndexCount > 2 * (uint64_t)header->questionCount) return false;
+    size_t expected = sizeof(PackHeader) + (size_t)header->questionCount * sizeof(PackRecord) + RatingSectionSize(header)
+                    + LayoutSectionSize(header) + TagSectionSize(header) + header->stringsSize;
+    if (size != expected) return false;
+    return pack[size - 1] == '\0';
+}
+
+// O pack corresponde ao JSON? Com o conteúdo já lido ('json'), decide sempre o hash: uma
+// edição do mesmo tamanho gravada no mesmo segundo tem a mesma data. Sem ele (a carga
+// normal, que não lê o arquivo), tamanho e data iguais bastam.
+static bool PackMatchesSource(const char *pack, const PackHeader *stamp, const QuestionSource *json) {
+    const PackHeader *header = (const PackHeader *)pack;
+    if (json != NULL) return header->sourceSize == (uint64_t)json->size && header->sourceHash == HashBytes(json->json, json->size);
+    return header->sourceSize == stamp->sourceSize && header->sourceModified == stamp->sourceModified;
+}
+
+static void AttachPack(QuestionBank *bank, const char *pack) {
+    const PackHeader *header = (const PackHeader *)pack;
+    const char *ratings = pack + sizeof(PackHeader) + header->questionCount * sizeof(PackRecord);
+    const char *layouts = ratings + RatingSectionSize(header);
+    const char *tags = layouts + LayoutSectionSize(header);
+    int tagCount = (int)(header->tagCount[TAG_CATEGORY] + header->tagCount[TAG_TOPIC]);
+    bank->records = header + 1;
+    bank->ratings = (const QuestionRating *)ratings;
+    bank->tagEntries = tags;
+    bank->tagCount[TAG_CATEGORY] = (int)header->tagCount[TAG_CATEGORY];
+    bank->tagCount[TAG_TOPIC] = (int)header->tagCount[TAG_TOPIC];
+    bank->tagIndices = (const uint32_t *)(tags + tagCount * sizeof(PackTag));
+    bank->tagIndexCount = header->tagIndexCount;
+    bank->strings = tags + TagSectionSize(header);
+    bank->stringsSize = header->stringsSize;
+    bank->count = (int)header->questionCount;
+    int first = 0;
+    for (int d = 0; d < DIFFICULTY_COUNT; d++) {
+        bank->difficultyFirst[d] = first;
+        bank->difficultyCount[d] = (int)header->difficultyCount[d];
+        first += bank->difficultyCount[d];
+    }
+    if (header->layoutFontBaseSize != 0) {
+        bank->layouts = (const QuestionLayout *)layouts;
+        bank->layoutFontBaseSize = (int)header->layoutFontBaseSize;
+        for (int i = 0; i < LAYOUT_STYLE_COUNT; i++) {
+            bank->layoutStyles[i] = (TextStyle){ header->layoutStyles[i][0], header->layoutStyles[i][1], header->layoutStyles[i][2], 0.0f };
+        }
+    }
+}
+
+static bool MapPack(QuestionBank *bank, const char *packPath) {
+    if (!MapFile(&bank->file, packPath)) return false;
+    if (!PackIsUsable(bank->file.data, bank->file.size)) {
+        UnmapFile(&bank->file);
+        return false;
+    }
+    return true;
+}
+
+//---------------------------------------------
+// Implementação das Funções Públicas
+//---------------------------------------------
+
+// 'trustStamp': aceita o pack pelo tamanho e pela data do JSON, sem lê-lo.
+static bool LoadBank(QuestionBank *bank, const char *sourcePath, const char *packPath, bool trustStamp) {
+    memset(bank, 0, sizeof(*bank));
+
+    PackHeader source = { 0 };
+    struct stat info;
+    bool hasSource = stat(sourcePath, &info) == 0;
+    if (hasSource) {
+        source.sourceSize = (uint64_t)info.st_size;
+        source.sourceModified = (int64_t)info.st_mtime;
+    }
+
+    // Caminho normal: o pack está em dia e é só mapeado.
+    QuestionSource json = { 0 };
+    bool haveJson = false;
+    if (MapPack(bank, packPath)) {
+        if (!hasSource || (trustStamp && PackMatchesSource(bank->file.data, &source, NULL))) {
+            AttachPack(bank, bank->file.data);
+            fprintf(stderr, "[QuestionBank] %d perguntas mapeadas de '%s'.\n", bank->count, packPath);
+            return true;
+        }
+        // Data diferente (o conteúdo pode ser o mesmo: arquivo copiado, checkout) ou recarga.
+        haveJson = ReadQuestionSource(sourcePath, &json);
+        if (haveJson && PackMatchesSource(bank->file.data, &source, &json)) {
+            FreeQuestionSource(&json);
+            AttachPack(bank, bank->file.data);
+            fprintf(stderr, "[QuestionBank] %d perguntas mapeadas de '%s'.\n", bank->count, packPath);
+            return true;
+        }
+        UnmapFile(&bank->file); // precisa ser desfeito antes de regravar o arquivo no Windows
+    }
+
+    if (!haveJson && hasSource) haveJson = ReadQuestionSource(sourcePath, &json);
+    if (!haveJson) {
+        fprintf(stderr, "[QuestionBank] Aviso: '%s' não encontrado.\n", sourcePath);
+        return false;
+    }
+    // O pack leva a identificação deste conteúdo: se o JSON for gravado de novo enquanto o
+    // pack é montado, a próxima carga vê a diferença e monta outro.
+    size_t packSize = 0;
+    char *pack = BuildPackFromSource(&json, &packSize);
+    FreeQuestionSource(&json);
+    if (pack == NULL) return false;
+
+    if (WriteQuestionPack(packPath, pack, packSize) && MapPack(bank, packPath)) {
+        free(pack);
+        AttachPack(bank, bank->file.data);
+    } else {
+        fprintf(stderr, "[QuestionBank] Aviso: não foi possível gravar '%s', usando o pack em memória.\n", packPath);
+        bank->image = pack;
+        AttachPack(bank, bank->image);
+    }
+    fprintf(stderr, "[QuestionBank] %d perguntas carregadas de '%s'.\n", bank->count, sourcePath);
+    return true;
+}
+
+bool LoadQuestionBank(QuestionBank *bank, const char *sourcePath, const char *packPath) {
+    return LoadBank(bank, sourcePath, packPath, true);
+}
+
+bool ReloadQuestionBank(QuestionBank *bank, const char *sourcePath, const char *packPath) {
+    return LoadBank(bank, sourcePath, packPath, false);
+}
+
+bool ReadQuestionSource(const char *path, QuestionSource *source) {
+    memset(source, 0, sizeof(*source));
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return false;
+    // Tamanho e data do arquivo aberto, e não de um stat pelo caminho: se o JSON for
+    // trocado durante a leitura, a identificação continua sendo a do conteúdo lido.
+    struct stat info;
+    char *data = NULL;
+    if (fstat(FILE_DESCRIPTOR(file), &info) == 0 && info.st_size >= 0) {
+        size_t length = (size_t)info.st_size;
+        data = malloc(length + 1);
+        if (data != NULL && fread(data, 1, length, file) != length) {
+            free(data);
+            data = NULL;
+        }
+        if (data != NULL) {
+            data[length] = '\0';
+            *source = (QuestionSource){ data, length, (long long)info.st_mtime };
+        }
+    }
+    fclose(file);
+    return data != NULL;
+}
+
+void FreeQuestionSource(QuestionSource *source) {
+    free(source->json);
+    memset(source, 0, sizeof(*source));
+}
+
+bool GetQuestionBankPaths(const char *locale, char *sourcePath, char *packPath, size_t pathSize) {
+    size_t length = (locale != NULL) ? strlen(locale) : 0;
+    if (length == 0 || length > 8) return false;
+    for (size_t i = 0; i < length; i++) {
+        char c = locale[i];
+        bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+        if (!valid) return false;   // o código vira parte de um caminho
+    }
+    if (strcmp(locale, QUESTION_LOCALE_DEFAULT) == 0) {
+        snprintf(sourcePath, pathSize, "%s", QUESTION_BANK_SOURCE);
+        snprintf(packPath, pathSize, "%s", QUESTION_BANK_PACK);
+    } else {
+        snprintf(sourcePath, pathSize, "resources/questions.%s.json", locale);
+        snprintf(packPath, pathSize, "resources/questions.%s.qpk", locale);
+    }
+    return true;
+}
+
+void UnloadQuestionBank(QuestionBank *bank) {
+    UnmapFile(&bank->file);
+    free(bank->image);
+    memset(bank, 0, sizeof(*bank));
+}
+
+Question GetBankQuestion(const QuestionBank *bank, int index) {
+    const PackRecord *record = (const PackRecord *)bank->records + index;
+    Question question;
+    // Deslocamento fora da tabela (pack corrompido) vira texto vazio em vez de leitura inválida.
+    question.questionText = (record->text < bank->stringsSize) ? bank->strings + record->text : "";
+    for (int o = 0; o < OPTION_COUNT; o++) {
+        question.options[o] = (record->options[o] < bank->stringsSize) ? bank->strings + record->options[o] : "";
+    }
+    question.correctOption = (record->correctOption < OPTION_COUNT) ? record->correctOption : 0;
+    question.difficulty = (record->difficulty <= HARD) ? (Difficulty)record->difficulty : EASY;
+    question.points = record->points;
+    question.id = (int)record->id;
+    return question;
+}
+
+float GetBankRating(const QuestionBank *bank, int index) {
+    return ((const PackRecord *)bank->records)[index].rating;
+}
+
+const char *GetBankImage(const QuestionBank *bank, int index) {
+    uint32_t image = ((const PackRecord *)bank->records)[index].image;
+    return (image < bank->stringsSize) ? bank->strings + image : NULL;
+}
+
+bool IsValidQuestionImagePath(const char *path) {
+    if (path == NULL || path[0] == '\0' || path[0] == '/' || path[0] == '\\' || strchr(path, ':') != NULL) return false;
+    if (strlen(path) >= QUESTION_BANK_PATH_SIZE - sizeof(QUESTION_IMAGE_DIR)) return false;
+    // Nenhum trecho do caminho pode ser "..".
+    for (const char *part = path; *part != '\0';) {
+        size_t length = strcspn(part, "/\\");
+        if (length == 2 && part[0] == '.' && part[1] == '.') return false;
+        part += length;
+        if (*part != '\0') part++;
+    }
+    return true;
+}
+
+const QuestionLayout *GetBankLayout(const QuestionBank *bank, int index) {
+    return (bank->layouts != NULL) ? &bank->layouts[index] : NULL;
+}
+
+bool FindBankTag(const QuestionBank *bank, QuestionTagKind kind, const char *name, QuestionPool pools[3]) {
+    const PackTag *tags = (const PackTag *)bank->tagEntries + ((kind == TAG_TOPIC) ? bank->tagCount[TAG_CATEGORY] : 0);
+    int low = 0, high = bank->tagCount[kind] - 1;
+    while (low <= high) {
+        int middle = low + (high - low) / 2;
+        const PackTag *tag = &tags[middle];
+        int order = (tag->name < bank->stringsSize) ? strcmp(name, bank->strings + tag->name) : -1;
+        if (order < 0) high = middle - 1;
+        else if (order > 0) low = middle + 1;
+        else {
+            for (int d = 0; d < DIFFICULTY_COUNT; d++) {
+                bool inside = tag->first[d] <= bank->tagIndexCount && tag->count[d] <= bank->tagIndexCount - tag->first[d];
+                pools[d] = (QuestionPool){ bank->tagIndices + (inside ? tag->first[d] : 0), 0, inside ? (int)tag->count[d] : 0 };
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+char *BuildQuestionPack(const Question *questions, const QuestionMeta *meta, int count, const QuestionLayoutSet *layoutSet,
+                        const QuestionSource *source, size_t *packSize) {
+    size_t stringsBytes = 0;
+    uint32_t difficultyCount[DIFFICULTY_COUNT] = { 0 };
+    for (int q = 0; q < count; q++) {
+        stringsBytes += strlen(questions[q].questionText) + 1;
+        for (int i = 0; i < OPTION_COUNT; i++) stringsBytes += strlen(questions[q].options[i]) + 1;
+        if (meta != NULL && meta[q].category != NULL) stringsBytes += strlen(meta[q].category) + 1;
+        if (meta != NULL && meta[q].topic != NULL) stringsBytes += strlen(meta[q].topic) + 1;
+        if (meta != NULL && meta[q].image != NULL) stringsBytes += strlen(meta[q].image) + 1;
+        difficultyCount[questions[q].difficulty]++;
+    }
+    if (count <= 0 || stringsBytes > UINT32_MAX) return NULL;
+
+    StringTable table;
+    if (!InitStringTable(&table, stringsBytes, (size_t)count * (OPTION_COUNT + 4))) {
+        FreeStringTable(&table);
+        return NULL;
+    }
+    bool withLayouts = layoutSet != NULL && layoutSet->layouts != NULL;
+    size_t layoutsSize = withLayouts ? (size_t)count * sizeof(QuestionLayout) : 0;
+    PackRecord *records = malloc((size_t)count * sizeof(PackRecord));
+    QuestionLayout *layouts = withLayouts ? malloc(layoutsSize) : NULL;
+    TagRef *refs[2] = { malloc((size_t)count * sizeof(TagRef)), malloc((size_t)count * sizeof(TagRef)) };
+    PackTag *packTags = malloc((size_t)count * 2 * sizeof(PackTag));
+    uint32_t *tagIndices = malloc((size_t)count * 2 * sizeof(uint32_t));
+    QuestionRating *ratings = malloc((size_t)count * sizeof(QuestionRating));
+    if (records == NULL || (withLayouts && layouts == NULL) || refs[0] == NULL || refs[1] == NULL || packTags == NULL || tagIndices == NULL
+        || ratings == NULL) {
+        free(records);
+        free(ratings);
+        free(layouts);
+        free(refs[0]);
+        free(refs[1]);
+        free(packTags);
+        free(tagIndices);
+        FreeStringTable(&table);
+        return NULL;
+    }
+    size_t refCount[2] = { 0, 0 };
+
+    // Agrupa por dificuldade, mantendo a ordem do fonte dentro de cada grupo.
+    // Os textos são deduplicados antes de se saber o tamanho final da tabela.
+    int r = 0;
+    for (int d = EASY; d <= HARD; d++) {
+        for (int q = 0; q < count; q++) {
+            if (questions[q].difficulty != (Difficulty)d) continue;
+            PackRecord *record = &records[r];
+            record->id = (uint32_t)questions[q].id;
+            record->text = InternString(&table, questions[q].questionText);
+            for (int i = 0; i < OPTION_COUNT; i++) record->options[i] = InternString(&table, questions[q].options[i]);
+            record->correctOption = (uint8_t)questions[q].correctOption;
+            record->difficulty = (uint8_t)d;
+            record->points = (uint16_t)questions[q].points;
+            record->rating = (meta != NULL && meta[q].rating > 0.0f) ? meta[q].rating : defaultRatings[d];
+            record->image = (meta != NULL && meta[q].image != NULL) ? InternString(&table, meta[q].image) : PACK_NO_TEXT;
+            ratings[r] = (QuestionRating){ record->rating, (uint32_t)r };
+            if (withLayouts) layouts[r] = layoutSet->layouts[q];
+            if (meta != NULL && meta[q].category != NULL) refs[TAG_CATEGORY][refCount[TAG_CATEGORY]++] = (TagRef){ meta[q].category, (uint32_t)r };
+            if (meta != NULL && meta[q].topic != NULL) refs[TAG_TOPIC][refCount[TAG_TOPIC]++] = (TagRef){ meta[q].topic, (uint32_t)r };
+            r++;
+        }
+    }
+
+    qsort(ratings, (size_t)count, sizeof(QuestionRating), CompareRatings);
+
+    uint32_t tagCount[2], tagIndexCount = 0;
+    tagCount[TAG_CATEGORY] = BuildTagIndex(refs[TAG_CATEGORY], refCount[TAG_CATEGORY], records, &table, packTags, tagIndices, &tagIndexCount);
+    tagCount[TAG_TOPIC] = BuildTagIndex(refs[TAG_TOPIC], refCount[TAG_TOPIC], records, &table, packTags + tagCount[TAG_CATEGORY], tagIndices, &tagIndexCount);
+    size_t tagsSize = (tagCount[TAG_CATEGORY] + tagCount[TAG_TOPIC]) * sizeof(PackTag);
+    size_t tagIndicesSize = tagIndexCount * sizeof(uint32_t);
+
+    size_t recordsSize = (size_t)count * sizeof(PackRecord);
+    size_t ratingsSize = (size_t)count * sizeof(QuestionRating);
+    size_t size = sizeof(PackHeader) + recordsSize + ratingsSize + layoutsSize + tagsSize + tagIndicesSize + table.used;
+    char *pack = calloc(1, size);
+    if (pack != NULL) {
+        PackHeader *header = (PackHeader *)pack;
+        memcpy(header->magic, PACK_MAGIC, sizeof(header->magic));
+        header->version = PACK_VERSION;
+        header->questionCount = (uint32_t)count;
+        header->stringsSize = (uint32_t)table.used;
+        memcpy(header->difficultyCount, difficultyCount, sizeof(difficultyCount));
+        if (withLayouts) {
+            header->layoutFontBaseSize = (uint32_t)layoutSet->fontBaseSize;
+            header->layoutFontHash = layoutSet->fontHash;
+            for (int i = 0; i < LAYOUT_STYLE_COUNT; i++) {
+                header->layoutStyles[i][0] = layoutSet->styles[i].fontSize;
+                header->layoutStyles[i][1] = layoutSet->styles[i].spacing;
+                header->layoutStyles[i][2] = layoutSet->styles[i].width;
+            }
+        }
+        header->tagCount[TAG_CATEGORY] = tagCount[TAG_CATEGORY];
+        header->tagCount[TAG_TOPIC] = tagCount[TAG_TOPIC];
+        header->tagIndexCount = tagIndexCount;
+        if (source != NULL) {
+            header->sourceSize = (uint64_t)source->size;
+            header->sourceModified = (int64_t)source->modified;
+            header->sourceHash = HashBytes(source->json, source->size);
+        }
+        char *section = pack + sizeof(PackHeader);
+        memcpy(section, records, recordsSize);
+        section += recordsSize;
+        memcpy(section, ratings, ratingsSize);
+        section += ratingsSize;
+        if (withLayouts) memcpy(section, layouts, layoutsSize);
+        section += layoutsSize;
+        if (tagsSize > 0) memcpy(section, packTags, tagsSize);
+        section += tagsSize;
+        if (tagIndicesSize > 0) memcpy(section, tagIndices, tagIndicesSize);
+        section += tagIndicesSize;
+        memcpy(section, table.data, table.used);
+        *packSize = size;
+        fprintf(stderr, "[QuestionBank] Textos: %zu bytes, %zu após remover repetições.\n", stringsBytes, table.used);
+    }
+    free(records);
+    free(ratings);
+    free(layouts);
+    free(refs[0]);
+    free(refs[1]);
+    free(packTags);
+    free(tagIndices);
+    FreeStringTable(&table);
+    return pack;
+}
+
+bool WriteQuestionPack(const char *packPath, const char *pack, size_t packSize) {
+    char tempPath[512];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", packPath);
+    FILE *file = fopen(tempPath, "wb");
+    if (file == NULL) return false;
+    bool written = fwrite(pack, 1, packSize, file) == packSize;
+    written = (fclose(file) == 0) && written;
+    if (written) remove(packPath); // rename não sobrescreve no Windows
+    if (!written || rename(tempPath, packPath) != 0) {
+        remove(tempPath);
+        return false;
+    }
+    return true;
+}
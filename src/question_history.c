@@ -0,0 +1,135 @@
+/**
+ * @file question_history.c
+ * @author Grupo 1
+ * @brief Implementação do histórico das perguntas sorteadas recentemente.
+ * @version 1.3
+ * @copyright Copyright (c) 2025
+ *
+ * Formato do arquivo (ordem de bytes da máquina): HistoryHeader seguido de 'count'
+ * pares (posição no banco, id), do mais antigo para o mais novo. Gravar a posição
+ * permite restaurar o bitset sem procurar o id no banco; o id confirma que a posição
+ * ainda é da mesma pergunta. Se não for (banco editado ou recarregado), a pergunta é
+ * procurada pelo id.
+ */
+
+#include "raylib/question_history.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+//---------------------------------------------
+// Definições e Constantes (Privadas ao Módulo)
+//---------------------------------------------
+#define HISTORY_MAGIC "QHST"
+#define HISTORY_VERSION 1
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t count;
+} HistoryHeader;
+
+//---------------------------------------------
+// Implementação das Funções Públicas
+//---------------------------------------------
+
+bool InitQuestionHistory(QuestionHistory *history, int questionCount, int window) {
+    memset(history, 0, sizeof(*history));
+    if (window > QUESTION_HISTORY_MAX_WINDOW) window = QUESTION_HISTORY_MAX_WINDOW;
+    if (questionCount <= 0 || window <= 0) return false;
+    history->recent = calloc(((size_t)questionCount + 7) / 8, 1);
+    history->ring = malloc((size_t)window * sizeof(int));
+    history->ids = malloc((size_t)window * sizeof(int));
+    if (history->recent == NULL || history->ring == NULL || history->ids == NULL) {
+        FreeQuestionHistory(history);
+        return false;
+    }
+    history->capacity = window;
+    history->questionCount = questionCount;
+    return true;
+}
+
+void FreeQuestionHistory(QuestionHistory *history) {
+    free(history->recent);
+    free(history->ring);
+    free(history->ids);
+    memset(history, 0, sizeof(*history));
+}
+
+bool IsRecentQuestion(const QuestionHistory *history, int index) {
+    if (history->recent == NULL || index < 0 || index >= history->questionCount) return false;
+    return (history->recent[index >> 3] >> (index & 7)) & 1;
+}
+
+void MarkQuestionServed(QuestionHistory *history, int index, int id) {
+    // Uma pergunta que já está na janela não entra de novo: assim cada posição do buffer
+    // é única e apagar o bit da mais antiga nunca apaga o de uma repetida.
+    if (history->capacity == 0 || index < 0 || index >= history->questionCount || IsRecentQuestion(history, index)) return;
+    int slot = (history->head + history->size) % history->capacity;
+    if (history->size == history->capacity) {
+        int oldest = history->ring[history->head];
+        history->recent[oldest >> 3] &= (unsigned char)~(1u << (oldest & 7));
+        history->head = (history->head + 1) % history->capacity;
+    } else {
+        history->size++;
+    }
+    history->ring[slot] = index;
+    history->ids[slot] = id;
+    history->recent[index >> 3] |= (unsigned char)(1u << (index & 7));
+}
+
+void LoadQuestionHistory(QuestionHistory *history, const char *path, int (*findQuestion)(uint32_t position, uint32_t id)) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return;
+    HistoryHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || memcmp(header.magic, HISTORY_MAGIC, sizeof(header.magic)) != 0
+        || header.version != HISTORY_VERSION) {
+        fprintf(stderr, "[QuestionHistory] Aviso: '%s' inválido, histórico ignorado.\n", path);
+        fclose(file);
+        return;
+    }
+    // Se a janela diminuiu, só as entradas mais novas cabem.
+    uint32_t skip = (header.count > (uint32_t)history->capacity) ? header.count - (uint32_t)history->capacity : 0;
+    int restored = 0, dropped = 0;
+    uint32_t entry[2];
+    for (uint32_t i = 0; i < header.count && fread(entry, sizeof(entry), 1, file) == 1; i++) {
+        if (i < skip) continue;
+        int index = findQuestion(entry[0], entry[1]);
+        if (index >= 0 && index < history->questionCount) {
+            MarkQuestionServed(history, index, (int)entry[1]);
+            restored++;
+        } else {
+            dropped++;
+        }
+    }
+    fclose(file);
+    fprintf(stderr, "[QuestionHistory] %d perguntas recentes restauradas", restored);
+    if (dropped > 0) fprintf(stderr, " (%d não existem mais no banco)", dropped);
+    fprintf(stderr, ".\n");
+}
+
+bool SaveQuestionHistory(const QuestionHistory *history, const char *path) {
+    char tempPath[512];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", path);
+    FILE *file = fopen(tempPath, "wb");
+    if (file == NULL) return false;
+
+    HistoryHeader header;
+    memcpy(header.magic, HISTORY_MAGIC, sizeof(header.magic));
+    header.version = HISTORY_VERSION;
+    header.count = (uint32_t)history->size;
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int i = 0; i < history->size && written; i++) {
+        int slot = (history->head + i) % history->capacity;
+        uint32_t entry[2] = { (uint32_t)history->ring[slot], (uint32_t)history->ids[slot] };
+        written = fwrite(entry, sizeof(entry), 1, file) == 1;
+    }
+    written = (fclose(file) == 0) && written;
+    if (written) remove(path); // rename não sobrescreve no Windows
+    if (!written || rename(tempPath, path) != 0) {
+        remove(tempPath);
+        return false;
+    }
+    return true;
+}
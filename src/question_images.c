@@ -0,0 +1,217 @@
+/**
+ * @file question_images.c
+ * @author Grupo 1
+ * @brief Implementação das imagens das perguntas (carga em segundo plano e cache).
+ * @version 1.0
+ * @copyright Copyright (c) 2025
+ *
+ * Cada posição do cache passa por: decodificando (a tarefa está com a thread), enviando
+ * (a imagem está em RAM e a textura recebe uma faixa de linhas por frame), pronta ou
+ * falhou. Uma posição decodificando nunca sai do cache, porque a thread ainda vai
+ * devolvê-la; fora isso, sai a de uso mais antigo, desde que não tenha sido usada no
+ * frame atual ou no anterior (a pergunta na tela e a próxima não se expulsam).
+ *
+ * A decodificação usa só funções de imagem da raylib (CPU), que podem rodar fora da
+ * thread principal; tudo que toca a GPU fica em UpdateQuestionImages.
+ */
+
+#include "raylib/question_images.h"
+#include "raylib/question_bank.h"
+#include "raylib/background_worker.h"
+#include "raylib/rlgl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//---------------------------------------------
+// Definições e Constantes (Privadas ao Módulo)
+//---------------------------------------------
+
+typedef enum {
+    IMAGE_EMPTY,
+    IMAGE_DECODING,
+    IMAGE_UPLOADING,
+    IMAGE_READY,
+    IMAGE_FAILED
+} ImageState;
+
+typedef struct {
+    char path[QUESTION_BANK_PATH_SIZE];     // relativo a QUESTION_IMAGE_DIR; chave do cache
+    ImageState state;
+    Image image;            // RGBA, enquanto IMAGE_UPLOADING
+    Texture2D texture;
+    int uploadedRows;
+    unsigned long lastUsed; // frame do último pedido
+} CachedImage;
+
+typedef struct {
+    int slot;
+    char path[QUESTION_BANK_PATH_SIZE];     // caminho completo
+    Image image;            // data NULL se a carga falhou
+} DecodeJob;
+
+static CachedImage cache[QUESTION_IMAGE_CACHE_SIZE];
+static BackgroundWorker decoder = { 0 };
+static unsigned long frame = 0;
+
+//---------------------------------------------
+// Funções Privadas
+//---------------------------------------------
+
+// Roda na thread: lê, reduz para QUESTION_IMAGE_MAX_SIZE e converte para RGBA.
+static void DecodeImage(void *argument) {
+    DecodeJob *job = argument;
+    Image image = LoadImage(job->path);
+    if (image.data != NULL && (image.width > QUESTION_IMAGE_MAX_SIZE || image.height > QUESTION_IMAGE_MAX_SIZE)) {
+        float scale = (float)QUESTION_IMAGE_MAX_SIZE / (float)((image.width > image.height) ? image.width : image.height);
+        int width = (int)(image.width * scale), height = (int)(image.height * scale);
+        ImageResize(&image, (width > 0) ? width : 1, (height > 0) ? height : 1);
+    }
+    if (image.data != NULL) ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    if (image.data != NULL && image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8) {
+        UnloadImage(image);     // formato comprimido: não há como enviar por faixas
+        image = (Image){ 0 };
+    }
+    job->image = image;
+}
+
+static void DiscardDecodeJob(void *argument) {
+    DecodeJob *job = argument;
+    if (job->image.data != NULL) UnloadImage(job->image);
+    free(job);
+}
+
+static void ReleaseSlot(CachedImage *entry) {
+    if (entry->image.data != NULL) UnloadImage(entry->image);
+    if (entry->texture.id != 0) UnloadTexture(entry->texture);
+    memset(entry, 0, sizeof(*entry));
+}
+
+static CachedImage *FindImage(const char *path) {
+    for (int i = 0; i < QUESTION_IMAGE_CACHE_SIZE; i++) {
+        if (cache[i].state != IMAGE_EMPTY && strcmp(cache[i].path, path) == 0) return &cache[i];
+    }
+    return NULL;
+}
+
+// Posição livre, ou a de uso mais antigo que possa sair. NULL se todas estiverem ocupadas.
+static CachedImage *ClaimSlot(void) {
+    CachedImage *oldest = NULL;
+    for (int i = 0; i < QUESTION_IMAGE_CACHE_SIZE; i++) {
+        CachedImage *entry = &cache[i];
+        if (entry->state == IMAGE_EMPTY) return entry;
+        if (entry->state == IMAGE_DECODING || entry->lastUsed + 1 >= frame) continue;
+        if (oldest == NULL || entry->lastUsed < oldest->lastUsed) oldest = entry;
+    }
+    if (oldest != NULL) ReleaseSlot(oldest);
+    return oldest;
+}
+
+// Acha a imagem no cache ou a põe na fila da thread; marca o uso neste frame.
+static CachedImage *TouchImage(const char *path) {
+    if (path == NULL || strlen(path) >= QUESTION_BANK_PATH_SIZE) return NULL;
+    CachedImage *entry = FindImage(path);
+    if (entry == NULL) {
+        if (decoder.state == NULL || (entry = ClaimSlot()) == NULL) return NULL;
+        DecodeJob *job = calloc(1, sizeof(DecodeJob));
+        if (job == NULL) return NULL;
+        job->slot = (int)(entry - cache);
+        snprintf(job->path, sizeof(job->path), "%s%s", QUESTION_IMAGE_DIR, path);
+        if (!SubmitBackgroundJob(&decoder, job)) {
+            free(job);
+            return NULL;
+        }
+        snprintf(entry->path, sizeof(entry->path), "%s", path);
+        entry->state = IMAGE_DECODING;
+    }
+    entry->lastUsed = frame;
+    return entry;
+}
+
+static void FinishDecode(DecodeJob *job) {
+    CachedImage *entry = &cache[job->slot];
+    if (job->image.data == NULL) {
+        fprintf(stderr, "[QuestionImages] Aviso: não foi possível carregar '%s'.\n", job->path);
+        entry->state = IMAGE_FAILED;
+    } else {
+        entry->image = job->image;
+        entry->uploadedRows = 0;
+        entry->state = IMAGE_UPLOADING;
+    }
+    free(job);
+}
+
+// Envia até 'budget' bytes de linhas da imagem; retorna quantos bytes enviou.
+static int UploadRows(CachedImage *entry, int budget) {
+    Image *image = &entry->image;
+    int rowBytes = GetPixelDataSize(image->width, 1, image->format);
+    if (entry->texture.id == 0) {
+        // Só reserva a textura; as linhas chegam aos poucos por UpdateTextureRec.
+        unsigned int id = rlLoadTexture(NULL, image->width, image->height, image->format, 1);
+        if (id == 0) {
+            UnloadImage(*image);
+            *image = (Image){ 0 };
+            entry->state = IMAGE_FAILED;
+            return 0;
+        }
+        entry->texture = (Texture2D){ id, image->width, image->height, 1, image->format };
+        SetTextureFilter(entry->texture, TEXTURE_FILTER_BILINEAR);
+    }
+    int rows = budget / rowBytes;
+    if (rows > image->height - entry->uploadedRows) rows = image->height - entry->uploadedRows;
+    if (rows <= 0) return 0;
+    Rectangle band = { 0.0f, (float)entry->uploadedRows, (float)image->width, (float)rows };
+    UpdateTextureRec(entry->texture, band, (const unsigned char *)image->data + (size_t)entry->uploadedRows * rowBytes);
+    entry->uploadedRows += rows;
+    if (entry->uploadedRows == image->height) {
+        UnloadImage(*image);
+        *image = (Image){ 0 };
+        entry->state = IMAGE_READY;
+    }
+    return rows * rowBytes;
+}
+
+//---------------------------------------------
+// Implementação das Funções Públicas
+//---------------------------------------------
+
+void InitQuestionImages(void) {
+    memset(cache, 0, sizeof(cache));
+    frame = 0;
+    if (!StartBackgroundWorker(&decoder, DecodeImage)) {
+        fprintf(stderr, "[QuestionImages] Aviso: sem thread de decodificação; as perguntas ficam sem imagem.\n");
+    }
+}
+
+void UnloadQuestionImages(void) {
+    StopBackgroundWorker(&decoder, DiscardDecodeJob);
+    for (int i = 0; i < QUESTION_IMAGE_CACHE_SIZE; i++) ReleaseSlot(&cache[i]);
+}
+
+void UpdateQuestionImages(void) {
+    frame++;
+    void *job;
+    while (TakeFinishedBackgroundJob(&decoder, &job)) FinishDecode(job);
+
+    // A imagem pedida por último (a da tela) vai primeiro.
+    int budget = QUESTION_IMAGE_UPLOAD_BYTES;
+    while (budget > 0) {
+        CachedImage *next = NULL;
+        for (int i = 0; i < QUESTION_IMAGE_CACHE_SIZE; i++) {
+            if (cache[i].state == IMAGE_UPLOADING && (next == NULL || cache[i].lastUsed > next->lastUsed)) next = &cache[i];
+        }
+        if (next == NULL) break;
+        int sent = UploadRows(next, budget);
+        if (sent == 0 && next->state == IMAGE_UPLOADING) break;    // nem uma linha cabe no que sobrou
+        budget -= sent;
+    }
+}
+
+const Texture2D *RequestQuestionImage(const char *path) {
+    CachedImage *entry = TouchImage(path);
+    return (entry != NULL && entry->state == IMAGE_READY) ? &entry->texture : NULL;
+}
+
+void PrefetchQuestionImage(const char *path) {
+    TouchImage(path);
+}
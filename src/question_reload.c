@@ -0,0 +1,320 @@
+/**
+ * @file question_reload.c
+ * @author Grupo 1
+ * @brief Implementação da recarga do Banco de Questões com o jogo aberto.
+ * @version 1.3
+ * @copyright Copyright (c) 2025
+ *
+ * A thread só entrega bancos completos: a carga do banco roda inteira nela (leitura,
+ * validação pela tape do cJSON, montagem e gravação do pack) e o resultado é passado ao
+ * jogo sob a trava. Um JSON com erro é descartado e o banco atual continua valendo.
+ *
+ * No Windows o pack em uso não pode ser apagado enquanto está mapeado; a gravação do
+ * pack novo falha e o banco recarregado fica em memória até o jogo ser reiniciado.
+ */
+
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "raylib/question_reload.h"
+#include <pthread.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#if defined(__linux__)
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+//---------------------------------------------
+// Definições e Constantes (Privadas ao Módulo)
+//---------------------------------------------
+#define RELOAD_POLL_MS 1000     // intervalo do stat quando não há inotify
+#define RELOAD_SETTLE_MS 300    // tempo sem mudanças antes de recarregar: editores gravam em partes
+
+typedef struct {
+    bool exists;
+    long long size;
+    long long modified;
+} SourceStamp;
+
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool stopping;
+    bool ready;                 // 'pending' tem um banco que o jogo ainda não pegou
+    QuestionBank pending;
+    bool retarget;              // o jogo pediu outro banco: 'nextSourcePath' e 'nextPackPath'
+    bool retargetLoad;          // ... e quer que ele seja carregado na hora
+    bool retargetFailed;        // o banco pedido não carregou; o jogo ainda não soube
+    char nextSourcePath[QUESTION_BANK_PATH_SIZE];
+    char nextPackPath[QUESTION_BANK_PATH_SIZE];
+    // Daqui para baixo, só a thread mexe depois de iniciada.
+    SourceStamp seen;
+    int notifyFd;               // -1 sem inotify
+    char sourcePath[QUESTION_BANK_PATH_SIZE];
+    char packPath[QUESTION_BANK_PATH_SIZE];
+    const char *sourceName;     // nome do JSON dentro de 'sourcePath'
+} ReloadWorker;
+
+//---------------------------------------------
+// Funções Privadas
+//---------------------------------------------
+static SourceStamp ReadStamp(const char *path) {
+    struct stat info;
+    SourceStamp stamp = { false, 0, 0 };
+    if (stat(path, &info) == 0) stamp = (SourceStamp){ true, (long long)info.st_size, (long long)info.st_mtime };
+    return stamp;
+}
+
+static bool SameStamp(SourceStamp a, SourceStamp b) {
+    return a.exists == b.exists && a.size == b.size && a.modified == b.modified;
+}
+
+static bool IsStopping(ReloadWorker *worker) {
+    pthread_mutex_lock(&worker->lock);
+    bool stopping = worker->stopping;
+    pthread_mutex_unlock(&worker->lock);
+    return stopping;
+}
+
+static void SetSourcePath(ReloadWorker *worker, const char *sourcePath, const char *packPath) {
+    snprintf(worker->sourcePath, sizeof(worker->sourcePath), "%s", sourcePath);
+    snprintf(worker->packPath, sizeof(worker->packPath), "%s", packPath);
+    const char *slash = strrchr(worker->sourcePath, '/');
+#if defined(_WIN32)
+    const char *backslash = strrchr(worker->sourcePath, '\\');
+    if (backslash != NULL && (slash == NULL || backslash > slash)) slash = backslash;
+#endif
+    worker->sourceName = (slash != NULL) ? slash + 1 : worker->sourcePath;
+    worker->seen = ReadStamp(worker->sourcePath);
+}
+
+// Observa o diretório do JSON, e não o arquivo: editores que salvam em um temporário e
+// renomeiam trocam o arquivo, e uma observação no arquivo antigo se perderia.
+static int OpenNotify(const ReloadWorker *worker) {
+#if defined(__linux__)
+    char directory[sizeof(worker->sourcePath)];
+    size_t length = (size_t)(worker->sourceName - worker->sourcePath);
+    if (length == 0) snprintf(directory, sizeof(directory), ".");
+    else snprintf(directory, sizeof(directory), "%.*s", (int)length, worker->sourcePath);
+
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) return -1;
+    if (inotify_add_watch(fd, directory, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+#else
+    (void)worker;
+    return -1;
+#endif
+}
+
+// Espera até 'timeoutMs' ou até a parada. Retorna true se o inotify avisou de uma
+// gravação no JSON; sem inotify, só espera (a mudança é vista pelo stat).
+static bool WaitForChange(ReloadWorker *worker, int timeoutMs) {
+#if defined(__linux__)
+    if (worker->notifyFd >= 0) {
+        struct pollfd descriptor = { worker->notifyFd, POLLIN, 0 };
+        if (poll(&descriptor, 1, timeoutMs) <= 0) return false;
+        union {
+            struct inotify_event event;     // alinha o buffer para os eventos
+            char bytes[4096];
+        } buffer;
+        bool matched = false;
+        ssize_t length;
+        while ((length = read(worker->notifyFd, buffer.bytes, sizeof(buffer.bytes))) > 0) {
+            for (ssize_t offset = 0; offset < length;) {
+                const struct inotify_event *event = (const struct inotify_event *)(buffer.bytes + offset);
+                if (event->len > 0 && strcmp(event->name, worker->sourceName) == 0) matched = true;
+                offset += (ssize_t)(sizeof(struct inotify_event) + event->len);
+            }
+        }
+        return matched;
+    }
+#endif
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeoutMs / 1000;
+    deadline.tv_nsec += (long)(timeoutMs % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    pthread_mutex_lock(&worker->lock);
+    while (!worker->stopping && pthread_cond_timedwait(&worker->wake, &worker->lock, &deadline) != ETIMEDOUT) {}
+    pthread_mutex_unlock(&worker->lock);
+    return false;
+}
+
+static void CloseNotify(ReloadWorker *worker) {
+#if defined(__linux__)
+    if (worker->notifyFd >= 0) close(worker->notifyFd);
+#endif
+    worker->notifyFd = -1;
+}
+
+// Troca o banco observado se o jogo pediu; retorna true se trocou. 'load' diz se o banco
+// novo deve ser carregado já.
+static bool TakeRetarget(ReloadWorker *worker, bool *load) {
+    pthread_mutex_lock(&worker->lock);
+    bool retarget = worker->retarget;
+    if (retarget) {
+        SetSourcePath(worker, worker->nextSourcePath, worker->nextPackPath);
+        *load = worker->retargetLoad;
+        worker->retarget = false;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    if (retarget) {
+        CloseNotify(worker);    // o JSON novo pode estar em outro diretório
+        worker->notifyFd = OpenNotify(worker);
+    }
+    return retarget;
+}
+
+// 'retargeted': o banco foi pedido por RetargetQuestionReloader, e o jogo precisa saber se falhar.
+// Se outro banco foi pedido durante a carga, o resultado já não interessa. A recarga por
+// mudança no arquivo não confia na data do JSON, que acabou de ser gravado.
+static void ReloadBank(ReloadWorker *worker, bool retargeted) {
+    QuestionBank reloaded;
+    bool loaded = retargeted ? LoadQuestionBank(&reloaded, worker->sourcePath, worker->packPath)
+                             : ReloadQuestionBank(&reloaded, worker->sourcePath, worker->packPath);
+    if (!loaded) fprintf(stderr, "[QuestionReload] Aviso: recarga falhou; o banco atual continua em uso.\n");
+    pthread_mutex_lock(&worker->lock);
+    if (worker->retarget) {
+        if (loaded) UnloadQuestionBank(&reloaded);
+    } else if (!loaded) {
+        if (retargeted) worker->retargetFailed = true;
+    } else {
+        if (worker->ready) UnloadQuestionBank(&worker->pending);    // mudou de novo antes de o jogo pegar
+        worker->pending = reloaded;
+        worker->ready = true;
+    }
+    pthread_mutex_unlock(&worker->lock);
+}
+
+// Uma mudança só é recarregada depois que o JSON passa um intervalo inteiro sem mudar,
+// para não ler um arquivo pela metade nem montar um pack por gravação.
+static void *ReloadThread(void *argument) {
+    ReloadWorker *worker = argument;
+    bool settling = false;
+    while (!IsStopping(worker)) {
+        bool notified = WaitForChange(worker, (worker->notifyFd >= 0) ? RELOAD_SETTLE_MS : RELOAD_POLL_MS);
+        bool load = false;
+        if (TakeRetarget(worker, &load)) {
+            settling = false;
+            if (load) {
+                fprintf(stderr, "[QuestionReload] Carregando '%s'.\n", worker->sourcePath);
+                ReloadBank(worker, true);
+            }
+            continue;
+        }
+        if (worker->notifyFd >= 0 && !notified && !settling) continue;  // nada mudou; evita o stat
+
+        SourceStamp now = ReadStamp(worker->sourcePath);
+        if (notified || !SameStamp(now, worker->seen)) {
+            worker->seen = now;
+            settling = true;
+        } else if (settling) {
+            settling = false;
+            if (now.exists && !IsStopping(worker)) {
+                fprintf(stderr, "[QuestionReload] '%s' mudou; recarregando o banco.\n", worker->sourcePath);
+                ReloadBank(worker, false);
+            }
+        }
+    }
+    return NULL;
+}
+
+//---------------------------------------------
+// Implementação das Funções Públicas
+//---------------------------------------------
+
+bool StartQuestionReloader(QuestionReloader *reloader, const char *sourcePath, const char *packPath) {
+    reloader->worker = NULL;
+    ReloadWorker *worker = calloc(1, sizeof(ReloadWorker));
+    if (worker == NULL) return false;
+    SetSourcePath(worker, sourcePath, packPath);
+    worker->notifyFd = OpenNotify(worker);
+
+    if (pthread_mutex_init(&worker->lock, NULL) != 0) {
+        free(worker);
+        return false;
+    }
+    pthread_cond_init(&worker->wake, NULL);
+    if (pthread_create(&worker->thread, NULL, ReloadThread, worker) != 0) {
+        fprintf(stderr, "[QuestionReload] Aviso: thread não iniciada; o banco só muda reiniciando o jogo.\n");
+        CloseNotify(worker);
+        pthread_cond_destroy(&worker->wake);
+        pthread_mutex_destroy(&worker->lock);
+        free(worker);
+        return false;
+    }
+    reloader->worker = worker;
+    fprintf(stderr, "[QuestionReload] Observando '%s' (%s).\n", sourcePath, (worker->notifyFd >= 0) ? "inotify" : "stat a cada segundo");
+    return true;
+}
+
+void StopQuestionReloader(QuestionReloader *reloader) {
+    ReloadWorker *worker = reloader->worker;
+    if (worker == NULL) return;
+    pthread_mutex_lock(&worker->lock);
+    worker->stopping = true;
+    pthread_cond_signal(&worker->wake);
+    pthread_mutex_unlock(&worker->lock);
+    pthread_join(worker->thread, NULL);
+    CloseNotify(worker);
+    if (worker->ready) UnloadQuestionBank(&worker->pending);
+    pthread_cond_destroy(&worker->wake);
+    pthread_mutex_destroy(&worker->lock);
+    free(worker);
+    reloader->worker = NULL;
+}
+
+bool RetargetQuestionReloader(QuestionReloader *reloader, const char *sourcePath, const char *packPath, bool load) {
+    ReloadWorker *worker = reloader->worker;
+    if (worker == NULL) return false;
+    pthread_mutex_lock(&worker->lock);
+    snprintf(worker->nextSourcePath, sizeof(worker->nextSourcePath), "%s", sourcePath);
+    snprintf(worker->nextPackPath, sizeof(worker->nextPackPath), "%s", packPath);
+    worker->retarget = true;
+    worker->retargetLoad = load;
+    worker->retargetFailed = false;
+    if (worker->ready) UnloadQuestionBank(&worker->pending);    // recarga do banco antigo, que já não vale
+    worker->ready = false;
+    pthread_cond_signal(&worker->wake);
+    pthread_mutex_unlock(&worker->lock);
+    return true;
+}
+
+bool TakeFailedQuestionReload(QuestionReloader *reloader) {
+    ReloadWorker *worker = reloader->worker;
+    if (worker == NULL) return false;
+    pthread_mutex_lock(&worker->lock);
+    bool failed = worker->retargetFailed;
+    worker->retargetFailed = false;
+    pthread_mutex_unlock(&worker->lock);
+    return failed;
+}
+
+bool TakeReloadedQuestionBank(QuestionReloader *reloader, QuestionBank *bank) {
+    ReloadWorker *worker = reloader->worker;
+    if (worker == NULL) return false;
+    pthread_mutex_lock(&worker->lock);
+    bool ready = worker->ready;
+    if (ready) {
+        *bank = worker->pending;
+        memset(&worker->pending, 0, sizeof(worker->pending));
+        worker->ready = false;
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return ready;
+}
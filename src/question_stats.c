@@ -0,0 +1,257 @@
+/**
+ * @file question_stats.c
+ * @author Grupo 1
+ * @brief Implementação das estatísticas de respostas por pergunta.
+ * @version 1.1
+ * @copyright Copyright (c) 2025
+ *
+ * Formato do arquivo (ordem de bytes da máquina): StatsHeader e, para as 'rows' perguntas
+ * que já saíram, uma coluna por grandeza (posição, id, vezes, acertos, as quatro
+ * alternativas, em uint32, e as somas de tempo, em double). A gravação copia as colunas
+ * sob a trava e escreve o arquivo fora dela, então o jogo só espera uma cópia de memória.
+ */
+
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "raylib/question_stats.h"
+#include <pthread.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+//---------------------------------------------
+// Definições e Constantes (Privadas ao Módulo)
+//---------------------------------------------
+#define STATS_MAGIC "QSTA"
+#define STATS_VERSION 1
+#define U32_COLUMNS 8       // posição, id, vezes, acertos e as quatro alternativas
+#define F64_COLUMNS 2
+
+typedef struct {
+    char magic[4];
+    uint32_t version;
+    uint32_t rows;
+} StatsHeader;
+
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    bool running;
+    bool dirty;             // há respostas ainda não gravadas
+    bool stopping;
+    char path[256];
+} StatsFlusher;
+
+//---------------------------------------------
+// Funções Privadas
+//---------------------------------------------
+static void AddRow(QuestionStats *stats, int index, const uint32_t *u32, const double *f64) {
+    stats->ids[index] = u32[1];
+    stats->served[index] += u32[2];
+    stats->correct[index] += u32[3];
+    for (int o = 0; o < 4; o++) stats->chosen[o][index] += u32[4 + o];
+    stats->timeSum[index] += f64[0];
+    stats->timeSquares[index] += f64[1];
+}
+
+static void LoadStatsFile(QuestionStats *stats, const char *path, int (*findQuestion)(uint32_t position, uint32_t id)) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return;
+    StatsHeader header;
+    uint32_t *u32 = NULL;
+    double *f64 = NULL;
+    bool valid = fread(&header, sizeof(header), 1, file) == 1 && memcmp(header.magic, STATS_MAGIC, sizeof(header.magic)) == 0
+                 && header.version == STATS_VERSION;
+    if (valid && header.rows > 0) {
+        u32 = malloc((size_t)header.rows * U32_COLUMNS * sizeof(uint32_t));
+        f64 = malloc((size_t)header.rows * F64_COLUMNS * sizeof(double));
+        valid = u32 != NULL && f64 != NULL
+                && fread(u32, sizeof(uint32_t), (size_t)header.rows * U32_COLUMNS, file) == (size_t)header.rows * U32_COLUMNS
+                && fread(f64, sizeof(double), (size_t)header.rows * F64_COLUMNS, file) == (size_t)header.rows * F64_COLUMNS;
+    }
+    fclose(file);
+    if (!valid) {
+        fprintf(stderr, "[QuestionStats] Aviso: '%s' inválido, estatísticas anteriores ignoradas.\n", path);
+        free(u32);
+        free(f64);
+        return;
+    }
+
+    int restored = 0, dropped = 0;
+    for (uint32_t r = 0; r < header.rows; r++) {
+        uint32_t row[U32_COLUMNS];
+        double sums[F64_COLUMNS];
+        for (int c = 0; c < U32_COLUMNS; c++) row[c] = u32[(size_t)c * header.rows + r];
+        for (int c = 0; c < F64_COLUMNS; c++) sums[c] = f64[(size_t)c * header.rows + r];
+        int index = findQuestion(row[0], row[1]);
+        if (index < 0 || index >= stats->count) {
+            dropped++;
+            continue;
+        }
+        AddRow(stats, index, row, sums);
+        restored++;
+    }
+    free(u32);
+    free(f64);
+    fprintf(stderr, "[QuestionStats] Estatísticas de %d perguntas restauradas", restored);
+    if (dropped > 0) fprintf(stderr, " (%d não existem mais no banco)", dropped);
+    fprintf(stderr, ".\n");
+}
+
+// Copia as perguntas que já saíram para colunas contíguas (sob a trava) e grava o
+// arquivo (sem a trava).
+static void FlushStats(QuestionStats *stats) {
+    StatsFlusher *flusher = stats->flusher;
+    pthread_mutex_lock(&flusher->lock);
+    if (!flusher->dirty) {
+        pthread_mutex_unlock(&flusher->lock);
+        return;
+    }
+    uint32_t rows = 0;
+    for (int i = 0; i < stats->count; i++) rows += (stats->served[i] > 0);
+    uint32_t *u32 = malloc(((size_t)rows * U32_COLUMNS + 1) * sizeof(uint32_t));
+    double *f64 = malloc(((size_t)rows * F64_COLUMNS + 1) * sizeof(double));
+    if (u32 == NULL || f64 == NULL) {
+        pthread_mutex_unlock(&flusher->lock);
+        free(u32);
+        free(f64);
+        return;
+    }
+    uint32_t r = 0;
+    for (int i = 0; i < stats->count; i++) {
+        if (stats->served[i] == 0) continue;
+        uint32_t row[U32_COLUMNS] = { (uint32_t)i, stats->ids[i], stats->served[i], stats->correct[i],
+                                      stats->chosen[0][i], stats->chosen[1][i], stats->chosen[2][i], stats->chosen[3][i] };
+        for (int c = 0; c < U32_COLUMNS; c++) u32[(size_t)c * rows + r] = row[c];
+        f64[r] = stats->timeSum[i];
+        f64[(size_t)rows + r] = stats->timeSquares[i];
+        r++;
+    }
+    flusher->dirty = false;
+    pthread_mutex_unlock(&flusher->lock);
+
+    char tempPath[sizeof(flusher->path) + 4];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", flusher->path);
+    FILE *file = fopen(tempPath, "wb");
+    bool written = false;
+    if (file != NULL) {
+        StatsHeader header;
+        memcpy(header.magic, STATS_MAGIC, sizeof(header.magic));
+        header.version = STATS_VERSION;
+        header.rows = rows;
+        written = fwrite(&header, sizeof(header), 1, file) == 1
+                  && fwrite(u32, sizeof(uint32_t), (size_t)rows * U32_COLUMNS, file) == (size_t)rows * U32_COLUMNS
+                  && fwrite(f64, sizeof(double), (size_t)rows * F64_COLUMNS, file) == (size_t)rows * F64_COLUMNS;
+        written = (fclose(file) == 0) && written;
+        if (written) {
+            remove(flusher->path); // rename não sobrescreve no Windows
+            written = rename(tempPath, flusher->path) == 0;
+        }
+        if (!written) remove(tempPath);
+    }
+    free(u32);
+    free(f64);
+    if (!written) {
+        fprintf(stderr, "[QuestionStats] Aviso: não foi possível gravar '%s'.\n", flusher->path);
+        pthread_mutex_lock(&flusher->lock);
+        flusher->dirty = true;  // tenta de novo na próxima rodada
+        pthread_mutex_unlock(&flusher->lock);
+    }
+}
+
+// Grava a cada QUESTION_STATS_FLUSH_SECONDS, e uma última vez ao ser parada.
+static void *FlushThread(void *argument) {
+    QuestionStats *stats = argument;
+    StatsFlusher *flusher = stats->flusher;
+    pthread_mutex_lock(&flusher->lock);
+    while (!flusher->stopping) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += QUESTION_STATS_FLUSH_SECONDS;
+        while (!flusher->stopping && pthread_cond_timedwait(&flusher->wake, &flusher->lock, &deadline) != ETIMEDOUT) {}
+        pthread_mutex_unlock(&flusher->lock);
+        FlushStats(stats);
+        pthread_mutex_lock(&flusher->lock);
+    }
+    pthread_mutex_unlock(&flusher->lock);
+    FlushStats(stats);  // a parada pode ter chegado antes da primeira espera
+    return NULL;
+}
+
+//---------------------------------------------
+// Implementação das Funções Públicas
+//---------------------------------------------
+
+bool InitQuestionStats(QuestionStats *stats, int count, const char *path, int (*findQuestion)(uint32_t position, uint32_t id)) {
+    memset(stats, 0, sizeof(*stats));
+    if (count <= 0) return false;
+    stats->count = count;
+    stats->ids = calloc((size_t)count, sizeof(uint32_t));
+    stats->served = calloc((size_t)count, sizeof(uint32_t));
+    stats->correct = calloc((size_t)count, sizeof(uint32_t));
+    for (int o = 0; o < 4; o++) stats->chosen[o] = calloc((size_t)count, sizeof(uint32_t));
+    stats->timeSum = calloc((size_t)count, sizeof(double));
+    stats->timeSquares = calloc((size_t)count, sizeof(double));
+    StatsFlusher *flusher = calloc(1, sizeof(StatsFlusher));
+    stats->flusher = flusher;
+    bool allocated = stats->ids != NULL && stats->served != NULL && stats->correct != NULL && stats->timeSum != NULL
+                     && stats->timeSquares != NULL && flusher != NULL;
+    for (int o = 0; o < 4; o++) allocated = allocated && stats->chosen[o] != NULL;
+    if (!allocated || pthread_mutex_init(&flusher->lock, NULL) != 0) {
+        free(flusher);
+        stats->flusher = NULL;
+        FreeQuestionStats(stats);
+        return false;
+    }
+    pthread_cond_init(&flusher->wake, NULL);
+    snprintf(flusher->path, sizeof(flusher->path), "%s", path);
+
+    LoadStatsFile(stats, path, findQuestion);
+    flusher->running = pthread_create(&flusher->thread, NULL, FlushThread, stats) == 0;
+    if (!flusher->running) fprintf(stderr, "[QuestionStats] Aviso: thread de gravação não iniciada; gravando só ao sair.\n");
+    return true;
+}
+
+void FreeQuestionStats(QuestionStats *stats) {
+    StatsFlusher *flusher = stats->flusher;
+    if (flusher != NULL) {
+        if (flusher->running) {
+            pthread_mutex_lock(&flusher->lock);
+            flusher->stopping = true;
+            pthread_cond_signal(&flusher->wake);
+            pthread_mutex_unlock(&flusher->lock);
+            pthread_join(flusher->thread, NULL);    // a thread grava uma última vez antes de sair
+        } else {
+            FlushStats(stats);
+        }
+        pthread_cond_destroy(&flusher->wake);
+        pthread_mutex_destroy(&flusher->lock);
+        free(flusher);
+    }
+    free(stats->ids);
+    free(stats->served);
+    free(stats->correct);
+    for (int o = 0; o < 4; o++) free(stats->chosen[o]);
+    free(stats->timeSum);
+    free(stats->timeSquares);
+    memset(stats, 0, sizeof(*stats));
+}
+
+void RecordQuestionAnswer(QuestionStats *stats, int index, int id, int option, bool correct, float responseTime) {
+    StatsFlusher *flusher = stats->flusher;
+    if (flusher == NULL || index < 0 || index >= stats->count) return;
+    pthread_mutex_lock(&flusher->lock);
+    stats->ids[index] = (uint32_t)id;
+    stats->served[index]++;
+    stats->correct[index] += correct;
+    if (option >= 0 && option < 4) stats->chosen[option][index]++;
+    stats->timeSum[index] += responseTime;
+    stats->timeSquares[index] += (double)responseTime * responseTime;
+    flusher->dirty = true;
+    pthread_mutex_unlock(&flusher->lock);
+}
@@ -2,117 +2,553 @@
  * @file questions.c
  * @author Grupo 1
  * @brief Implementação do módulo do Banco de Questões.
- * @version 1.0
+ * @version 2.4
  * @copyright Copyright (c) 2025
  */
 
 #include "raylib/questions.h"
-#include <stdlib.h> // Para rand() e srand()
+#include "raylib/question_bank.h"
+#include "raylib/question_history.h"
+#include "raylib/question_reload.h"
+#include "raylib/question_stats.h"
+#include "raylib/rng.h"
+#include <stdio.h>
+#include <stdlib.h> // Para getenv()
+#include <string.h>
+#include <math.h>
 
 //---------------------------------------------
 // Definições e Constantes (Privadas ao Módulo)
 //---------------------------------------------
-#define TOTAL_QUESTIONS 40
+#define BUILTIN_QUESTION_COUNT 40
 #define NUM_EASY 8
 #define NUM_MEDIUM 8
 #define NUM_HARD 4
+#define SAMPLE_ATTEMPTS 16      // sorteios por vaga antes de aceitar uma pergunta recente
+
+// Modo adaptativo (QUIZ_ADAPTIVE=1)
+#define ADAPTIVE_START_RATING 1400.0f   // entre as fáceis e as médias: o quiz começa tranquilo
+#define ADAPTIVE_K_START 200.0f         // passo do Elo na primeira resposta: converge em poucas perguntas
+#define ADAPTIVE_K_MIN 40.0f            // passo mínimo, para a estimativa assentar no fim do quiz
+#define ADAPTIVE_TARGET_SUCCESS 0.7f    // chance de acerto buscada em cada pergunta
+#define ADAPTIVE_NEIGHBOURHOOD 16       // perguntas mais próximas da nota alvo entre as quais se sorteia
+
+typedef struct {
+    uint32_t id;
+    uint32_t index;
+} IdEntry;
 
 //---------------------------------------------
 // Variáveis Estáticas (Privadas ao Módulo)
 //---------------------------------------------
-static Question questions[TOTAL_QUESTIONS];
-static int easyQuestionIndices[TOTAL_QUESTIONS];
-static int mediumQuestionIndices[TOTAL_QUESTIONS];
-static int hardQuestionIndices[TOTAL_QUESTIONS];
-static int easyCount = 0, mediumCount = 0, hardCount = 0;
+static QuestionBank bank = { 0 };
+static Question builtinQuestions[BUILTIN_QUESTION_COUNT];   // usadas se o arquivo do banco faltar ou for inválido
+static uint32_t builtinByDifficulty[BUILTIN_QUESTION_COUNT];  // as embutidas não estão agrupadas por dificuldade
+static bool usingBank = false;
+static int questionCount = 0;
+static QuestionPool allPools[3];        // o banco inteiro, por dificuldade
+static QuestionPool quizPools[3];       // de onde os quizzes são sorteados (o banco ou um filtro)
+static const int questionsPerDifficulty[3] = { NUM_EASY, NUM_MEDIUM, NUM_HARD };
+static QuestionHistory history = { 0 };
+static QuestionStats stats = { 0 };
+static QuestionRating builtinRatings[BUILTIN_QUESTION_COUNT];
+static const QuestionRating *ratingIndex = NULL;    // bank.ratings ou builtinRatings
+static const float builtinRatingByDifficulty[3] = { QUESTION_RATING_EASY, QUESTION_RATING_MEDIUM, QUESTION_RATING_HARD };
+static bool adaptiveMode = false;
+static float playerRating = ADAPTIVE_START_RATING;
+static int chosenQuizQuestions = 0;     // posições do quiz já escolhidas; no adaptativo, as demais são provisórias
+static bool historyDirty = false;       // perguntas do quiz adaptativo ainda não gravadas no histórico
+static QuestionReloader reloader = { 0 };
+static char questionLocale[16] = QUESTION_LOCALE_DEFAULT;   // idioma do banco em uso
+static char pendingLocale[16] = "";     // pedido por SetQuestionLocale; vale quando o banco dele entrar
+static char bankSourcePath[QUESTION_BANK_PATH_SIZE];
+static char bankPackPath[QUESTION_BANK_PATH_SIZE];
+static QuizFilter activeFilter = QUIZ_FILTER_NONE;     // reaplicado quando o banco é recarregado
+static char activeFilterName[64];
+static QuestionView quizViews[QUIZ_QUESTION_COUNT];     // as perguntas do quiz em andamento
+static IdEntry *idTable = NULL;         // id -> posição, só enquanto LoadHistory lê os arquivos
+static const char *difficultyLabels[3] = { "FACIL", "MEDIA", "DIFICIL" };
 
 //---------------------------------------------
 // Funções Privadas
 //---------------------------------------------
-static void ShuffleIntArray(int *array, int size) {
-    for (int i = size - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
-        int temp = array[i];
-        array[i] = array[j];
-        array[j] = temp;
+static int PoolQuestion(const QuestionPool *pool, int position) {
+    int index = (pool->indices != NULL) ? (int)pool->indices[position] : pool->first + position;
+    return (index >= 0 && index < questionCount) ? index : 0;  // índice de um pack corrompido
+}
+
+static bool AlreadyTaken(const int *taken, int count, int index) {
+    for (int i = 0; i < count; i++) {
+        if (taken[i] == index) return true;
     }
+    return false;
 }
 
-//---------------------------------------------
-// Implementação das Funções Públicas
-//---------------------------------------------
+// Sorteia 'k' perguntas distintas do grupo, evitando as do histórico recente. Cada
+// candidata custa O(1) (o histórico é um bitset), então o sorteio é O(k) sem embaralhar
+// nem copiar o grupo, qualquer que seja o seu tamanho. Se o grupo estiver quase todo no
+// histórico, as tentativas se esgotam e vale qualquer pergunta que ainda não esteja no quiz.
+static void SamplePool(const QuestionPool *pool, int k, int *out) {
+    Rng *rng = GetRandomStream(RNG_QUESTIONS);
+    for (int taken = 0; taken < k; taken++) {
+        int index = -1;
+        for (int attempt = 0; attempt < SAMPLE_ATTEMPTS && index < 0; attempt++) {
+            int candidate = PoolQuestion(pool, (int)RngBelow(rng, (uint32_t)pool->count));
+            if (!IsRecentQuestion(&history, candidate) && !AlreadyTaken(out, taken, candidate)) index = candidate;
+        }
+        // Procura a partir de uma posição sorteada; no máximo 'taken' posições estão ocupadas.
+        int position = (int)RngBelow(rng, (uint32_t)pool->count);
+        for (int step = 0; step < pool->count && index < 0; step++, position = (position + 1) % pool->count) {
+            int candidate = PoolQuestion(pool, position);
+            if (!AlreadyTaken(out, taken, candidate)) index = candidate;
+        }
+        out[taken] = (index >= 0) ? index : PoolQuestion(pool, 0);
+    }
+}
 
-void InitializeQuestions(void) {
+static int QuestionIdAt(int index) {
+    return GetQuestionFromOrder(index).id;
+}
+
+static int CompareIds(const void *a, const void *b) {
+    const IdEntry *x = a, *y = b;
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+// Posição atual da pergunta 'id', gravada na posição 'position' (-1 se saiu do banco).
+// A posição gravada costuma bater; a tabela id -> posição só é montada (uma vez,
+// O(n log n)) se alguma não bater, e é liberada ao fim de LoadHistory.
+static int FindQuestionPosition(uint32_t position, uint32_t id) {
+    if (position < (uint32_t)questionCount && (uint32_t)QuestionIdAt((int)position) == id) return (int)position;
+    if (idTable == NULL) {
+        idTable = malloc((size_t)questionCount * sizeof(IdEntry));
+        if (idTable == NULL) return -1;
+        for (int i = 0; i < questionCount; i++) idTable[i] = (IdEntry){ (uint32_t)QuestionIdAt(i), (uint32_t)i };
+        qsort(idTable, (size_t)questionCount, sizeof(IdEntry), CompareIds);
+    }
+    IdEntry key = { id, 0 };
+    const IdEntry *found = bsearch(&key, idTable, (size_t)questionCount, sizeof(IdEntry), CompareIds);
+    return (found != NULL) ? (int)found->index : -1;
+}
+
+// Monta a visão da pergunta 'index' do banco na posição 'position' do quiz.
+static void BuildQuizView(int position, int index) {
+    const Color difficultyColors[3] = { GREEN, YELLOW, RED };  // as cores da raylib não são constantes em C99
+    QuestionView *view = &quizViews[position];
+    view->question = GetQuestionFromOrder(index);
+    view->bankIndex = index;
+    view->image = GetQuestionImage(index);
+    view->difficultyLabel = difficultyLabels[view->question.difficulty];
+    view->difficultyColor = difficultyColors[view->question.difficulty];
+    view->layoutFontBaseSize = usingBank ? bank.layoutFontBaseSize : 0;
+    view->textLayout = GetQuestionTextLayout(index, -1, QUESTION_TEXT_STYLE, view->layoutFontBaseSize);
+    for (int o = 0; o < 4; o++) view->optionLayouts[o] = GetQuestionTextLayout(index, o, OPTION_TEXT_STYLE, view->layoutFontBaseSize);
+}
+
+static void SaveHistory(void) {
+    if (history.capacity > 0 && !SaveQuestionHistory(&history, QUESTION_HISTORY_PATH)) {
+        fprintf(stderr, "[Questions] Aviso: não foi possível gravar '%s'.\n", QUESTION_HISTORY_PATH);
+    }
+}
+
+static float QuestionRatingAt(int index) {
+    return usingBank ? GetBankRating(&bank, index) : builtinRatingByDifficulty[builtinQuestions[index].difficulty];
+}
+
+// Chance de acerto do jogador em uma pergunta de nota 'rating' (curva logística do Elo).
+static float ExpectedScore(float rating) {
+    return 1.0f / (1.0f + powf(10.0f, (rating - playerRating) / 400.0f));
+}
+
+static int RatingIndexQuestion(int position) {
+    int index = (int)ratingIndex[position].index;
+    return (index >= 0 && index < questionCount) ? index : 0;  // índice de um pack corrompido
+}
+
+// Primeira posição do índice com nota >= 'rating'.
+static int LowerBoundRating(float rating) {
+    int low = 0, high = questionCount;
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (ratingIndex[middle].rating < rating) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+// Próxima pergunta do modo adaptativo: busca binária pela nota em que o jogador acertaria
+// com chance ADAPTIVE_TARGET_SUCCESS e sorteio entre as vizinhas que não estão no quiz nem
+// no histórico. Se todas as vizinhas estiverem tomadas, a mais próxima fora do quiz.
+static int SelectAdaptiveQuestion(const int *asked, int askedCount) {
+    float target = playerRating - 400.0f * log10f(ADAPTIVE_TARGET_SUCCESS / (1.0f - ADAPTIVE_TARGET_SUCCESS));
+    int center = LowerBoundRating(target);
+    int span = (questionCount < ADAPTIVE_NEIGHBOURHOOD) ? questionCount : ADAPTIVE_NEIGHBOURHOOD;
+    int first = center - span / 2;
+    if (first > questionCount - span) first = questionCount - span;
+    if (first < 0) first = 0;
+
+    Rng *rng = GetRandomStream(RNG_QUESTIONS);
+    for (int attempt = 0; attempt < SAMPLE_ATTEMPTS; attempt++) {
+        int candidate = RatingIndexQuestion(first + (int)RngBelow(rng, (uint32_t)span));
+        if (!IsRecentQuestion(&history, candidate) && !AlreadyTaken(asked, askedCount, candidate)) return candidate;
+    }
+    for (int distance = 0; distance < questionCount; distance++) {
+        int above = center + distance, below = center - 1 - distance;
+        if (above < questionCount && !AlreadyTaken(asked, askedCount, RatingIndexQuestion(above))) return RatingIndexQuestion(above);
+        if (below >= 0 && !AlreadyTaken(asked, askedCount, RatingIndexQuestion(below))) return RatingIndexQuestion(below);
+    }
+    return RatingIndexQuestion(0);
+}
+
+// A janela é metade do banco: grande o bastante para cobrir vários quizzes seguidos,
+// sem deixar o sorteio sem perguntas fora do histórico.
+static void LoadHistory(void) {
+    FreeQuestionHistory(&history);
+    if (InitQuestionHistory(&history, questionCount, questionCount / 2)) {
+        LoadQuestionHistory(&history, QUESTION_HISTORY_PATH, FindQuestionPosition);
+    }
+    FreeQuestionStats(&stats);
+    InitQuestionStats(&stats, questionCount, QUESTION_STATS_PATH, FindQuestionPosition);
+    free(idTable);
+    idTable = NULL;
+}
+
+static bool PoolsCanFillQuiz(const QuestionPool pools[3]) {
+    for (int d = EASY; d <= HARD; d++) {
+        if (pools[d].count < questionsPerDifficulty[d]) return false;
+    }
+    return true;
+}
+
+// Monta os grupos por dificuldade; falha se faltar pergunta para montar um quiz.
+static bool BuildDifficultyPools(void) {
+    if (usingBank) {
+        // No pack as perguntas já vêm agrupadas por dificuldade; os registros não são lidos.
+        for (int d = EASY; d <= HARD; d++) allPools[d] = (QuestionPool){ NULL, bank.difficultyFirst[d], bank.difficultyCount[d] };
+    } else {
+        int used = 0;
+        for (int d = EASY; d <= HARD; d++) {
+            allPools[d] = (QuestionPool){ builtinByDifficulty + used, 0, 0 };
+            for (int i = 0; i < questionCount; i++) {
+                if (builtinQuestions[i].difficulty == (Difficulty)d) builtinByDifficulty[used + allPools[d].count++] = (uint32_t)i;
+            }
+            used += allPools[d].count;
+        }
+        // Nota padrão por dificuldade: a ordem por dificuldade já é a ordem por nota.
+        for (int i = 0; i < questionCount; i++) {
+            uint32_t index = builtinByDifficulty[i];
+            builtinRatings[i] = (QuestionRating){ builtinRatingByDifficulty[builtinQuestions[index].difficulty], index };
+        }
+    }
+    ratingIndex = usingBank ? bank.ratings : builtinRatings;
+    for (int d = EASY; d <= HARD; d++) quizPools[d] = allPools[d];
+    return PoolsCanFillQuiz(allPools);
+}
+
+// Esquece a troca de idioma pedida e volta a observar o banco em uso.
+static void CancelLocaleChange(void) {
+    pendingLocale[0] = '\0';
+    RetargetQuestionReloader(&reloader, bankSourcePath, bankPackPath, false);
+}
+
+// Desiste da troca de idioma se o banco pedido não carregou (JSON com erro, por exemplo).
+static void CheckLocaleChange(void) {
+    if (pendingLocale[0] != '\0' && TakeFailedQuestionReload(&reloader)) {
+        fprintf(stderr, "[Questions] Aviso: o banco de '%s' não carregou; as perguntas continuam em '%s'.\n", pendingLocale, questionLocale);
+        CancelLocaleChange();
+    }
+}
+
+// Troca o banco pelo que a thread de recarga deixou pronto, se houver. Só é chamada no
+// início de um quiz: nenhuma posição do banco antigo continua em uso. Histórico e
+// estatísticas são gravados e relidos para o banco novo, casando as perguntas pelo id.
+static void ApplyReloadedBank(void) {
+    QuestionBank reloaded;
+    CheckLocaleChange();
+    if (!TakeReloadedQuestionBank(&reloader, &reloaded)) return;
+    for (int d = EASY; d <= HARD; d++) {
+        if (reloaded.difficultyCount[d] < questionsPerDifficulty[d]) {
+            fprintf(stderr, "[Questions] Aviso: o banco recarregado precisa de %d fáceis, %d médias e %d difíceis; mantendo o atual.\n",
+                    NUM_EASY, NUM_MEDIUM, NUM_HARD);
+            UnloadQuestionBank(&reloaded);
+            if (pendingLocale[0] != '\0') CancelLocaleChange();
+            return;
+        }
+    }
+    SaveHistory();
+    FreeQuestionStats(&stats);  // grava as estatísticas ainda com as posições do banco antigo
+    UnloadQuestionBank(&bank);
+    bank = reloaded;
+    usingBank = true;
+    questionCount = bank.count;
+    BuildDifficultyPools();
+    LoadHistory();
+    if (activeFilter != QUIZ_FILTER_NONE && !SetQuizFilter(activeFilter, activeFilterName)) activeFilter = QUIZ_FILTER_NONE;
+    if (pendingLocale[0] != '\0') {
+        snprintf(questionLocale, sizeof(questionLocale), "%s", pendingLocale);
+        GetQuestionBankPaths(questionLocale, bankSourcePath, bankPackPath, sizeof(bankSourcePath));
+        pendingLocale[0] = '\0';
+    }
+    fprintf(stderr, "[Questions] Banco recarregado: %d perguntas em '%s'.\n", questionCount, questionLocale);
+}
+
+// Carrega o banco de um idioma; falha se não houver banco ou se ele não montar um quiz.
+static bool LoadLocaleBank(const char *locale) {
+    if (!GetQuestionBankPaths(locale, bankSourcePath, bankPackPath, sizeof(bankSourcePath))) {
+        fprintf(stderr, "[Questions] Aviso: idioma '%s' inválido.\n", locale);
+        return false;
+    }
+    if (!LoadQuestionBank(&bank, bankSourcePath, bankPackPath)) return false;
+    usingBank = true;
+    questionCount = bank.count;
+    if (!BuildDifficultyPools()) {
+        fprintf(stderr, "[Questions] Aviso: o banco precisa de %d fáceis, %d médias e %d difíceis.\n", NUM_EASY, NUM_MEDIUM, NUM_HARD);
+        UnloadQuestionBank(&bank);
+        usingBank = false;
+        questionCount = 0;
+        return false;
+    }
+    snprintf(questionLocale, sizeof(questionLocale), "%s", locale);
+    return true;
+}
+
+static void LoadBuiltinQuestions(void) {
     // Fáceis - 10 Pontos
-    questions[0] = (Question){"Qual o principal objetivo da ODS 14: Vida na Agua?", {"Conservar e usar de forma sustentavel os oceanos e mares", "Aumentar a producao de peixes para alimentacao", "Promover o turismo em todas as areas costeiras", "Incentivar a extracao de petroleo no fundo do mar"}, 0, EASY, 10};
-    questions[1] = (Question){"Qual material representa a maior parte do lixo encontrado nos oceanos?", {"Vidro", "Plastico", "Metal", "Papel"}, 1, EASY, 10};
-    questions[2] = (Question){"O que causa o 'branqueamento' dos corais?", {"Excesso de peixes na regiao", "Sombras de barcos passando", "Aumento da temperatura da agua", "Falta de sal no mar"}, 2, EASY, 10};
-    questions[3] = (Question){"Por que as tartarugas marinhas frequentemente comem sacolas plasticas?", {"Porque sao coloridas e chamativas", "Porque gostam do sabor do plastico", "Porque sentem o cheiro de comida nelas", "Porque confundem com aguas-vivas, seu alimento"}, 3, EASY, 10};
-    questions[4] = (Question){"Qual a porcentagem aproximada da superficie da Terra que e coberta por oceanos?", {"Cerca de 70%", "Cerca de 50%", "Cerca de 90%", "Cerca de 30%"}, 0, EASY, 10};
-    questions[5] = (Question){"Qual destes ecossistemas costeiros e um 'bercario' para muitas especies marinhas e protege a costa contra erosoes?", {"Praias rochosas", "Manguezais", "Dunas de areia", "Falesias"}, 1, EASY, 10};
-    questions[6] = (Question){"De onde vem a maior parte do oxigenio que respiramos?", {"Das arvores da Amazonia", "De grandes plantacoes de soja", "Das algas e fitoplancton marinho", "Liberado por atividade vulcanica"}, 2, EASY, 10};
-    questions[7] = (Question){"O que e a 'sobrepesca'?", {"Pescar apenas peixes muito grandes", "Usar barcos de pesca muito rapidos", "Pescar durante a noite", "Capturar peixes mais rapido do que eles conseguem se reproduzir"}, 3, EASY, 10};
-    questions[8] = (Question){"O derramamento de qual substancia causa grandes desastres ambientais, matando aves e peixes?", {"Petroleo", "Areia", "Sal", "Açucar"}, 0, EASY, 10};
-    questions[9] = (Question){"Qual a principal funcao das Areas Marinhas Protegidas (AMPs)?", {"Servir como rota para navios cargueiros", "Proteger a vida marinha e os habitats", "Ser um local exclusivo para esportes aquaticos", "Area de testes para equipamentos militares"}, 1, EASY, 10};
+    builtinQuestions[0] = (Question){"Qual o principal objetivo da ODS 14: Vida na Agua?", {"Conservar e usar de forma sustentavel os oceanos e mares", "Aumentar a producao de peixes para alimentacao", "Promover o turismo em todas as areas costeiras", "Incentivar a extracao de petroleo no fundo do mar"}, 0, EASY, 10, 1};
+    builtinQuestions[1] = (Question){"Qual material representa a maior parte do lixo encontrado nos oceanos?", {"Vidro", "Plastico", "Metal", "Papel"}, 1, EASY, 10, 2};
+    builtinQuestions[2] = (Question){"O que causa o 'branqueamento' dos corais?", {"Excesso de peixes na regiao", "Sombras de barcos passando", "Aumento da temperatura da agua", "Falta de sal no mar"}, 2, EASY, 10, 3};
+    builtinQuestions[3] = (Question){"Por que as tartarugas marinhas frequentemente comem sacolas plasticas?", {"Porque sao coloridas e chamativas", "Porque gostam do sabor do plastico", "Porque sentem o cheiro de comida nelas", "Porque confundem com aguas-vivas, seu alimento"}, 3, EASY, 10, 4};
+    builtinQuestions[4] = (Question){"Qual a porcentagem aproximada da superficie da Terra que e coberta por oceanos?", {"Cerca de 70%", "Cerca de 50%", "Cerca de 90%", "Cerca de 30%"}, 0, EASY, 10, 5};
+    builtinQuestions[5] = (Question){"Qual destes ecossistemas costeiros e um 'bercario' para muitas especies marinhas e protege a costa contra erosoes?", {"Praias rochosas", "Manguezais", "Dunas de areia", "Falesias"}, 1, EASY, 10, 6};
+    builtinQuestions[6] = (Question){"De onde vem a maior parte do oxigenio que respiramos?", {"Das arvores da Amazonia", "De grandes plantacoes de soja", "Das algas e fitoplancton marinho", "Liberado por atividade vulcanica"}, 2, EASY, 10, 7};
+    builtinQuestions[7] = (Question){"O que e a 'sobrepesca'?", {"Pescar apenas peixes muito grandes", "Usar barcos de pesca muito rapidos", "Pescar durante a noite", "Capturar peixes mais rapido do que eles conseguem se reproduzir"}, 3, EASY, 10, 8};
+    builtinQuestions[8] = (Question){"O derramamento de qual substancia causa grandes desastres ambientais, matando aves e peixes?", {"Petroleo", "Areia", "Sal", "Açucar"}, 0, EASY, 10, 9};
+    builtinQuestions[9] = (Question){"Qual a principal funcao das Areas Marinhas Protegidas (AMPs)?", {"Servir como rota para navios cargueiros", "Proteger a vida marinha e os habitats", "Ser um local exclusivo para esportes aquaticos", "Area de testes para equipamentos militares"}, 1, EASY, 10, 10};
     
     // Médias - 25 Pontos
-    questions[10] = (Question){"Qual fenomeno e causado pela absorcao de CO2 da atmosfera pelos oceanos, prejudicando organismos com conchas?", {"Eutrofizacao", "Salinizacao", "Acidificacao", "Termoclina"}, 2, MEDIUM, 25};
-    questions[11] = (Question){"O que sao 'microplasticos'?", {"Pequenos aparelhos eletronicos descartados no mar", "Marcas de plastico biodegradavel", "Organismos que se alimentam de plastico", "Fragmentos de plastico com menos de 5mm"}, 3, MEDIUM, 25};
-    questions[12] = (Question){"A 'pesca fantasma' se refere a:", {"Equipamentos de pesca perdidos que continuam a capturar animais", "Pescar em locais assombrados por lendas", "Um tipo de pesca ilegal feita a noite", "Usar iscas que brilham no escuro para atrair peixes"}, 0, MEDIUM, 25};
-    questions[13] = (Question){"O que e 'eutrofizacao', um problema comum em areas costeiras?", {"A agua fica mais clara e transparente", "Excesso de nutrientes que causa proliferacao de algas e falta de oxigenio", "Aumento da temperatura media da agua", "Diminuicao da quantidade de sal na agua"}, 1, MEDIUM, 25};
-    questions[14] = (Question){"Qual a importancia dos manguezais para o meio ambiente?", {"Servem de barreira de protecao e sao bercarios de especies", "Sao as principais fontes de areia para as praias", "Aumentam a forca das ondas na costa", "Sao locais ideais para a construcao de portos"}, 0, MEDIUM, 25};
-    questions[15] = (Question){"Qual destes e um exemplo de especie invasora que causa problemas no Atlantico, incluindo no Brasil?", {"Peixe-palhaco", "Peixe-leao", "Tubarão-martelo", "Cavalo-marinho"}, 1, MEDIUM, 25};
-    questions[16] = (Question){"A poluicao sonora nos oceanos, causada por navios e sonares, afeta principalmente qual capacidade das baleias e golfinhos?", {"Sua visao noturna", "Seu olfato para encontrar comida", "Sua comunicacao e localizacao", "Sua capacidade de flutuar"}, 2, MEDIUM, 25};
-    questions[17] = (Question){"O que e 'carbono azul' (blue carbon)?", {"Um tipo raro de coral azul", "A poluicao de carbono emitida por navios", "Um combustivel fossil encontrado no fundo do mar", "Carbono capturado e armazenado por ecossistemas marinhos costeiros"}, 3, MEDIUM, 25};
-    questions[18] = (Question){"A meta 14.1 da ODS 14 foca em reduzir qual tipo de problema ate 2025?", {"O numero de naufragios de navios", "A poluicao marinha de todos os tipos, especialmente de fontes terrestres", "O barulho gerado por turbinas eolicas no mar", "A quantidade de sal extraida para consumo"}, 1, MEDIUM, 25};
-    questions[19] = (Question){"Por que o descongelamento das geleiras e uma ameaca aos oceanos?", {"Aumenta a salinidade da agua", "Cria novas rotas de navegacao", "Eleva o nivel do mar e altera as correntes marinhas", "Diminui a quantidade de peixes"}, 2, MEDIUM, 25};
+    builtinQuestions[10] = (Question){"Qual fenomeno e causado pela absorcao de CO2 da atmosfera pelos oceanos, prejudicando organismos com conchas?", {"Eutrofizacao", "Salinizacao", "Acidificacao", "Termoclina"}, 2, MEDIUM, 25, 11};
+    builtinQuestions[11] = (Question){"O que sao 'microplasticos'?", {"Pequenos aparelhos eletronicos descartados no mar", "Marcas de plastico biodegradavel", "Organismos que se alimentam de plastico", "Fragmentos de plastico com menos de 5mm"}, 3, MEDIUM, 25, 12};
+    builtinQuestions[12] = (Question){"A 'pesca fantasma' se refere a:", {"Equipamentos de pesca perdidos que continuam a capturar animais", "Pescar em locais assombrados por lendas", "Um tipo de pesca ilegal feita a noite", "Usar iscas que brilham no escuro para atrair peixes"}, 0, MEDIUM, 25, 13};
+    builtinQuestions[13] = (Question){"O que e 'eutrofizacao', um problema comum em areas costeiras?", {"A agua fica mais clara e transparente", "Excesso de nutrientes que causa proliferacao de algas e falta de oxigenio", "Aumento da temperatura media da agua", "Diminuicao da quantidade de sal na agua"}, 1, MEDIUM, 25, 14};
+    builtinQuestions[14] = (Question){"Qual a importancia dos manguezais para o meio ambiente?", {"Servem de barreira de protecao e sao bercarios de especies", "Sao as principais fontes de areia para as praias", "Aumentam a forca das ondas na costa", "Sao locais ideais para a construcao de portos"}, 0, MEDIUM, 25, 15};
+    builtinQuestions[15] = (Question){"Qual destes e um exemplo de especie invasora que causa problemas no Atlantico, incluindo no Brasil?", {"Peixe-palhaco", "Peixe-leao", "Tubarão-martelo", "Cavalo-marinho"}, 1, MEDIUM, 25, 16};
+    builtinQuestions[16] = (Question){"A poluicao sonora nos oceanos, causada por navios e sonares, afeta principalmente qual capacidade das baleias e golfinhos?", {"Sua visao noturna", "Seu olfato para encontrar comida", "Sua comunicacao e localizacao", "Sua capacidade de flutuar"}, 2, MEDIUM, 25, 17};
+    builtinQuestions[17] = (Question){"O que e 'carbono azul' (blue carbon)?", {"Um tipo raro de coral azul", "A poluicao de carbono emitida por navios", "Um combustivel fossil encontrado no fundo do mar", "Carbono capturado e armazenado por ecossistemas marinhos costeiros"}, 3, MEDIUM, 25, 18};
+    builtinQuestions[18] = (Question){"A meta 14.1 da ODS 14 foca em reduzir qual tipo de problema ate 2025?", {"O numero de naufragios de navios", "A poluicao marinha de todos os tipos, especialmente de fontes terrestres", "O barulho gerado por turbinas eolicas no mar", "A quantidade de sal extraida para consumo"}, 1, MEDIUM, 25, 19};
+    builtinQuestions[19] = (Question){"Por que o descongelamento das geleiras e uma ameaca aos oceanos?", {"Aumenta a salinidade da agua", "Cria novas rotas de navegacao", "Eleva o nivel do mar e altera as correntes marinhas", "Diminui a quantidade de peixes"}, 2, MEDIUM, 25, 20};
 
     // Difíceis - 50 Pontos
-    questions[20] = (Question){"O 'Giro do Pacifico Norte' e uma area oceanica conhecida por:", {"Ter as aguas mais quentes do planeta", "Ser a maior rota de migracao de baleias", "Ser o local de uma grande acumulacao de lixo plastico", "Possuir a maior quantidade de vulcoes submarinos ativos"}, 2, HARD, 50};
-    questions[21] = (Question){"A Convencao das Nacoes Unidas sobre o Direito do Mar (UNCLOS) define a Zona Economica Exclusiva (ZEE) como uma faixa de ate:", {"500 milhas nauticas da costa", "12 milhas nauticas da costa", "50 milhas nauticas da costa", "200 milhas nauticas da costa"}, 3, HARD, 50};
-    questions[22] = (Question){"O que e o 'Rendimento Maximo Sustentavel' (MSY) na gestao da pesca?", {"A maior quantidade de peixes que pode ser capturada sem esgotar o estoque", "O lucro maximo que uma empresa de pesca pode ter por lei", "O peso maximo que um unico barco de pesca pode transportar", "A velocidade maxima permitida para barcos de pesca em alto mar"}, 0, HARD, 50};
-    questions[23] = (Question){"Qual organismo microscopico e a base da maior parte da cadeia alimentar marinha e produz oxigenio?", {"Krill", "Fitoplancton", "Zooplancton", "Bacterias marinhas"}, 1, HARD, 50};
-    questions[24] = (Question){"A 'hipoxia', que cria as 'zonas mortas' no oceano, e uma condicao de:", {"Falta de luz solar no fundo do mar", "Agua com niveis extremamente baixos de oxigenio", "Excesso de sal na agua, tornando-a inabitavel", "Temperatura da agua abaixo de zero"}, 1, HARD, 50};
-    questions[25] = (Question){"Qual a principal reacao quimica que descreve a acidificacao dos oceanos?", {"O2 + 2H2 -> 2H2O", "NaCl -> Na+ + Cl-", "CO2 + H2O -> H2CO3", "CaCO3 -> CaO + CO2"}, 2, HARD, 50};
-    questions[26] = (Question){"A decada de 2021-2030 foi proclamada pela ONU como a Decada da:", {"Exploracao de Recursos Minerais Marinhos", "Protecao das Aves Marinhas", "Navegacao Sustentavel", "Ciencia Oceanica para o Desenvolvimento Sustentavel"}, 3, HARD, 50};
-    questions[27] = (Question){"A 'biomagnificacao' e um processo perigoso onde:", {"Toxinas se acumulam em concentracoes maiores ao longo da cadeia alimentar", "Organismos marinhos crescem a um tamanho anormal", "A biodiversidade de uma area aumenta rapidamente", "A quantidade de sal aumenta em um organismo"}, 0, HARD, 50};
-    questions[28] = (Question){"Qual destes subsidios a pesca a ODS 14.6 busca eliminar?", {"Subsidios para combustivel de pequenos pescadores", "Subsidios que contribuem para a sobrepesca e a pesca ilegal", "Financiamento para pesquisas sobre a vida marinha", "Ajuda de custo para a seguranca dos pescadores"}, 1, HARD, 50};
-    questions[29] = (Question){"A 'termoclina' e uma camada no oceano onde ocorre uma rapida mudanca de:", {"Salinidade", "Pressao", "Temperatura", "Visibilidade"}, 2, HARD, 50};
+    builtinQuestions[20] = (Question){"O 'Giro do Pacifico Norte' e uma area oceanica conhecida por:", {"Ter as aguas mais quentes do planeta", "Ser a maior rota de migracao de baleias", "Ser o local de uma grande acumulacao de lixo plastico", "Possuir a maior quantidade de vulcoes submarinos ativos"}, 2, HARD, 50, 21};
+    builtinQuestions[21] = (Question){"A Convencao das Nacoes Unidas sobre o Direito do Mar (UNCLOS) define a Zona Economica Exclusiva (ZEE) como uma faixa de ate:", {"500 milhas nauticas da costa", "12 milhas nauticas da costa", "50 milhas nauticas da costa", "200 milhas nauticas da costa"}, 3, HARD, 50, 22};
+    builtinQuestions[22] = (Question){"O que e o 'Rendimento Maximo Sustentavel' (MSY) na gestao da pesca?", {"A maior quantidade de peixes que pode ser capturada sem esgotar o estoque", "O lucro maximo que uma empresa de pesca pode ter por lei", "O peso maximo que um unico barco de pesca pode transportar", "A velocidade maxima permitida para barcos de pesca em alto mar"}, 0, HARD, 50, 23};
+    builtinQuestions[23] = (Question){"Qual organismo microscopico e a base da maior parte da cadeia alimentar marinha e produz oxigenio?", {"Krill", "Fitoplancton", "Zooplancton", "Bacterias marinhas"}, 1, HARD, 50, 24};
+    builtinQuestions[24] = (Question){"A 'hipoxia', que cria as 'zonas mortas' no oceano, e uma condicao de:", {"Falta de luz solar no fundo do mar", "Agua com niveis extremamente baixos de oxigenio", "Excesso de sal na agua, tornando-a inabitavel", "Temperatura da agua abaixo de zero"}, 1, HARD, 50, 25};
+    builtinQuestions[25] = (Question){"Qual a principal reacao quimica que descreve a acidificacao dos oceanos?", {"O2 + 2H2 -> 2H2O", "NaCl -> Na+ + Cl-", "CO2 + H2O -> H2CO3", "CaCO3 -> CaO + CO2"}, 2, HARD, 50, 26};
+    builtinQuestions[26] = (Question){"A decada de 2021-2030 foi proclamada pela ONU como a Decada da:", {"Exploracao de Recursos Minerais Marinhos", "Protecao das Aves Marinhas", "Navegacao Sustentavel", "Ciencia Oceanica para o Desenvolvimento Sustentavel"}, 3, HARD, 50, 27};
+    builtinQuestions[27] = (Question){"A 'biomagnificacao' e um processo perigoso onde:", {"Toxinas se acumulam em concentracoes maiores ao longo da cadeia alimentar", "Organismos marinhos crescem a um tamanho anormal", "A biodiversidade de uma area aumenta rapidamente", "A quantidade de sal aumenta em um organismo"}, 0, HARD, 50, 28};
+    builtinQuestions[28] = (Question){"Qual destes subsidios a pesca a ODS 14.6 busca eliminar?", {"Subsidios para combustivel de pequenos pescadores", "Subsidios que contribuem para a sobrepesca e a pesca ilegal", "Financiamento para pesquisas sobre a vida marinha", "Ajuda de custo para a seguranca dos pescadores"}, 1, HARD, 50, 29};
+    builtinQuestions[29] = (Question){"A 'termoclina' e uma camada no oceano onde ocorre uma rapida mudanca de:", {"Salinidade", "Pressao", "Temperatura", "Visibilidade"}, 2, HARD, 50, 30};
     
     // Novas Perguntas
-    questions[30] = (Question){"Qual o maior animal que ja existiu na Terra?", {"Dinossauro T-Rex", "Elefante Africano", "Baleia Azul", "Tubarão Megalodon"}, 2, EASY, 10};
-    questions[31] = (Question){"Como os peixes respiram debaixo d'agua?", {"Segurando o ar por muito tempo", "Atraves de guelras (branquias)", "Pela pele", "Eles nao precisam respirar"}, 1, EASY, 10};
-    questions[32] = (Question){"O que é um grande grupo de peixes nadando juntos?", {"Rebanho", "Cardume", "Alcateia", "Bando"}, 1, EASY, 10};
-    questions[33] = (Question){"O que causa as marés (a subida e descida do nível do mar)?", {"O vento forte", "A rotação da Terra", "Correntes marítimas", "A gravidade da Lua e do Sol"}, 3, EASY, 10};
-    questions[34] = (Question){"O que é a bioluminescência em animais marinhos?", {"Um tipo de camuflagem", "A capacidade de produzir luz própria", "A habilidade de respirar fora d'água", "Um som usado para comunicação"}, 1, MEDIUM, 25};
-    questions[35] = (Question){"A Grande Barreira de Corais, o maior sistema de recifes do mundo, fica na costa de qual país?", {"Brasil", "Africa do Sul", "Japão", "Australia"}, 3, MEDIUM, 25};
-    questions[36] = (Question){"Qual é o nome do processo em que a água do oceano evapora, forma nuvens e depois volta como chuva?", {"Fotossíntese", "Ciclo da água", "Efeito estufa", "Erosão"}, 1, MEDIUM, 25};
-    questions[37] = (Question){"Qual é o ponto mais profundo conhecido nos oceanos da Terra?", {"Fossa das Marianas", "Fossa de Tonga", "Fossa do Japão", "Abismo de Challenger"}, 0, HARD, 50};
-    questions[38] = (Question){"Na pesca, o que significa o termo 'bycatch' (captura acidental)?", {"Pescar mais do que o permitido", "Usar redes de pesca ilegais", "Animais marinhos capturados sem querer", "Um tipo de peixe raro"}, 2, HARD, 50};
-    questions[39] = (Question){"Qual convenção internacional é o principal acordo para a prevenção da poluição do ambiente marinho por navios?", {"Convenção de Estocolmo", "Protocolo de Kyoto", "Acordo de Paris", "Convenção MARPOL"}, 3, HARD, 50};
-
-    for (int i = 0; i < TOTAL_QUESTIONS; i++) {
-        switch (questions[i].difficulty) {
-            case EASY:   easyQuestionIndices[easyCount++] = i;   break;
-            case MEDIUM: mediumQuestionIndices[mediumCount++] = i; break;
-            case HARD:   hardQuestionIndices[hardCount++] = i;   break;
-        }
+    builtinQuestions[30] = (Question){"Qual o maior animal que ja existiu na Terra?", {"Dinossauro T-Rex", "Elefante Africano", "Baleia Azul", "Tubarão Megalodon"}, 2, EASY, 10, 31};
+    builtinQuestions[31] = (Question){"Como os peixes respiram debaixo d'agua?", {"Segurando o ar por muito tempo", "Atraves de guelras (branquias)", "Pela pele", "Eles nao precisam respirar"}, 1, EASY, 10, 32};
+    builtinQuestions[32] = (Question){"O que é um grande grupo de peixes nadando juntos?", {"Rebanho", "Cardume", "Alcateia", "Bando"}, 1, EASY, 10, 33};
+    builtinQuestions[33] = (Question){"O que causa as marés (a subida e descida do nível do mar)?", {"O vento forte", "A rotação da Terra", "Correntes marítimas", "A gravidade da Lua e do Sol"}, 3, EASY, 10, 34};
+    builtinQuestions[34] = (Question){"O que é a bioluminescência em animais marinhos?", {"Um tipo de camuflagem", "A capacidade de produzir luz própria", "A habilidade de respirar fora d'água", "Um som usado para comunicação"}, 1, MEDIUM, 25, 35};
+    builtinQuestions[35] = (Question){"A Grande Barreira de Corais, o maior sistema de recifes do mundo, fica na costa de qual país?", {"Brasil", "Africa do Sul", "Japão", "Australia"}, 3, MEDIUM, 25, 36};
+    builtinQuestions[36] = (Question){"Qual é o nome do processo em que a água do oceano evapora, forma nuvens e depois volta como chuva?", {"Fotossíntese", "Ciclo da água", "Efeito estufa", "Erosão"}, 1, MEDIUM, 25, 37};
+    builtinQuestions[37] = (Question){"Qual é o ponto mais profundo conhecido nos oceanos da Terra?", {"Fossa das Marianas", "Fossa de Tonga", "Fossa do Japão", "Abismo de Challenger"}, 0, HARD, 50, 38};
+    builtinQuestions[38] = (Question){"Na pesca, o que significa o termo 'bycatch' (captura acidental)?", {"Pescar mais do que o permitido", "Usar redes de pesca ilegais", "Animais marinhos capturados sem querer", "Um tipo de peixe raro"}, 2, HARD, 50, 39};
+    builtinQuestions[39] = (Question){"Qual convenção internacional é o principal acordo para a prevenção da poluição do ambiente marinho por navios?", {"Convenção de Estocolmo", "Protocolo de Kyoto", "Acordo de Paris", "Convenção MARPOL"}, 3, HARD, 50, 40};
+}
+
+//---------------------------------------------
+// Implementação das Funções Públicas
+//---------------------------------------------
+
+void InitializeQuestions(void) {
+    const char *adaptive = getenv("QUIZ_ADAPTIVE");
+    adaptiveMode = adaptive != NULL && adaptive[0] != '\0' && strcmp(adaptive, "0") != 0;
+    if (adaptiveMode) fprintf(stderr, "[Questions] Modo adaptativo: as perguntas acompanham o desempenho do jogador.\n");
+
+    // Só o banco do idioma escolhido (QUIZ_LOCALE=en, por exemplo) é carregado.
+    const char *locale = getenv("QUIZ_LOCALE");
+    if (locale == NULL || locale[0] == '\0') locale = QUESTION_LOCALE_DEFAULT;
+    bool loaded = LoadLocaleBank(locale);
+    if (!loaded && strcmp(locale, QUESTION_LOCALE_DEFAULT) != 0) {
+        fprintf(stderr, "[Questions] Aviso: sem banco para o idioma '%s'; usando '%s'.\n", locale, QUESTION_LOCALE_DEFAULT);
+        loaded = LoadLocaleBank(QUESTION_LOCALE_DEFAULT);
+    }
+    if (loaded) {
+        LoadHistory();
+        // Filtro opcional para o quiz inteiro, por exemplo QUIZ_CATEGORY=poluicao.
+        const char *topic = getenv("QUIZ_TOPIC");
+        const char *category = getenv("QUIZ_CATEGORY");
+        if (topic != NULL) SetQuizFilter(QUIZ_FILTER_TOPIC, topic);
+        else if (category != NULL) SetQuizFilter(QUIZ_FILTER_CATEGORY, category);
+        StartQuestionReloader(&reloader, bankSourcePath, bankPackPath);
+        return;
+    }
+
+    fprintf(stderr, "[Questions] Usando as perguntas embutidas.\n");
+    LoadBuiltinQuestions();
+    usingBank = false;
+    questionCount = BUILTIN_QUESTION_COUNT;
+    BuildDifficultyPools();
+    LoadHistory();
+    snprintf(questionLocale, sizeof(questionLocale), "%s", QUESTION_LOCALE_DEFAULT);
+    GetQuestionBankPaths(QUESTION_LOCALE_DEFAULT, bankSourcePath, bankPackPath, sizeof(bankSourcePath));
+    StartQuestionReloader(&reloader, bankSourcePath, bankPackPath);   // o JSON pode ser criado ou corrigido depois
+}
+
+void UnloadQuestions(void) {
+    FinishQuiz();
+    StopQuestionReloader(&reloader);
+    pendingLocale[0] = '\0';
+    FreeQuestionStats(&stats);
+    FreeQuestionHistory(&history);
+    UnloadQuestionBank(&bank);
+    usingBank = false;
+    questionCount = 0;
+}
+
+bool SetQuestionLocale(const char *locale) {
+    char sourcePath[QUESTION_BANK_PATH_SIZE], packPath[QUESTION_BANK_PATH_SIZE];
+    if (locale == NULL || !GetQuestionBankPaths(locale, sourcePath, packPath, sizeof(sourcePath))) {
+        fprintf(stderr, "[Questions] Aviso: idioma '%s' inválido.\n", (locale != NULL) ? locale : "");
+        return false;
+    }
+    CheckLocaleChange();
+    if (strcmp(locale, GetRequestedQuestionLocale()) == 0) return true;
+    if (strcmp(locale, questionLocale) == 0) {     // voltou ao idioma em uso antes de o outro entrar
+        CancelLocaleChange();
+        fprintf(stderr, "[Questions] Perguntas continuam em '%s'.\n", locale);
+        return true;
+    }
+    FILE *file = fopen(sourcePath, "rb");
+    if (file == NULL) file = fopen(packPath, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "[Questions] Aviso: não há banco para o idioma '%s'.\n", locale);
+        return false;
+    }
+    fclose(file);
+    if (!RetargetQuestionReloader(&reloader, sourcePath, packPath, true)) {
+        fprintf(stderr, "[Questions] Aviso: troca de idioma indisponível sem a thread de recarga.\n");
+        return false;
+    }
+    snprintf(pendingLocale, sizeof(pendingLocale), "%s", locale);
+    fprintf(stderr, "[Questions] Perguntas em '%s' a partir do próximo quiz.\n", locale);
+    return true;
+}
+
+const char *GetQuestionLocale(void) {
+    return questionLocale;
+}
+
+const char *GetRequestedQuestionLocale(void) {
+    return (pendingLocale[0] != '\0') ? pendingLocale : questionLocale;
+}
+
+bool SetQuizFilter(QuizFilter filter, const char *name) {
+    if (filter == QUIZ_FILTER_NONE) {
+        for (int d = EASY; d <= HARD; d++) quizPools[d] = allPools[d];
+        activeFilter = QUIZ_FILTER_NONE;
+        return true;
+    }
+    QuestionPool pools[3];
+    QuestionTagKind kind = (filter == QUIZ_FILTER_TOPIC) ? TAG_TOPIC : TAG_CATEGORY;
+    if (!usingBank || name == NULL || !FindBankTag(&bank, kind, name, pools)) {
+        fprintf(stderr, "[Questions] Aviso: '%s' não existe no banco; filtro ignorado.\n", (name != NULL) ? name : "");
+        return false;
+    }
+    if (!PoolsCanFillQuiz(pools)) {
+        fprintf(stderr, "[Questions] Aviso: '%s' tem %d fáceis, %d médias e %d difíceis; um quiz precisa de %d, %d e %d. Filtro ignorado.\n",
+                name, pools[EASY].count, pools[MEDIUM].count, pools[HARD].count, NUM_EASY, NUM_MEDIUM, NUM_HARD);
+        return false;
     }
+    for (int d = EASY; d <= HARD; d++) quizPools[d] = pools[d];
+    activeFilter = filter;
+    if (name != activeFilterName) snprintf(activeFilterName, sizeof(activeFilterName), "%s", name);
+    fprintf(stderr, "[Questions] Quizzes restritos a '%s'.\n", name);
+    return true;
 }
 
 void SelectAndShuffleQuizQuestions(int *questionOrder) {
-    ShuffleIntArray(easyQuestionIndices, easyCount);
-    ShuffleIntArray(mediumQuestionIndices, mediumCount);
-    ShuffleIntArray(hardQuestionIndices, hardCount);
-    
+    ApplyReloadedBank();
+    if (adaptiveMode) {
+        // Só a primeira pergunta é escolhida agora; as demais dependem das respostas.
+        playerRating = ADAPTIVE_START_RATING;
+        questionOrder[0] = SelectAdaptiveQuestion(questionOrder, 0);
+        MarkQuestionServed(&history, questionOrder[0], QuestionIdAt(questionOrder[0]));
+        historyDirty = true;
+        chosenQuizQuestions = 1;
+        for (int i = 1; i < QUIZ_QUESTION_COUNT; i++) questionOrder[i] = questionOrder[0];
+        for (int i = 0; i < QUIZ_QUESTION_COUNT; i++) BuildQuizView(i, questionOrder[i]);
+        return;
+    }
+
     int currentQuizIndex = 0;
-    for (int i = 0; i < NUM_EASY && i < easyCount; i++) questionOrder[currentQuizIndex++] = easyQuestionIndices[i];
-    for (int i = 0; i < NUM_MEDIUM && i < mediumCount; i++) questionOrder[currentQuizIndex++] = mediumQuestionIndices[i];
-    for (int i = 0; i < NUM_HARD && i < hardCount; i++) questionOrder[currentQuizIndex++] = hardQuestionIndices[i];
-    
-    ShuffleIntArray(questionOrder, QUIZ_QUESTION_COUNT);
+    for (int d = EASY; d <= HARD; d++) {
+        SamplePool(&quizPools[d], questionsPerDifficulty[d], questionOrder + currentQuizIndex);
+        currentQuizIndex += questionsPerDifficulty[d];
+    }
+    for (int i = 0; i < QUIZ_QUESTION_COUNT; i++) MarkQuestionServed(&history, questionOrder[i], QuestionIdAt(questionOrder[i]));
+    SaveHistory();
+
+    RngShuffle(GetRandomStream(RNG_QUESTIONS), questionOrder, QUIZ_QUESTION_COUNT);
+    for (int i = 0; i < QUIZ_QUESTION_COUNT; i++) BuildQuizView(i, questionOrder[i]);
+    chosenQuizQuestions = QUIZ_QUESTION_COUNT;
+}
+
+void RecordQuizAnswer(int *questionOrder, int position, int selectedOption, float responseTime) {
+    const Question *question = &quizViews[position].question;
+    bool correct = selectedOption == question->correctOption;
+    RecordQuestionAnswer(&stats, questionOrder[position], question->id, selectedOption, correct, responseTime);
+    if (!adaptiveMode) return;
+    float k = ADAPTIVE_K_START / (1.0f + position / 4.0f);
+    if (k < ADAPTIVE_K_MIN) k = ADAPTIVE_K_MIN;
+    playerRating += k * ((correct ? 1.0f : 0.0f) - ExpectedScore(QuestionRatingAt(questionOrder[position])));
+    if (position + 1 >= QUIZ_QUESTION_COUNT) return;
+
+    int next = SelectAdaptiveQuestion(questionOrder, position + 1);
+    questionOrder[position + 1] = next;
+    BuildQuizView(position + 1, next);
+    MarkQuestionServed(&history, next, QuestionIdAt(next));
+    historyDirty = true;
+    chosenQuizQuestions = position + 2;
+}
+
+void FinishQuiz(void) {
+    if (!historyDirty) return;
+    historyDirty = false;
+    SaveHistory();
+}
+
+bool IsQuizQuestionChosen(int position) {
+    return position >= 0 && position < chosenQuizQuestions;
+}
+
+const QuestionView *GetQuizQuestion(int position) {
+    return &quizViews[(position >= 0 && position < QUIZ_QUESTION_COUNT) ? position : 0];
 }
 
 Question GetQuestionFromOrder(int orderIndex) {
-    return questions[orderIndex];
+    if (usingBank) return GetBankQuestion(&bank, orderIndex);
+    return builtinQuestions[orderIndex];
+}
+
+const char *GetQuestionImage(int orderIndex) {
+    return usingBank ? GetBankImage(&bank, orderIndex) : NULL;
+}
+
+const TextLayout *GetQuestionTextLayout(int orderIndex, int option, TextStyle style, int fontBaseSize) {
+    const QuestionLayout *layout = usingBank ? GetBankLayout(&bank, orderIndex) : NULL;
+    if (layout == NULL || bank.layoutFontBaseSize != fontBaseSize) return NULL;
+
+    // Só vale para o mesmo estilo com que o compilador do banco quebrou as linhas.
+    const TextStyle *packed = &bank.layoutStyles[(option < 0) ? 0 : 1];
+    if (packed->fontSize != style.fontSize || packed->spacing != style.spacing || packed->width != style.width) return NULL;
+
+    const TextLayout *text = (option < 0) ? &layout->question : &layout->options[option];
+    return (text->lineCount > 0) ? text : NULL;
 }
\ No newline at end of file
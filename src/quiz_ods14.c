@@ -18,8 +18,13 @@
 #include "raylib/music_player.h" 
 #include "raylib/water_fx.h"
 #include "raylib/questions.h"
+#include "raylib/question_images.h"
+#include "raylib/text_layout.h"
+#include "raylib/game_font.h"
+#include "raylib/rlgl.h"
 #include "raylib/leaderboard.h"
 #include "raylib/scoring.h"
+#include "raylib/rng.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -33,6 +38,7 @@
 //---------------------------------------------
 #define SCREEN_WIDTH 1920
 #define SCREEN_HEIGHT 1080
+#define CARD_AREA CLITERAL(Rectangle){ 150, 240, 1620, 570 }  // enunciado e alternativas na tela de pergunta
 // QUESTION_TIME agora está em scoring.h
 
 //---------------------------------------------
@@ -40,6 +46,13 @@
 //---------------------------------------------
 typedef enum { SCREEN_MENU, SCREEN_HOW_TO_PLAY, SCREEN_LEADERBOARD, SCREEN_CREDITS, SCREEN_ENTER_NAME, SCREEN_GAMEPLAY, SCREEN_SHOW_ANSWER, SCREEN_GAME_OVER } GameScreen;
 
+// Textos de uma pergunta (que não mudam enquanto ela está na tela) já desenhados numa textura.
+typedef struct {
+    RenderTexture2D target;
+    int quiz;           // quiz em que foi desenhado (quizNumber); -1 = vazio
+    int position;       // posição da pergunta no quiz
+} QuestionCard;
+
 //---------------------------------------------
 // Variáveis Globais do Jogo
 //---------------------------------------------
@@ -72,18 +85,32 @@ static const char* menuNotificationText = NULL;
 static float menuNotificationTimer = 0.0f;
 
 static char rankMessage[100] = { 0 };
+static char localeMessage[64] = { 0 };
+static const char *questionLocales[] = { "pt", "en", "es" };   // tecla L no menu
+
+static const Rectangle questionTextRect = { 157, 243, 1595, 155 };
+static const Rectangle optionTextRects[4] = { {215, 505, 500, 72}, {1262, 506, 500, 72}, {217, 726, 500, 72}, {1258, 732, 500, 72} };
+static QuestionCard questionCards[2];   // a pergunta na tela e a próxima
+static bool useQuestionCards = false;   // QUIZ_CARDS=0 desenha os textos a cada frame
+static int quizNumber = 0;
 
 //---------------------------------------------
 // Protótipos de Funções
 //---------------------------------------------
 void UpdateDrawFrame(void);
 void GoToMenu(void);
-void DrawTextWrappedCentered(Font font, const char *text, Rectangle rec, float fontSize, float spacing, Color color);
+void DrawQuestionText(const QuestionView *view, int option, Rectangle rec, TextStyle style, Color color);
+void DrawQuestionImage(const char *path, Rectangle area);
+void DrawQuestionTexts(const QuestionView *view, Vector2 offset);
+void InitQuestionCards(void);
+void UnloadQuestionCards(void);
+void PrepareQuestionCards(void);
 
 //---------------------------------------------
 // Funções do Jogo
 //---------------------------------------------
 void GoToMenu(void) {
+    FinishQuiz();
     if (IsMusicStreamPlaying(rainMusic)) StopMusicStream(rainMusic);
     ResetWaterFx();
     currentScreen = SCREEN_MENU;
@@ -92,6 +119,7 @@ void GoToMenu(void) {
 
 void StartGame() { 
     SelectAndShuffleQuizQuestions(questionOrder); 
+    quizNumber++; // os cartões do quiz anterior deixam de valer
     currentQuestionIndex = 0; 
     ResetPlayerScore(); 
     selectedAnswer = -1; 
@@ -99,48 +127,100 @@ void StartGame() {
     questionTimer = QUESTION_TIME; 
 }
 
-// <<< CORREÇÃO: Trocado 'char' por 'char *' em textCopy e 'MemFree(textCopy)' >>>
-void DrawTextWrappedCentered(Font font, const char *text, Rectangle rec, float fontSize, float textSpacing, Color color) { 
-    char textToProcess[1024]; 
-    strcpy(textToProcess, text); 
-    char lines[20][256]; 
-    int lineCount = 0; 
-    char *textCopy = (char*)MemAlloc(strlen(textToProcess) + 1); // <<< DEVE SER char*
-    if (textCopy == NULL) return; // Checagem de alocação
-    strcpy(textCopy, textToProcess); 
-    char *word = strtok(textCopy, " "); 
-    char currentLine[256] = { 0 }; 
-    while (word != NULL) { 
-        char testLine[256]; 
-        strcpy(testLine, currentLine); 
-        if (strlen(currentLine) > 0) strcat(testLine, " "); 
-        strcat(testLine, word); 
-        if (MeasureTextEx(font, testLine, fontSize, textSpacing).x > rec.width) { 
-            strcpy(lines[lineCount], currentLine); 
-            lineCount++; 
-            strcpy(currentLine, word); 
-        } else { 
-            strcpy(currentLine, testLine); 
-        } 
-        word = strtok(NULL, " "); 
-    } 
-    strcpy(lines[lineCount], currentLine); 
-    lineCount++; 
-    MemFree(textCopy); // <<< Deve receber o ponteiro
-    float totalTextHeight = lineCount * fontSize + (lineCount - 1) * textSpacing; 
-    float startY = rec.y + (rec.height - totalTextHeight) / 2; 
-    for (int i = 0; i < lineCount; i++) { 
-        float lineWidth = MeasureTextEx(font, lines[i], fontSize, textSpacing).x; 
-        float startX = rec.x + (rec.width - lineWidth) / 2; 
-        DrawTextEx(font, lines[i], (Vector2){startX, startY + i * (fontSize + textSpacing)}, fontSize, textSpacing, color); 
-    } 
+// Enunciado (option = -1) ou alternativa da pergunta; usa o layout do pack quando houver.
+// Fica na fonte SDF (e não na do tamanho fixo): é para ela que os layouts foram calculados.
+void DrawQuestionText(const QuestionView *view, int option, Rectangle rec, TextStyle style, Color color) {
+    const char *text = (option < 0) ? view->question.questionText : view->question.options[option];
+    const TextLayout *layout = (option < 0) ? view->textLayout : view->optionLayouts[option];
+    if (view->layoutFontBaseSize != fontMontserrat.baseSize) layout = NULL;
+    if (layout != NULL) DrawTextLayoutCentered(fontMontserrat, text, layout, rec, style.fontSize, style.spacing, color);
+    else DrawTextWrappedCentered(fontMontserrat, text, rec, style.fontSize, style.spacing, color);
+}
+
+// Enunciado e alternativas, deslocados por 'offset' (para desenhar dentro de um cartão).
+void DrawQuestionTexts(const QuestionView *view, Vector2 offset) {
+    BeginGameText();
+    Rectangle rec = questionTextRect;
+    DrawQuestionText(view, -1, (Rectangle){ rec.x + offset.x, rec.y + offset.y, rec.width, rec.height }, QUESTION_TEXT_STYLE, WHITE);
+    for (int i = 0; i < 4; i++) {
+        rec = optionTextRects[i];
+        DrawQuestionText(view, i, (Rectangle){ rec.x + offset.x, rec.y + offset.y, rec.width, rec.height }, OPTION_TEXT_STYLE, WHITE);
+    }
+    EndGameText();
+}
+
+void InitQuestionCards(void) {
+    const char *cards = getenv("QUIZ_CARDS");
+    if (cards != NULL && strcmp(cards, "0") == 0) return;
+    Rectangle area = CARD_AREA;
+    useQuestionCards = true;
+    for (int i = 0; i < 2; i++) {
+        questionCards[i] = (QuestionCard){ LoadRenderTexture((int)area.width, (int)area.height), -1, 0 };
+        if (questionCards[i].target.id == 0) useQuestionCards = false;
+    }
+    if (!useQuestionCards) {
+        fprintf(stderr, "[Quiz] Aviso: sem render texture; os textos das perguntas são desenhados a cada frame.\n");
+        UnloadQuestionCards();
+    }
+}
+
+void UnloadQuestionCards(void) {
+    for (int i = 0; i < 2; i++) {
+        if (questionCards[i].target.id != 0) UnloadRenderTexture(questionCards[i].target);
+        questionCards[i] = (QuestionCard){ 0 };
+    }
+    useQuestionCards = false;
+}
+
+static QuestionCard *FindQuestionCard(int position) {
+    for (int i = 0; i < 2; i++) {
+        if (questionCards[i].quiz == quizNumber && questionCards[i].position == position) return &questionCards[i];
+    }
+    return NULL;
+}
+
+// Desenha os textos da pergunta 'position' no cartão que não está na tela. A textura guarda
+// cor pré-multiplicada e alfa correto (fator separado para o alfa), para a borda suavizada
+// das letras sair igual à do desenho direto quando o cartão é copiado para a tela.
+static void RenderQuestionCard(int position) {
+    QuestionCard *card = &questionCards[0];
+    if (card->quiz == quizNumber && card->position == currentQuestionIndex) card = &questionCards[1];
+    Rectangle area = CARD_AREA;
+    BeginTextureMode(card->target);
+    ClearBackground(BLANK);
+    rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+    DrawQuestionTexts(GetQuizQuestion(position), (Vector2){ -area.x, -area.y });
+    EndBlendMode();
+    EndTextureMode();
+    card->quiz = quizNumber;
+    card->position = position;
+}
+
+// Antes de BeginDrawing: garante o cartão da pergunta na tela e, enquanto a resposta é
+// mostrada, desenha o da próxima, para a troca de pergunta não ter trabalho extra.
+void PrepareQuestionCards(void) {
+    if (!useQuestionCards || (currentScreen != SCREEN_GAMEPLAY && currentScreen != SCREEN_SHOW_ANSWER)) return;
+    if (FindQuestionCard(currentQuestionIndex) == NULL) RenderQuestionCard(currentQuestionIndex);
+    int next = currentQuestionIndex + 1;
+    if (currentScreen == SCREEN_SHOW_ANSWER && next < QUIZ_QUESTION_COUNT && FindQuestionCard(next) == NULL) RenderQuestionCard(next);
+}
+
+// Imagem da pergunta ajustada à área sem distorcer; enquanto carrega, a área fica vazia.
+void DrawQuestionImage(const char *path, Rectangle area) {
+    const Texture2D *texture = RequestQuestionImage(path);
+    if (texture == NULL) return;
+    float scale = fminf(area.width / texture->width, area.height / texture->height);
+    Rectangle dest = { area.x + (area.width - texture->width * scale) / 2, area.y + (area.height - texture->height * scale) / 2,
+                       texture->width * scale, texture->height * scale };
+    DrawTexturePro(*texture, (Rectangle){ 0, 0, (float)texture->width, (float)texture->height }, dest, (Vector2){ 0, 0 }, 0.0f, WHITE);
 }
 
 //---------------------------------------------
 // Ponto de Entrada Principal (main)
 //---------------------------------------------
 int main(void) {
-    srand(time(NULL));
+    InitRandomStreams();
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Quiz - Navegando pela ODS 14");
     SetExitKey(KEY_NULL);
     InitAudioDevice();
@@ -152,7 +232,8 @@ int main(void) {
     texLeaderboard = LoadTexture("resources/images/tela_leaderboard.png");
     texCredits = LoadTexture("resources/images/tela_creditos.png");
     texLogo = LoadTexture("resources/images/logo.png");
-    fontMontserrat = LoadFontEx("resources/montserrat.ttf", 256, NULL, 250);
+    LoadGameFont();
+    fontMontserrat = GetGameFont();
 
     selectSfx = LoadSound("resources/sfx/select.mp3");
     buttonSfx = LoadSound("resources/sfx/button.mp3");
@@ -166,6 +247,8 @@ int main(void) {
     InitMusicPlayer();
     InitWaterFx();
     InitializeQuestions();
+    InitQuestionImages();
+    InitQuestionCards();
     InitLeaderboard();
     ResetPlayerScore(); 
     
@@ -175,12 +258,16 @@ int main(void) {
 
     UnloadTexture(texMenu); UnloadTexture(texQuestion); UnloadTexture(texHowToPlay);
     UnloadTexture(texLeaderboard); UnloadTexture(texCredits); UnloadTexture(texLogo);
-    UnloadFont(fontMontserrat);
+    UnloadQuestionCards();
+    UnloadTextLayoutCache();
+    UnloadGameFont();
     UnloadSound(selectSfx); UnloadSound(buttonSfx); UnloadSound(correctSfx);
     UnloadSound(wrongSfx); UnloadSound(typeSfx); UnloadSound(victorySfx);
     UnloadMusicStream(rainMusic);
 
     UnloadMusicPlayer();
+    UnloadQuestionImages();
+    UnloadQuestions();
 
     CloseAudioDevice();
     CloseWindow();
@@ -196,6 +283,7 @@ void UpdateDrawFrame(void) {
     Vector2 mousePos = GetMousePosition();
 
     UpdateMusicPlayer();
+    UpdateQuestionImages();
     UpdateWaterFx(deltaTime, currentTime, mousePos);
     UpdateMusicStream(rainMusic);
 
@@ -250,6 +338,23 @@ void UpdateDrawFrame(void) {
             bool isMouseOverExit = CheckCollisionPointRec(mousePos, btnExit);
             if (isMouseOverExit && !isHoveringBtnExit) PlaySound(selectSfx);
             isHoveringBtnExit = isMouseOverExit;
+
+            if (IsKeyPressed(KEY_L)) {
+                // Próximo idioma das perguntas; o banco dele carrega em segundo plano.
+                int count = (int)(sizeof(questionLocales) / sizeof(questionLocales[0]));
+                int current = 0;
+                while (current < count && strcmp(questionLocales[current], GetRequestedQuestionLocale()) != 0) current++;
+                for (int step = 1; step <= count; step++) {
+                    const char *next = questionLocales[(current + step) % count];
+                    if (SetQuestionLocale(next)) {
+                        PlaySound(buttonSfx);
+                        bool switching = strcmp(next, GetQuestionLocale()) != 0;
+                        snprintf(localeMessage, sizeof(localeMessage), switching ? "Carregando perguntas em: %s" : "Idioma das perguntas: %s", next);
+                        menuNotificationText = localeMessage; menuNotificationTimer = 3.0f;
+                        break;
+                    }
+                }
+            }
             
             if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
                 if (CheckCollisionPointRec(mousePos, btnStart)) {
@@ -280,6 +385,11 @@ void UpdateDrawFrame(void) {
         case SCREEN_GAMEPLAY:
         case SCREEN_SHOW_ANSWER:
         case SCREEN_GAME_OVER: {
+            // A imagem da próxima pergunta carrega enquanto o jogador responde a atual (no modo
+            // adaptativo, só depois da resposta, quando a próxima é escolhida).
+            if ((currentScreen == SCREEN_GAMEPLAY || currentScreen == SCREEN_SHOW_ANSWER) && IsQuizQuestionChosen(currentQuestionIndex + 1)) {
+                PrefetchQuestionImage(GetQuizQuestion(currentQuestionIndex + 1)->image);
+            }
             if (currentScreen == SCREEN_ENTER_NAME) {
                  if (IsWaterAnimationFinished()) {
                     int key = GetKeyPressed();
@@ -295,51 +405,54 @@ void UpdateDrawFrame(void) {
                 questionTimer -= deltaTime;
                 if (questionTimer <= 0) {
                     PlaySound(wrongSfx); isAnswerCorrect = false; selectedAnswer = -1; currentScreen = SCREEN_SHOW_ANSWER; answerTimer = 2.0f;
-                }
-                Rectangle optionClickRects[4] = { { 150, 500, 570, 80 }, { 1200, 500, 570, 80 }, { 150, 720, 570, 80 }, { 1200, 720, 570, 80 } };
-                bool answerConfirmed = false;
-                if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                    for (int i = 0; i < 4; i++) {
-                        if (CheckCollisionPointRec(mousePos, optionClickRects[i])) {
-                            selectedAnswer = i; PlaySound(selectSfx); answerConfirmed = true; break; 
+                    RecordQuizAnswer(questionOrder, currentQuestionIndex, -1, QUESTION_TIME);
+                } else {  // se o tempo acabou neste frame, cliques e teclas já não respondem
+                    Rectangle optionClickRects[4] = { { 150, 500, 570, 80 }, { 1200, 500, 570, 80 }, { 150, 720, 570, 80 }, { 1200, 720, 570, 80 } };
+                    bool answerConfirmed = false;
+                    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+                        for (int i = 0; i < 4; i++) {
+                            if (CheckCollisionPointRec(mousePos, optionClickRects[i])) {
+                                selectedAnswer = i; PlaySound(selectSfx); answerConfirmed = true; break; 
+                            }
                         }
                     }
-                }
                 
-                // <<< CORREÇÃO DE INDENTAÇÃO >>>
-                int keyPressed = -1;
-                if (IsKeyPressed(KEY_A)) {
-                    keyPressed = 0;
-                }
-                if (IsKeyPressed(KEY_B)) {
-                    keyPressed = 1;
-                }
-                if (IsKeyPressed(KEY_C)) {
-                    keyPressed = 2;
-                }
-                if (IsKeyPressed(KEY_D)) {
-                    keyPressed = 3;
-                }
+                    // <<< CORREÇÃO DE INDENTAÇÃO >>>
+                    int keyPressed = -1;
+                    if (IsKeyPressed(KEY_A)) {
+                        keyPressed = 0;
+                    }
+                    if (IsKeyPressed(KEY_B)) {
+                        keyPressed = 1;
+                    }
+                    if (IsKeyPressed(KEY_C)) {
+                        keyPressed = 2;
+                    }
+                    if (IsKeyPressed(KEY_D)) {
+                        keyPressed = 3;
+                    }
                 
-                if (keyPressed != -1) { 
-                    selectedAnswer = keyPressed; 
-                    PlaySound(selectSfx); 
-                }
-                if (IsKeyPressed(KEY_ENTER) && selectedAnswer != -1) { 
-                    answerConfirmed = true; 
-                }
+                    if (keyPressed != -1) { 
+                        selectedAnswer = keyPressed; 
+                        PlaySound(selectSfx); 
+                    }
+                    if (IsKeyPressed(KEY_ENTER) && selectedAnswer != -1) { 
+                        answerConfirmed = true; 
+                    }
 
-                if (answerConfirmed) {
-                    Question q = GetQuestionFromOrder(questionOrder[currentQuestionIndex]);
-                    isAnswerCorrect = (selectedAnswer == q.correctOption);
-                    if (isAnswerCorrect) {
-                        PlaySound(correctSfx); 
-                        int pointsEarned = CalculatePointsEarned(q, questionTimer);
-                        AddToPlayerScore(pointsEarned);
-                        pointsGainedNotification = pointsEarned; 
-                        notificationTimer = 2.0f;
-                    } else { PlaySound(wrongSfx); }
-                    currentScreen = SCREEN_SHOW_ANSWER; answerTimer = 2.0f;
+                    if (answerConfirmed) {
+                        const Question *q = &GetQuizQuestion(currentQuestionIndex)->question;
+                        isAnswerCorrect = (selectedAnswer == q->correctOption);
+                        if (isAnswerCorrect) {
+                            PlaySound(correctSfx); 
+                            int pointsEarned = CalculatePointsEarned(q, questionTimer);
+                            AddToPlayerScore(pointsEarned);
+                            pointsGainedNotification = pointsEarned; 
+                            notificationTimer = 2.0f;
+                        } else { PlaySound(wrongSfx); }
+                        RecordQuizAnswer(questionOrder, currentQuestionIndex, selectedAnswer, QUESTION_TIME - questionTimer);
+                        currentScreen = SCREEN_SHOW_ANSWER; answerTimer = 2.0f;
+                    }
                 }
             } else if (currentScreen == SCREEN_SHOW_ANSWER) {
                 answerTimer -= deltaTime;
@@ -351,6 +464,7 @@ void UpdateDrawFrame(void) {
                         // ==== INÍCIO DA NOVA LÓGICA DE RANKING (SUBSTITUÍDA) ====
                         // =========================================================
                         
+                        FinishQuiz();
                         int finalScore = GetPlayerScore();
                         
                         // 1. Envia o score e ATUALIZA a lista local do Top 6
@@ -397,6 +511,7 @@ void UpdateDrawFrame(void) {
         default: break;
     }
 
+    PrepareQuestionCards();
     BeginDrawing();
     ClearBackground(RAYWHITE);
 
@@ -415,12 +530,12 @@ void UpdateDrawFrame(void) {
             if (CheckCollisionPointRec(mousePos, btnExit)) DrawRectangleLinesEx(btnExit, 4, BLUE);
             if (menuNotificationTimer > 0 && menuNotificationText != NULL) {
                 float alpha = 1.0f; if (menuNotificationTimer < 0.5f) alpha = menuNotificationTimer / 0.5f;
-                Vector2 textSize = MeasureTextEx(fontMontserrat, menuNotificationText, 35, 2);
+                Vector2 textSize = MeasureGameText(menuNotificationText, 35, 2);
                 float rectWidth = textSize.x + 40; float rectHeight = textSize.y + 20;
                 Rectangle notificationRect = {(SCREEN_WIDTH - rectWidth) / 2, 850, rectWidth, rectHeight};
                 DrawRectangleRec(notificationRect, Fade(BLACK, 0.7f * alpha));
                 DrawRectangleLinesEx(notificationRect, 2, Fade(WHITE, alpha));
-                DrawTextEx(fontMontserrat, menuNotificationText, (Vector2){notificationRect.x + 20, notificationRect.y + 10}, 35, 2, Fade(YELLOW, alpha));
+                DrawGameText(menuNotificationText, (Vector2){notificationRect.x + 20, notificationRect.y + 10}, 35, 2, Fade(YELLOW, alpha));
             }
         } break;
         case SCREEN_HOW_TO_PLAY: { DrawTexture(texHowToPlay, 0, 0, WHITE); Rectangle btnBack = { 820, 911, 280, 70 }; if (CheckCollisionPointRec(mousePos, btnBack)) DrawRectangleLinesEx(btnBack, 4, BLUE); } break;
@@ -433,14 +548,14 @@ void UpdateDrawFrame(void) {
             int startY = 420; int stepY = 49; int nameCenterX = 958; int scoreX = 1120; int fontSize = 35; float spacing = 2.0f; 
             for (int i = 0; i < LEADERBOARD_SIZE; i++) { 
                 const char* nameText = leaderboard[i].name; 
-                Vector2 nameTextSize = MeasureTextEx(fontMontserrat, nameText, fontSize, spacing); 
-                DrawTextEx(fontMontserrat, nameText, (Vector2){nameCenterX - (nameTextSize.x / 2), startY + (i * stepY)}, fontSize, spacing, BLACK); 
+                Vector2 nameTextSize = MeasureGameText(nameText, fontSize, spacing); 
+                DrawGameText(nameText, (Vector2){nameCenterX - (nameTextSize.x / 2), startY + (i * stepY)}, fontSize, spacing, BLACK); 
                 const char* scoreText = TextFormat("%03d", leaderboard[i].score); 
-                DrawTextEx(fontMontserrat, scoreText, (Vector2){scoreX, startY + (i * stepY)}, fontSize, spacing, BLACK); 
+                DrawGameText(scoreText, (Vector2){scoreX, startY + (i * stepY)}, fontSize, spacing, BLACK); 
             } 
             if (rankMessage[0] != '\0') { // <<< DESENHA A MENSAGEM SE ELA EXISTIR
-                Vector2 textSize = MeasureTextEx(fontMontserrat, rankMessage, 30, 2);
-                DrawTextEx(fontMontserrat, rankMessage, (Vector2){(SCREEN_WIDTH - textSize.x) / 2, 750}, 30, 2, BLACK);
+                Vector2 textSize = MeasureGameText(rankMessage, 30, 2);
+                DrawGameText(rankMessage, (Vector2){(SCREEN_WIDTH - textSize.x) / 2, 750}, 30, 2, BLACK);
             }
         } break;
         // <<< CORREÇÃO DA LINHA TRUNCADA >>>
@@ -451,18 +566,18 @@ void UpdateDrawFrame(void) {
             if (IsWaterAnimationFinished()) { 
                 subtitle = "Digite suas iniciais (3 letras):"; 
             } 
-            DrawTextEx(fontMontserrat, title, (Vector2){SCREEN_WIDTH/2 - MeasureTextEx(fontMontserrat, title, 60, 2).x/2, 300}, 60, 2, RAYWHITE); 
-            DrawTextEx(fontMontserrat, subtitle, (Vector2){SCREEN_WIDTH/2 - MeasureTextEx(fontMontserrat, subtitle, 40, 2).x/2, 500}, 40, 2, LIGHTGRAY); 
+            DrawGameText(title, (Vector2){SCREEN_WIDTH/2 - MeasureGameText(title, 60, 2).x/2, 300}, 60, 2, RAYWHITE); 
+            DrawGameText(subtitle, (Vector2){SCREEN_WIDTH/2 - MeasureGameText(subtitle, 40, 2).x/2, 500}, 40, 2, LIGHTGRAY); 
             if (IsWaterAnimationFinished()) { 
                 const char* hint = "Pressione ENTER para iniciar o quiz"; 
                 DrawRectangle(SCREEN_WIDTH/2 - 150, 560, 300, 80, RAYWHITE); 
                 DrawRectangleLines(SCREEN_WIDTH/2 - 150, 560, 300, 80, DARKGRAY); 
-                DrawTextEx(fontMontserrat, playerName, (Vector2){SCREEN_WIDTH/2 - MeasureTextEx(fontMontserrat, playerName, 60, 2).x/2, 570}, 60, 2, DARKBLUE); 
+                DrawGameText(playerName, (Vector2){SCREEN_WIDTH/2 - MeasureGameText(playerName, 60, 2).x/2, 570}, 60, 2, DARKBLUE); 
                 if (nameCharCount < MAX_NAME_LENGTH && ((int)(GetTime()*2.0f)) % 2 == 0) { 
-                    Vector2 textSize = MeasureTextEx(fontMontserrat, playerName, 60, 2); 
-                    DrawTextEx(fontMontserrat, "_", (Vector2){SCREEN_WIDTH/2 - textSize.x/2 + textSize.x, 570}, 60, 2, DARKBLUE); 
+                    Vector2 textSize = MeasureGameText(playerName, 60, 2); 
+                    DrawGameText("_", (Vector2){SCREEN_WIDTH/2 - textSize.x/2 + textSize.x, 570}, 60, 2, DARKBLUE); 
                 } 
-                DrawTextEx(fontMontserrat, hint, (Vector2){SCREEN_WIDTH/2 - MeasureTextEx(fontMontserrat, hint, 30, 2).x/2, 700}, 30, 2, LIGHTGRAY); 
+                DrawGameText(hint, (Vector2){SCREEN_WIDTH/2 - MeasureGameText(hint, 30, 2).x/2, 700}, 30, 2, LIGHTGRAY); 
             } 
         } break;
         case SCREEN_GAMEPLAY: case SCREEN_SHOW_ANSWER: { 
@@ -479,10 +594,18 @@ void UpdateDrawFrame(void) {
                 DrawRectangle(barX, 80, barWidth * timerPercentage, 30, timerColor); 
                 DrawRectangleLines(barX, 80, barWidth, 30, DARKBLUE); 
             } 
-            Question q = GetQuestionFromOrder(questionOrder[currentQuestionIndex]); 
-            Rectangle questionRec = { 157, 243, 1595, 155 }; 
-            DrawTextWrappedCentered(fontMontserrat, q.questionText, questionRec, 40, 5, WHITE); 
-            Rectangle optionTextRects[4] = { {215, 505, 500, 72}, {1262, 506, 500, 72}, {217, 726, 500, 72}, {1258, 732, 500, 72} }; 
+            const QuestionView *view = GetQuizQuestion(currentQuestionIndex); 
+            const Question *q = &view->question; 
+            const QuestionCard *card = useQuestionCards ? FindQuestionCard(currentQuestionIndex) : NULL; 
+            if (card != NULL) { 
+                Rectangle area = CARD_AREA; 
+                BeginBlendMode(BLEND_ALPHA_PREMULTIPLY); 
+                DrawTextureRec(card->target.texture, (Rectangle){ 0, 0, area.width, -area.height }, (Vector2){ area.x, area.y }, WHITE); // render texture fica de cabeça para baixo
+                EndBlendMode(); 
+            } else { 
+                DrawQuestionTexts(view, (Vector2){ 0, 0 }); 
+            } 
+            if (view->image != NULL) DrawQuestionImage(view->image, (Rectangle){ 770, 430, 380, 380 }); // entre as colunas de alternativas
             const char* optionLetters[] = {"A", "B", "C", "D"}; 
             Vector2 letterPositions[] = { {157, 503}, {1204, 504}, {159, 724}, {1200, 730} }; 
             for (int i = 0; i < 4; i++) { 
@@ -490,36 +613,27 @@ void UpdateDrawFrame(void) {
                 if (currentScreen == SCREEN_GAMEPLAY) { 
                     if (i == selectedAnswer) letterColor = YELLOW; 
                 } else if (currentScreen == SCREEN_SHOW_ANSWER) { 
-                    if (i == q.correctOption) letterColor = GREEN; 
+                    if (i == q->correctOption) letterColor = GREEN; 
                     else if (i == selectedAnswer && !isAnswerCorrect) letterColor = RED; 
-                    else if (selectedAnswer == -1 && i == q.correctOption) letterColor = ORANGE;
+                    else if (selectedAnswer == -1 && i == q->correctOption) letterColor = ORANGE;
                 } 
-                DrawTextEx(fontMontserrat, optionLetters[i], letterPositions[i], 73, 2.0f, letterColor); 
-                DrawTextWrappedCentered(fontMontserrat, q.options[i], optionTextRects[i], 36, 3, WHITE); 
+                DrawGameText(optionLetters[i], letterPositions[i], 73, 2.0f, letterColor); 
             } 
             const char* questionTextStr = TextFormat("Questao: %02d/%d", currentQuestionIndex + 1, QUIZ_QUESTION_COUNT); 
-            DrawTextEx(fontMontserrat, questionTextStr, (Vector2){40, 30}, 40, 2.0f, DARKBLUE); 
+            DrawGameText(questionTextStr, (Vector2){40, 30}, 40, 2.0f, DARKBLUE); 
             
-            const char* difficultyText = "---"; // <<< CORREÇÃO DE WARNING
-            Color difficultyColor = GRAY;   // <<< CORREÇÃO DE WARNING
-            switch(q.difficulty) { 
-                case EASY: difficultyText = "FACIL"; difficultyColor = GREEN; break; 
-                case MEDIUM: difficultyText = "MEDIA"; difficultyColor = YELLOW; break; 
-                case HARD: difficultyText = "DIFICIL"; difficultyColor = RED; break; 
-                default: break; // Default é coberto pela inicialização
-            } 
-            DrawTextEx(fontMontserrat, difficultyText, (Vector2){40, 85}, 30, 2.0f, difficultyColor); 
+            DrawGameText(view->difficultyLabel, (Vector2){40, 85}, 30, 2.0f, view->difficultyColor); 
             
             DrawTexture(texLogo, 0, 0, WHITE); 
             const char* scoreText = TextFormat("Pontos: %03d", GetPlayerScore()); 
-            DrawTextEx(fontMontserrat, scoreText, (Vector2){1650, 30}, 40, 2.0f, DARKBLUE); 
+            DrawGameText(scoreText, (Vector2){1650, 30}, 40, 2.0f, DARKBLUE); 
             
             if (notificationTimer > 0) { 
                 const char* notificationText = TextFormat("+%d PONTOS", pointsGainedNotification); 
-                Vector2 scoreTextSize = MeasureTextEx(fontMontserrat, scoreText, 40, 2.0f); 
+                Vector2 scoreTextSize = MeasureGameText(scoreText, 40, 2.0f); 
                 // Vector2 notificationTextSize; // <<< CORREÇÃO DE WARNING
                 float alpha = notificationTimer / 2.0f; 
-                DrawTextEx(fontMontserrat, notificationText, (Vector2){1650 + (scoreTextSize.x / 4), 30 + 45}, 25, 2.0f, Fade(GREEN, alpha)); 
+                DrawGameText(notificationText, (Vector2){1650 + (scoreTextSize.x / 4), 30 + 45}, 25, 2.0f, Fade(GREEN, alpha)); 
             } 
         } break;
         case SCREEN_GAME_OVER: { 
@@ -527,9 +641,9 @@ void UpdateDrawFrame(void) {
             const char* title = "FIM DE JOGO!"; 
             const char* scoreText = TextFormat("Sua pontuacao final: %d", GetPlayerScore()); 
             const char* hint = "Pressione ENTER para ver o placar"; 
-            DrawTextEx(fontMontserrat, title, (Vector2){SCREEN_WIDTH/2 - MeasureTextEx(fontMontserrat, title, 80, 2).x/2, 350}, 80, 2, RAYWHITE); 
-            DrawTextEx(fontMontserrat, scoreText, (Vector2){SCREEN_WIDTH/2 - MeasureTextEx(fontMontserrat, scoreText, 50, 2).x/2, 500}, 50, 2, RAYWHITE); 
-            DrawTextEx(fontMontserrat, hint, (Vector2){SCREEN_WIDTH/2 - MeasureTextEx(fontMontserrat, hint, 30, 2).x/2, 700}, 30, 2, LIGHTGRAY); 
+            DrawGameText(title, (Vector2){SCREEN_WIDTH/2 - MeasureGameText(title, 80, 2).x/2, 350}, 80, 2, RAYWHITE); 
+            DrawGameText(scoreText, (Vector2){SCREEN_WIDTH/2 - MeasureGameText(scoreText, 50, 2).x/2, 500}, 50, 2, RAYWHITE); 
+            DrawGameText(hint, (Vector2){SCREEN_WIDTH/2 - MeasureGameText(hint, 30, 2).x/2, 700}, 30, 2, LIGHTGRAY); 
         } break;
         default: break;
     }
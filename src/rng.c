@@ -0,0 +1,114 @@
+/**
+ * @file rng.c
+ * @author Grupo 1
+ * @brief Implementação do gerador de números aleatórios (PCG32 XSH-RR).
+ * @version 1.0
+ * @copyright Copyright (c) 2025
+ *
+ * PCG32: estado de 64 bits avançado por uma congruência linear e saída de 32 bits por
+ * xorshift e rotação. Os fluxos usam a mesma semente com incrementos diferentes, o que
+ * dá sequências independentes. Inteiros limitados usam o método de Lemire
+ * (multiplicação de 64 bits, sem divisão no caso comum).
+ */
+
+#include "raylib/rng.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+//---------------------------------------------
+// Definições e Constantes (Privadas ao Módulo)
+//---------------------------------------------
+#define PCG_MULTIPLIER 6364136223846793005ULL
+
+//---------------------------------------------
+// Variáveis Estáticas (Privadas ao Módulo)
+//---------------------------------------------
+static Rng streams[RNG_STREAM_COUNT];
+static uint64_t currentSeed = 0;
+
+//---------------------------------------------
+// Funções Privadas
+//---------------------------------------------
+static void SeedStream(Rng *rng, uint64_t seed, uint64_t sequence) {
+    rng->state = 0;
+    rng->increment = (sequence << 1) | 1u;
+    RngNext(rng);
+    rng->state += seed;
+    RngNext(rng);
+}
+
+//---------------------------------------------
+// Implementação das Funções Públicas
+//---------------------------------------------
+
+void InitRandomStreams(void) {
+    const char *text = getenv("QUIZ_SEED");
+    char *end = NULL;
+    uint64_t seed = (text != NULL) ? (uint64_t)strtoull(text, &end, 0) : 0;
+    if (text == NULL || end == text || *end != '\0') {
+        if (text != NULL) fprintf(stderr, "[Rng] Aviso: QUIZ_SEED inválida ('%s'), usando o relógio.\n", text);
+        seed = (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32);
+    }
+    SeedRandomStreams(seed);
+    fprintf(stderr, "[Rng] Semente: %llu (QUIZ_SEED=%llu repete a partida).\n", (unsigned long long)seed, (unsigned long long)seed);
+}
+
+void SeedRandomStreams(uint64_t seed) {
+    currentSeed = seed;
+    for (int i = 0; i < RNG_STREAM_COUNT; i++) SeedStream(&streams[i], seed, (uint64_t)i);
+}
+
+uint64_t GetRandomSeed(void) {
+    return currentSeed;
+}
+
+Rng *GetRandomStream(RngStream stream) {
+    return &streams[stream];
+}
+
+uint32_t RngNext(Rng *rng) {
+    uint64_t old = rng->state;
+    rng->state = old * PCG_MULTIPLIER + rng->increment;
+    uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+    uint32_t rotation = (uint32_t)(old >> 59);
+    return (xorshifted >> rotation) | (xorshifted << ((32u - rotation) & 31u));
+}
+
+uint32_t RngBelow(Rng *rng, uint32_t bound) {
+    uint64_t product = (uint64_t)RngNext(rng) * bound;
+    uint32_t low = (uint32_t)product;
+    if (low < bound) {
+        // Rejeita a pequena faixa que daria mais peso a alguns resultados.
+        uint32_t threshold = (uint32_t)(-bound) % bound;
+        while (low < threshold) {
+            product = (uint64_t)RngNext(rng) * bound;
+            low = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
+}
+
+int RngRange(Rng *rng, int min, int max) {
+    if (max < min) {
+        int temp = min;
+        min = max;
+        max = temp;
+    }
+    uint32_t span = (uint32_t)((int64_t)max - min) + 1u;
+    if (span == 0) return (int)RngNext(rng);   // o intervalo inteiro de 32 bits
+    return (int)((int64_t)min + RngBelow(rng, span));
+}
+
+float RngFloat(Rng *rng, float min, float max) {
+    return min + (max - min) * ((float)(RngNext(rng) >> 8) * (1.0f / 16777216.0f));
+}
+
+void RngShuffle(Rng *rng, int *array, int size) {
+    for (int i = size - 1; i > 0; i--) {
+        int j = (int)RngBelow(rng, (uint32_t)i + 1u);
+        int temp = array[i];
+        array[i] = array[j];
+        array[j] = temp;
+    }
+}
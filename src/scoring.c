@@ -2,7 +2,7 @@
  * @file scoring.c
  * @author Grupo 1
  * @brief Implementação do módulo de Pontuação.
- * @version 1.0
+ * @version 1.1
  * @copyright Copyright (c) 2025
  */
 
@@ -22,8 +22,8 @@ void ResetPlayerScore(void) {
     currentPlayerScore = 0;
 }
 
-int CalculatePointsEarned(Question q, float timeRemaining) {
-    int basePoints = q.points;
+int CalculatePointsEarned(const Question *q, float timeRemaining) {
+    int basePoints = q->points;
     float timeFactor = timeRemaining / QUESTION_TIME; // Proporção do tempo restante
     
     // Garante que o fator de tempo não seja negativo se o timer estourar um pouco
@@ -0,0 +1,241 @@
+/**
+ * @file text_layout.c
+ * @author Grupo 1
+ * @brief Implementação do desenho de textos quebrados em linhas e centralizados, com cache.
+ * @version 1.1
+ * @copyright Copyright (c) 2025
+ *
+ * Os retângulos guardados são os mesmos que DrawTextEx calcularia (DrawTextCodepoint:
+ * deslocamento e padding do glyph na escala do tamanho), então o texto sai idêntico.
+ * A chave confere o texto inteiro, e não só o ponteiro: um banco recarregado pode usar o
+ * mesmo endereço para outro texto.
+ */
+
+#include "raylib/text_layout.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+//---------------------------------------------
+// Definições e Constantes (Privadas ao Módulo)
+//---------------------------------------------
+
+typedef struct {
+    Rectangle source;   // no atlas da fonte
+    Rectangle dest;     // na tela
+} GlyphQuad;
+
+typedef struct {
+    uint64_t hash;          // do texto e das linhas do pack
+    char *text;             // cópia; NULL = posição livre
+    unsigned int fontTexture;
+    int fontBaseSize;
+    float fontSize;
+    float spacing;
+    Rectangle rec;
+    bool packed;            // linhas vindas do pack, e não de WrapTextLines
+    GlyphQuad *quads;
+    int quadCount;
+    unsigned long lastUsed;
+} CachedText;
+
+static CachedText cache[TEXT_LAYOUT_CACHE_SIZE];
+static unsigned long useCounter = 0;
+
+//---------------------------------------------
+// Funções Privadas
+//---------------------------------------------
+
+// FNV-1a de 64 bits do texto e, se houver, das linhas do pack.
+static uint64_t HashText(const char *text, const TextLayout *layout) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char *p = (const unsigned char *)text; *p != '\0'; p++) {
+        hash ^= *p;
+        hash *= 1099511628211ULL;
+    }
+    const unsigned char *lines = (const unsigned char *)layout;
+    for (size_t i = 0; layout != NULL && i < sizeof(*layout); i++) {
+        hash ^= lines[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Largura de um caractere, como MeasureTextEx a soma (sem o espaçamento).
+static float GlyphAdvance(Font font, int codepoint, float scale) {
+    int index = GetGlyphIndex(font, codepoint);
+    if (font.glyphs[index].advanceX != 0) return (float)font.glyphs[index].advanceX * scale;
+    return (font.recs[index].width + (float)font.glyphs[index].offsetX) * scale;
+}
+
+static void FreeEntry(CachedText *entry) {
+    free(entry->text);
+    free(entry->quads);
+    memset(entry, 0, sizeof(*entry));
+}
+
+static bool SameKey(const CachedText *entry, uint64_t hash, const char *text, Font font, float fontSize, float spacing,
+                    Rectangle rec, bool packed) {
+    return entry->text != NULL && entry->hash == hash && entry->fontTexture == font.texture.id && entry->fontBaseSize == font.baseSize
+        && entry->fontSize == fontSize && entry->spacing == spacing && entry->packed == packed && entry->rec.x == rec.x
+        && entry->rec.y == rec.y && entry->rec.width == rec.width && entry->rec.height == rec.height && strcmp(entry->text, text) == 0;
+}
+
+// Calcula os retângulos de cada caractere visível das linhas, centralizadas em 'rec'.
+// Retorna false se faltar memória.
+static bool BuildQuads(CachedText *entry, Font font, const char *text, size_t textLength, const TextLayoutLine *lines, int lineCount) {
+    int glyphCount = 0;
+    for (int i = 0; i < lineCount; i++) glyphCount += lines[i].length;     // limite: um caractere por byte
+    entry->quads = malloc((size_t)(glyphCount > 0 ? glyphCount : 1) * sizeof(GlyphQuad));
+    if (entry->quads == NULL) return false;
+
+    float scale = entry->fontSize / (float)font.baseSize;
+    float padding = (float)font.glyphPadding;
+    float totalTextHeight = lineCount * entry->fontSize + (lineCount - 1) * entry->spacing;
+    float y = entry->rec.y + (entry->rec.height - totalTextHeight) / 2;
+    entry->quadCount = 0;
+    for (int i = 0; i < lineCount; i++, y += entry->fontSize + entry->spacing) {
+        if ((size_t)lines[i].start + lines[i].length > textLength) continue;  // layout de um pack corrompido
+        const char *line = text + lines[i].start;
+        float x = entry->rec.x + (entry->rec.width - lines[i].width) / 2;
+        for (int p = 0; p < lines[i].length;) {
+            int bytes = 0;
+            int codepoint = GetCodepointNext(line + p, &bytes);
+            int index = GetGlyphIndex(font, codepoint);
+            if (codepoint != ' ' && codepoint != '\t') {
+                Rectangle glyph = font.recs[index];
+                entry->quads[entry->quadCount++] = (GlyphQuad){
+                    { glyph.x - padding, glyph.y - padding, glyph.width + 2.0f * padding, glyph.height + 2.0f * padding },
+                    { x + (font.glyphs[index].offsetX - padding) * scale, y + (font.glyphs[index].offsetY - padding) * scale,
+                      (glyph.width + 2.0f * padding) * scale, (glyph.height + 2.0f * padding) * scale }
+                };
+            }
+            x += ((font.glyphs[index].advanceX != 0) ? font.glyphs[index].advanceX * scale : font.recs[index].width * scale) + entry->spacing;
+            p += bytes;
+        }
+    }
+    return true;
+}
+
+// Acha o texto no cache ou o monta numa posição livre (ou na de uso mais antigo).
+// 'layout' NULL quebra as linhas com WrapTextLines. Retorna NULL se faltar memória.
+static const CachedText *FindOrBuild(Font font, const char *text, const TextLayout *layout, Rectangle rec, float fontSize, float spacing) {
+    uint64_t hash = HashText(text, layout);
+    bool packed = layout != NULL;
+    CachedText *slot = &cache[0];
+    useCounter++;
+    for (int i = 0; i < TEXT_LAYOUT_CACHE_SIZE; i++) {
+        if (SameKey(&cache[i], hash, text, font, fontSize, spacing, rec, packed)) {
+            cache[i].lastUsed = useCounter;
+            return &cache[i];
+        }
+        if (slot->text != NULL && (cache[i].text == NULL || cache[i].lastUsed < slot->lastUsed)) slot = &cache[i];
+    }
+
+    FreeEntry(slot);
+    size_t length = strlen(text) + 1;
+    slot->text = malloc(length);
+    if (slot->text == NULL) return NULL;
+    memcpy(slot->text, text, length);
+    *slot = (CachedText){ hash, slot->text, font.texture.id, font.baseSize, fontSize, spacing, rec, packed, NULL, 0, useCounter };
+
+    TextLayoutLine wrapped[WRAP_MAX_LINES];
+    const TextLayoutLine *lines = packed ? layout->lines : wrapped;
+    int lineCount = packed ? layout->lineCount : WrapTextLines(font, text, fontSize, spacing, rec.width, wrapped, WRAP_MAX_LINES);
+    if (lineCount > (packed ? TEXT_LAYOUT_MAX_LINES : WRAP_MAX_LINES)) lineCount = 0;  // layout de um pack corrompido
+    if (!BuildQuads(slot, font, text, length - 1, lines, lineCount)) {
+        FreeEntry(slot);
+        return NULL;
+    }
+    return slot;
+}
+
+static void DrawCachedText(Font font, const char *text, const TextLayout *layout, Rectangle rec, float fontSize, float spacing, Color color) {
+    const CachedText *entry = FindOrBuild(font, text, layout, rec, fontSize, spacing);
+    if (entry == NULL) return;
+    for (int i = 0; i < entry->quadCount; i++) {
+        DrawTexturePro(font.texture, entry->quads[i].source, entry->quads[i].dest, (Vector2){ 0, 0 }, 0.0f, color);
+    }
+}
+
+//---------------------------------------------
+// Implementação das Funções Públicas
+//---------------------------------------------
+
+// Quebra gulosa por palavras, direto sobre o texto (cada linha é um trecho dele, nada é
+// copiado). O texto é percorrido por caractere UTF-8 (GetCodepointNext), então as larguras
+// batem com as do MeasureTextEx com qualquer acentuação, e uma palavra mais larga que a área
+// é partida entre dois caracteres, nunca no meio de um. '\n' força a quebra.
+// WrapLines, em tools/question_compiler.c, repete esta quebra para os layouts do pack:
+// mudar uma é mudar a outra.
+int WrapTextLines(Font font, const char *text, float fontSize, float spacing, float maxWidth, TextLayoutLine *lines, int maxLines) {
+    float scale = fontSize / (float)font.baseSize;
+    float spaceWidth = GlyphAdvance(font, ' ', scale);
+    int lineCount = 0;
+    int lineStart = 0, lineEnd = 0;     // linha atual: [lineStart, lineEnd)
+    float lineWidth = 0.0f;
+    int i = 0;
+    while (text[i] != '\0' && lineCount < maxLines && i < 0xFFFF) {  // deslocamentos de 16 bits
+        if (text[i] == ' ' || text[i] == '\t' || text[i] == '\r') { i++; continue; }
+        if (text[i] == '\n') {
+            lines[lineCount++] = (TextLayoutLine){ (unsigned short)lineStart, (unsigned short)(lineEnd - lineStart), lineWidth };
+            lineStart = lineEnd = ++i;
+            lineWidth = 0.0f;
+            continue;
+        }
+        int wordStart = i;
+        float wordWidth = 0.0f;
+        while (text[i] != '\0' && text[i] != ' ' && text[i] != '\t' && text[i] != '\r' && text[i] != '\n') {
+            int bytes = 0;
+            int codepoint = GetCodepointNext(text + i, &bytes);
+            wordWidth += GlyphAdvance(font, codepoint, scale) + ((i > wordStart) ? spacing : 0.0f);
+            i += bytes;
+        }
+        if (lineEnd > lineStart) {
+            float joined = lineWidth + spacing + spaceWidth + spacing + wordWidth;
+            if (joined <= maxWidth) {
+                lineEnd = i;
+                lineWidth = joined;
+                continue;
+            }
+            lines[lineCount++] = (TextLayoutLine){ (unsigned short)lineStart, (unsigned short)(lineEnd - lineStart), lineWidth };
+            if (lineCount >= maxLines) break;
+        }
+        lineStart = wordStart;
+        lineEnd = i;
+        lineWidth = wordWidth;
+        // Palavra sozinha mais larga que a área: sai em pedaços de caracteres inteiros, e o
+        // último pedaço fica como linha atual, para a palavra seguinte poder se juntar a ele.
+        for (int p = wordStart; lineWidth > maxWidth && lineCount < maxLines;) {
+            int pieceStart = p;
+            float pieceWidth = 0.0f;
+            while (p < i) {
+                int bytes = 0;
+                float advance = GlyphAdvance(font, GetCodepointNext(text + p, &bytes), scale) + ((p > pieceStart) ? spacing : 0.0f);
+                if (p > pieceStart && pieceWidth + advance > maxWidth) break;
+                pieceWidth += advance;
+                p += bytes;
+            }
+            if (p >= i) break;
+            lines[lineCount++] = (TextLayoutLine){ (unsigned short)pieceStart, (unsigned short)(p - pieceStart), pieceWidth };
+            lineStart = p;
+            lineWidth -= pieceWidth + spacing;
+        }
+    }
+    if (lineEnd > lineStart && lineCount < maxLines) {
+        lines[lineCount++] = (TextLayoutLine){ (unsigned short)lineStart, (unsigned short)(lineEnd - lineStart), lineWidth };
+    }
+    return lineCount;
+}
+
+void DrawTextWrappedCentered(Font font, const char *text, Rectangle rec, float fontSize, float spacing, Color color) {
+    DrawCachedText(font, text, NULL, rec, fontSize, spacing, color);
+}
+
+void DrawTextLayoutCentered(Font font, const char *text, const TextLayout *layout, Rectangle rec, float fontSize, float spacing, Color color) {
+    DrawCachedText(font, text, layout, rec, fontSize, spacing, color);
+}
+
+void UnloadTextLayoutCache(void) {
+    for (int i = 0; i < TEXT_LAYOUT_CACHE_SIZE; i++) FreeEntry(&cache[i]);
+}
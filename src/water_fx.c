@@ -7,6 +7,7 @@
  */
 
 #include "raylib/water_fx.h"
+#include "raylib/rng.h"
 #include <math.h>
 
 //---------------------------------------------
@@ -71,14 +72,15 @@ static void InitDrops(void) {
     for (int i = 0; i < MAX_DROPS; i++) {
         activeDrops[i].lifetime = 0.0f;
     }
-    nextDropSpawnTime = GetRandomValue(DROP_SPAWN_INTERVAL_MIN * 100, DROP_SPAWN_INTERVAL_MAX * 100) / 100.0f;
+    nextDropSpawnTime = RngFloat(GetRandomStream(RNG_WATER_FX), DROP_SPAWN_INTERVAL_MIN, DROP_SPAWN_INTERVAL_MAX);
 }
 
 static void InitRaindrops(void) {
+    Rng *rng = GetRandomStream(RNG_WATER_FX);
     for (int i = 0; i < MAX_RAINDROPS; i++) {
-        raindrops[i].startPos = (Vector2){ (float)GetRandomValue(0, SCREEN_WIDTH), (float)GetRandomValue(-SCREEN_HEIGHT, 0) };
-        raindrops[i].length = (float)GetRandomValue(RAINDROP_LENGTH_MIN, RAINDROP_LENGTH_MAX);
-        raindrops[i].speed = (float)GetRandomValue(RAINDROP_SPEED_MIN, RAINDROP_SPEED_MAX);
+        raindrops[i].startPos = (Vector2){ (float)RngRange(rng, 0, SCREEN_WIDTH), (float)RngRange(rng, -SCREEN_HEIGHT, 0) };
+        raindrops[i].length = (float)RngRange(rng, RAINDROP_LENGTH_MIN, RAINDROP_LENGTH_MAX);
+        raindrops[i].speed = (float)RngRange(rng, RAINDROP_SPEED_MIN, RAINDROP_SPEED_MAX);
     }
 }
 
@@ -95,7 +97,8 @@ static void SpawnDropAt(float x, float amplitude) {
 }
 
 static void SpawnRandomDrop(void) {
-    SpawnDropAt((float)GetRandomValue(0, SCREEN_WIDTH), (float)GetRandomValue(DROP_AMPLITUDE_MAX * 50, DROP_AMPLITUDE_MAX * 100) / 100.0f);
+    Rng *rng = GetRandomStream(RNG_WATER_FX);
+    SpawnDropAt((float)RngRange(rng, 0, SCREEN_WIDTH), RngFloat(rng, DROP_AMPLITUDE_MAX * 0.5f, DROP_AMPLITUDE_MAX));
 }
 
 static float GetDropWaveContribution(float x, float currentTime) {
@@ -116,10 +119,11 @@ static float GetDropWaveContribution(float x, float currentTime) {
 }
 
 static void UpdateInternalRaindrops(float deltaTime) {
+    Rng *rng = GetRandomStream(RNG_WATER_FX);
     for (int i = 0; i < MAX_RAINDROPS; i++) {
         raindrops[i].startPos.y += raindrops[i].speed * deltaTime;
         if (raindrops[i].startPos.y > waterLevel + 20) {
-            raindrops[i].startPos = (Vector2){ (float)GetRandomValue(0, SCREEN_WIDTH), (float)GetRandomValue(-400, -50) };
+            raindrops[i].startPos = (Vector2){ (float)RngRange(rng, 0, SCREEN_WIDTH), (float)RngRange(rng, -400, -50) };
         }
     }
 }
@@ -173,7 +177,7 @@ void StartWaterAnimation(void) {
     dropSpawnTimer = 0.0f;
     InitDrops();
     InitRaindrops();
-    nextDropSpawnTime = GetRandomValue(DROP_SPAWN_INTERVAL_MIN * 100, DROP_SPAWN_INTERVAL_MAX * 100) / 100.0f;
+    nextDropSpawnTime = RngFloat(GetRandomStream(RNG_WATER_FX), DROP_SPAWN_INTERVAL_MIN, DROP_SPAWN_INTERVAL_MAX);
 }
 
 void UpdateWaterFx(float deltaTime, float currentTime, Vector2 mousePos) {
@@ -195,7 +199,7 @@ void UpdateWaterFx(float deltaTime, float currentTime, Vector2 mousePos) {
     if (dropSpawnTimer >= nextDropSpawnTime) {
         SpawnRandomDrop();
         dropSpawnTimer = 0.0f;
-        nextDropSpawnTime = GetRandomValue(DROP_SPAWN_INTERVAL_MIN * 100, DROP_SPAWN_INTERVAL_MAX * 100) / 100.0f;
+        nextDropSpawnTime = RngFloat(GetRandomStream(RNG_WATER_FX), DROP_SPAWN_INTERVAL_MIN, DROP_SPAWN_INTERVAL_MAX);
     }
 
     for (int i = 0; i < MAX_DROPS; i++) {
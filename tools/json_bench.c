@@ -0,0 +1,440 @@
+/**
+ * @file json_bench.c
+ * @author Grupo 1
+ * @brief Suíte de micro-benchmarks da camada JSON (cJSON) sobre respostas do Firestore.
+ * @version 2.2
+ * @copyright Copyright (c) 2025
+ *
+ * Para cada tamanho de resposta (por padrão 6, 100 e 10000 documentos) mede:
+ * - parse:        cJSON_Parse + cJSON_Delete, em cada backend de varredura (scalar, sse2, avx2);
+ * - tape:         cJSON_ParseTape + percorrer "documents" + cJSON_DeleteTape, em cada backend;
+ * - parse_pooled: cJSON_Parse + cJSON_Delete com interning de chaves e pool de itens;
+ * - print:        cJSON_PrintUnformatted da árvore já parseada;
+ * - lookup:       fields.name.stringValue e fields.score.integerValue de cada documento;
+ * - delete:       só o cJSON_Delete (o parse fica fora do tempo medido).
+ * Cada linha traz vazão (MB/s da resposta e documentos/s), alocações por documento
+ * e o pico de memória residente do processo até aquela medição.
+ *
+ * Antes das medições, uma validação confere que cJSON_Parse, cJSON_ParseEvents e
+ * cJSON_ParseTape aceitam e rejeitam as mesmas entradas em cada backend (casos de
+ * validationCases, incluindo regressões de escapes); qualquer divergência termina com 1.
+ *
+ * O corpus gravado é replicado textualmente para gerar respostas maiores com a mesma
+ * formatação. Com --jsonl a saída é um objeto JSON por linha, para comparar commits.
+ *
+ * Uso: json_bench [--jsonl] <resposta.json> [documentos...]
+ */
+
+#if !defined(_WIN32)
+    #define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "raylib/cJSON.h"
+
+#if defined(_WIN32)
+    #define NOGDI
+    #define NOMINMAX
+    #define PSAPI_VERSION 2
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+#endif
+
+#define MIN_BENCH_SECONDS 0.5
+#define DEFAULT_SIZES_COUNT 3
+#define RESULT_LINE_SIZE 512
+
+static const int defaultSizes[DEFAULT_SIZES_COUNT] = { 6, 100, 10000 };
+static const char *backends[] = { "scalar", "sse2", "avx2" };
+
+typedef struct {
+    const char *json;
+    size_t size;
+    int docs;
+    cJSON *tree;        // árvore já parseada, usada por print e lookup
+} BenchInput;
+
+typedef struct {
+    double seconds;     // soma apenas das partes medidas
+    long iterations;
+    long allocations;
+} BenchResult;
+
+// Executa uma iteração e retorna o tempo medido, ou < 0 em caso de falha.
+typedef double (*BenchOp)(const BenchInput *input);
+
+typedef struct {
+    const char *json;
+    int valid;
+} ValidationCase;
+
+static const ValidationCase validationCases[] = {
+    { "{\"name\": \"Ana\", \"score\": {\"integerValue\": \"120\"}}", 1 },
+    { "[\"a\\\"b\", \"\\u00e7\\u00e3o\", \"\\uD83D\\uDE00\", 1.5e3, true, null]", 1 },
+    { "\"x\\/\\\"\\\\\\u004\\\"\\,\\n\"", 0 },   // \u com 3 dígitos: o '\"' seguinte não pode virar escape
+    { "\"\\u00zz\"", 0 },
+    { "\"\\uD83D\\u00zz\"", 0 },
+    { "\"\\uDE00\"", 0 },
+    { "\"\\q\"", 0 },
+    { "\"abc", 0 },
+    { "{\"a\": 1,}", 0 },
+};
+
+static long allocationCount = 0;
+static int jsonLines = 0;
+
+//---------------------------------------------
+// Funções Auxiliares
+//---------------------------------------------
+static double Now(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER freq, counter;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+}
+
+// Pico de memória residente do processo em KB (-1 se indisponível).
+static long PeakRssKb(void) {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return -1;
+    return (long)(counters.PeakWorkingSetSize / 1024);
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#if defined(__APPLE__)
+    return (long)(usage.ru_maxrss / 1024); // no macOS o valor vem em bytes
+#else
+    return (long)usage.ru_maxrss;
+#endif
+#endif
+}
+
+// malloc contado, instalado no cJSON via cJSON_InitHooks.
+static void *CountingMalloc(size_t size) {
+    allocationCount++;
+    return malloc(size);
+}
+
+static char *ReadWholeFile(const char *path, size_t *size) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *data = (length >= 0) ? malloc((size_t)length + 1) : NULL;
+    if (data != NULL && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    if (data == NULL) return NULL;
+    data[length] = '\0';
+    *size = (size_t)length;
+    return data;
+}
+
+// Localiza o texto de cada documento do array "documents" (entre '{' e '}' de nível 2).
+static int FindDocuments(const char *json, const char **starts, size_t *lengths, int maxDocs) {
+    const char *p = strstr(json, "\"documents\"");
+    if (p == NULL || (p = strchr(p, '[')) == NULL) return 0;
+    int count = 0, depth = 0;
+    int inString = 0;
+    const char *docStart = NULL;
+    for (p = p + 1; *p != '\0'; p++) {
+        if (inString) {
+            if (*p == '\\' && p[1] != '\0') p++;
+            else if (*p == '"') inString = 0;
+            continue;
+        }
+        if (*p == '"') inString = 1;
+        else if (*p == '{') { if (depth++ == 0) docStart = p; }
+        else if (*p == '}') {
+            if (--depth == 0 && count < maxDocs) {
+                starts[count] = docStart;
+                lengths[count] = (size_t)(p - docStart) + 1;
+                count++;
+            }
+        }
+        else if (*p == ']' && depth == 0) break;
+    }
+    return count;
+}
+
+// Monta uma resposta com 'docCount' documentos, repetindo os documentos gravados.
+static char *BuildResponse(const char *recorded, int docCount, size_t *size) {
+    const char *starts[64];
+    size_t lengths[64];
+    int recordedDocs = FindDocuments(recorded, starts, lengths, 64);
+    if (recordedDocs == 0) return NULL;
+
+    const char *head = "{\n  \"documents\": [\n    ";
+    const char *separator = ",\n    ";
+    const char *tail = "\n  ]\n}\n";
+    size_t capacity = strlen(head) + strlen(tail) + 1;
+    for (int i = 0; i < docCount; i++) capacity += lengths[i % recordedDocs] + strlen(separator);
+
+    char *out = malloc(capacity);
+    if (out == NULL) return NULL;
+    size_t used = 0;
+    memcpy(out + used, head, strlen(head)); used += strlen(head);
+    for (int i = 0; i < docCount; i++) {
+        if (i > 0) { memcpy(out + used, separator, strlen(separator)); used += strlen(separator); }
+        memcpy(out + used, starts[i % recordedDocs], lengths[i % recordedDocs]);
+        used += lengths[i % recordedDocs];
+    }
+    memcpy(out + used, tail, strlen(tail)); used += strlen(tail);
+    out[used] = '\0';
+    *size = used;
+    return out;
+}
+
+//---------------------------------------------
+// Operações Medidas
+//---------------------------------------------
+static double OpParse(const BenchInput *input) {
+    double start = Now();
+    cJSON *root = cJSON_ParseWithLength(input->json, input->size);
+    if (root == NULL) return -1.0;
+    cJSON_Delete(root);
+    return Now() - start;
+}
+
+// Parse em modo tape + percorrer o array "documents" + liberar.
+static double OpTape(const BenchInput *input) {
+    double start = Now();
+    cJSON_Tape *tape = cJSON_ParseTape(input->json, input->size, NULL);
+    if (tape == NULL) return -1.0;
+    size_t documents = cJSON_TapeGetObjectItem(tape, 0, "documents");
+    int visited = 0;
+    for (size_t doc = cJSON_TapeChild(tape, documents); doc != 0; doc = cJSON_TapeNext(tape, doc)) visited++;
+    cJSON_DeleteTape(tape);
+    if (visited != input->docs) return -1.0;
+    return Now() - start;
+}
+
+static double OpPrint(const BenchInput *input) {
+    double start = Now();
+    char *printed = cJSON_PrintUnformatted(input->tree);
+    if (printed == NULL) return -1.0;
+    cJSON_free(printed);
+    return Now() - start;
+}
+
+// Os mesmos campos que o placar lê de cada documento.
+static double OpLookup(const BenchInput *input) {
+    double start = Now();
+    const cJSON *documents = cJSON_GetObjectItemCaseSensitive(input->tree, "documents");
+    const cJSON *doc = NULL;
+    int found = 0;
+    cJSON_ArrayForEach(doc, documents) {
+        const cJSON *fields = cJSON_GetObjectItemCaseSensitive(doc, "fields");
+        const cJSON *name = cJSON_GetObjectItemCaseSensitive(cJSON_GetObjectItemCaseSensitive(fields, "name"), "stringValue");
+        const cJSON *score = cJSON_GetObjectItemCaseSensitive(cJSON_GetObjectItemCaseSensitive(fields, "score"), "integerValue");
+        if (cJSON_IsString(name) && cJSON_IsString(score)) found++;
+    }
+    if (found != input->docs) return -1.0;
+    return Now() - start;
+}
+
+static double OpDelete(const BenchInput *input) {
+    long allocationsBefore = allocationCount;
+    cJSON *root = cJSON_ParseWithLength(input->json, input->size);
+    if (root == NULL) return -1.0;
+    allocationCount = allocationsBefore; // as alocações do parse não contam aqui
+    double start = Now();
+    cJSON_Delete(root);
+    return Now() - start;
+}
+
+// Repete a operação até somar MIN_BENCH_SECONDS de tempo medido.
+static int RunOp(BenchOp op, const BenchInput *input, BenchResult *result) {
+    memset(result, 0, sizeof(*result));
+    long allocationsBefore = allocationCount;
+    do {
+        double elapsed = op(input);
+        if (elapsed < 0.0) return 0;
+        result->seconds += elapsed;
+        result->iterations++;
+    } while (result->seconds < MIN_BENCH_SECONDS);
+    result->allocations = allocationCount - allocationsBefore;
+    return 1;
+}
+
+//---------------------------------------------
+// Validação
+//---------------------------------------------
+static cJSON_bool IgnoreEvent(const cJSON_Event *event, void *userData) {
+    return 1;
+}
+
+// Os três parsers precisam concordar com o esperado de cada caso, em cada backend.
+static int ValidateParsers(void) {
+    int ok = 1;
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++) {
+        if (!cJSON_SetScanBackend(backends[b])) continue;
+        for (size_t c = 0; c < sizeof(validationCases) / sizeof(validationCases[0]); c++) {
+            const ValidationCase *test = &validationCases[c];
+            size_t length = strlen(test->json);
+            cJSON *tree = cJSON_ParseWithLength(test->json, length);
+            cJSON_Tape *tape = cJSON_ParseTape(test->json, length, NULL);
+            int results[3] = { tree != NULL, tape != NULL, cJSON_ParseEvents(test->json, length, IgnoreEvent, NULL, NULL) ? 1 : 0 };
+            const char *parsers[3] = { "parse", "tape", "events" };
+            for (int p = 0; p < 3; p++) {
+                if (results[p] != test->valid) {
+                    fprintf(stderr, "[JsonBench] Erro: %s (%s) %s %s\n", parsers[p], backends[b], results[p] ? "aceitou" : "rejeitou", test->json);
+                    ok = 0;
+                }
+            }
+            cJSON_Delete(tree);
+            cJSON_DeleteTape(tape);
+        }
+    }
+    cJSON_SetScanBackend("auto");
+    return ok;
+}
+
+//---------------------------------------------
+// Saída
+//---------------------------------------------
+static void PrintHeader(void) {
+    if (jsonLines) return;
+    printf("%-13s %-7s %7s %10s %10s %12s %11s %12s\n",
+           "op", "backend", "docs", "bytes", "MB/s", "docs/s", "allocs/doc", "peak RSS KB");
+}
+
+static void PrintResult(const char *op, const char *backend, const BenchInput *input, const BenchResult *result) {
+    double megabytesPerSecond = ((double)input->size * (double)result->iterations) / (result->seconds * 1024.0 * 1024.0);
+    double docsPerSecond = ((double)input->docs * (double)result->iterations) / result->seconds;
+    double allocationsPerDoc = (double)result->allocations / ((double)result->iterations * (double)input->docs);
+    long peakRss = PeakRssKb();
+
+    if (!jsonLines) {
+        printf("%-13s %-7s %7d %10zu %10.1f %12.0f %11.2f %12ld\n",
+               op, backend, input->docs, input->size, megabytesPerSecond, docsPerSecond, allocationsPerDoc, peakRss);
+        return;
+    }
+
+    char line[RESULT_LINE_SIZE];
+    cJSON_Writer writer;
+    cJSON_WriterInit(&writer, line, sizeof(line));
+    cJSON_WriteObjectBegin(&writer);
+    cJSON_WriteKey(&writer, "op");
+    cJSON_WriteString(&writer, op);
+    cJSON_WriteKey(&writer, "backend");
+    cJSON_WriteString(&writer, backend);
+    cJSON_WriteKey(&writer, "docs");
+    cJSON_WriteNumber(&writer, input->docs);
+    cJSON_WriteKey(&writer, "bytes");
+    cJSON_WriteNumber(&writer, (double)input->size);
+    cJSON_WriteKey(&writer, "iterations");
+    cJSON_WriteNumber(&writer, (double)result->iterations);
+    cJSON_WriteKey(&writer, "mb_per_s");
+    cJSON_WriteNumber(&writer, megabytesPerSecond);
+    cJSON_WriteKey(&writer, "docs_per_s");
+    cJSON_WriteNumber(&writer, docsPerSecond);
+    cJSON_WriteKey(&writer, "allocs_per_doc");
+    cJSON_WriteNumber(&writer, allocationsPerDoc);
+    cJSON_WriteKey(&writer, "peak_rss_kb");
+    cJSON_WriteNumber(&writer, (double)peakRss);
+    cJSON_WriteObjectEnd(&writer);
+    if (cJSON_WriterFinish(&writer) != NULL) puts(line);
+}
+
+static int Measure(const char *op, const char *backend, BenchOp fn, const BenchInput *input) {
+    BenchResult result;
+    if (!RunOp(fn, input, &result)) {
+        fprintf(stderr, "[JsonBench] Falha em '%s' (%s) com %d documentos.\n", op, backend, input->docs);
+        return 0;
+    }
+    PrintResult(op, backend, input, &result);
+    return 1;
+}
+
+// Todas as medições para uma resposta.
+static int BenchSize(BenchInput *input) {
+    for (size_t b = 0; b < sizeof(backends) / sizeof(backends[0]); b++) {
+        if (!cJSON_SetScanBackend(backends[b])) continue;
+        if (!Measure("parse", backends[b], OpParse, input)) return 0;
+        if (!Measure("tape", backends[b], OpTape, input)) return 0;
+    }
+    cJSON_SetScanBackend("auto");
+    const char *backend = cJSON_GetScanBackend();
+
+    // Cerca de 30 itens por documento do Firestore; o pool guarda uma árvore inteira.
+    cJSON_SetKeyInterning(1);
+    cJSON_SetItemPoolLimit((size_t)input->docs * 32);
+    int ok = Measure("parse_pooled", backend, OpParse, input);
+    cJSON_SetKeyInterning(0);
+    cJSON_SetItemPoolLimit(0);
+    cJSON_ReleasePools();
+    if (!ok) return 0;
+
+    input->tree = cJSON_ParseWithLength(input->json, input->size);
+    if (input->tree == NULL) return 0;
+    ok = Measure("print", backend, OpPrint, input)
+        && Measure("lookup", backend, OpLookup, input)
+        && Measure("delete", backend, OpDelete, input);
+    cJSON_Delete(input->tree);
+    input->tree = NULL;
+    return ok;
+}
+
+//---------------------------------------------
+// Ponto de Entrada
+//---------------------------------------------
+int main(int argc, char **argv) {
+    int firstArg = 1;
+    if (argc > 1 && strcmp(argv[1], "--jsonl") == 0) {
+        jsonLines = 1;
+        firstArg = 2;
+    }
+    if (argc <= firstArg) {
+        fprintf(stderr, "Uso: %s [--jsonl] <resposta.json> [documentos...]\n", argv[0]);
+        return 1;
+    }
+
+    size_t recordedSize = 0;
+    char *recorded = ReadWholeFile(argv[firstArg], &recordedSize);
+    if (recorded == NULL) {
+        fprintf(stderr, "[JsonBench] Erro ao ler '%s'.\n", argv[firstArg]);
+        return 1;
+    }
+
+    cJSON_Hooks hooks = { CountingMalloc, free };
+    cJSON_InitHooks(&hooks);
+
+    int sizeArgs = argc - firstArg - 1;
+    int sizeCount = (sizeArgs > 0) ? sizeArgs : DEFAULT_SIZES_COUNT;
+    int status = ValidateParsers() ? 0 : 1;
+    if (status == 0) PrintHeader();
+    for (int s = 0; s < sizeCount && status == 0; s++) {
+        BenchInput input;
+        memset(&input, 0, sizeof(input));
+        input.docs = (sizeArgs > 0) ? atoi(argv[firstArg + 1 + s]) : defaultSizes[s];
+        char *json = BuildResponse(recorded, input.docs, &input.size);
+        if (json == NULL) {
+            fprintf(stderr, "[JsonBench] Corpus sem array 'documents'.\n");
+            status = 1;
+            break;
+        }
+        input.json = json;
+        if (!BenchSize(&input)) status = 1;
+        free(json);
+    }
+
+    cJSON_InitHooks(NULL);
+    free(recorded);
+    return status;
+}
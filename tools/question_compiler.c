@@ -0,0 +1,593 @@
+/**
+ * @file question_compiler.c
+ * @author Grupo 1
+ * @brief Compilador do Banco de Questões: JSON -> pack binário (resources/questions.qpk).
+ * @version 1.5
+ * @copyright Copyright (c) 2025
+ *
+ * Roda na compilação (make questions), tirando do jogo todo o trabalho sobre o banco:
+ * - valida cada pergunta (quatro alternativas, índice da correta, dificuldade e pontos
+ *   coerentes, ids únicos) e aponta arquivo e posição de cada erro;
+ * - confere se a imagem de cada pergunta ("image") existe ao lado do JSON;
+ * - normaliza espaços, para que cada linha quebrada seja um trecho contínuo do texto;
+ * - calcula as quebras de linha e larguras do enunciado e das alternativas nos estilos
+ *   da tela de pergunta (QUESTION_TEXT_STYLE e OPTION_TEXT_STYLE), lendo as métricas
+ *   direto das tabelas hhea/hmtx/cmap do TTF, com as mesmas contas do raylib
+ *   (LoadFontEx ou a fonte SDF de game_font.c, com 250 glyphs a partir do espaço,
+ *   + MeasureTextEx);
+ * - grava o pack com textos deduplicados e o índice de categorias e tópicos, usando o
+ *   mesmo código do jogo (question_bank.c).
+ * Qualquer erro impede a gravação do pack e termina com código 1.
+ *
+ * Uso: question_compiler [-o saida.qpk] [-f fonte.ttf] [-s tamanho_base] <perguntas.json>...
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "raylib/question_bank.h"
+#include "raylib/game_font.h"
+#include "raylib/cJSON.h"
+
+#define DEFAULT_OUTPUT "resources/questions.qpk"
+#define DEFAULT_FONT GAME_FONT_PATH
+#define DEFAULT_FONT_BASE_SIZE GAME_FONT_SDF_SIZE  // o da fonte do jogo (game_font.c)
+#define FONT_FIRST_CODEPOINT 32
+#define FONT_GLYPH_COUNT GAME_FONT_GLYPH_COUNT
+#define OPTION_COUNT 4
+#define MAX_TEXT_BYTES 65535            // deslocamentos das linhas são de 16 bits
+
+static const char *difficultyNames[] = { "easy", "medium", "hard" };
+static const int pointsByDifficulty[] = { 10, 25, 50 };
+
+// Avanço de cada glyph carregado pelo raylib, já na escala do tamanho base.
+typedef struct {
+    int advance[FONT_GLYPH_COUNT];
+    bool present[FONT_GLYPH_COUNT];
+    int baseSize;
+    uint64_t hash;
+} FontMetrics;
+
+typedef struct {
+    const char *path;
+    int position;
+    Question question;
+    QuestionMeta meta;
+} SourceQuestion;
+
+static int errorCount = 0;
+static int warningCount = 0;
+
+//---------------------------------------------
+// Funções Auxiliares
+//---------------------------------------------
+static char *ReadWholeFile(const char *path, size_t *size) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *data = (length >= 0) ? malloc((size_t)length + 1) : NULL;
+    if (data != NULL && fread(data, 1, (size_t)length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    if (data == NULL) return NULL;
+    data[length] = '\0';
+    *size = (size_t)length;
+    return data;
+}
+
+static void Report(const SourceQuestion *source, bool isError, const char *message, const char *detail) {
+    fprintf(stderr, "%s: pergunta %d (id %d): %s: %s%s%s\n", source->path, source->position, source->question.id,
+            isError ? "erro" : "aviso", message, detail ? " - " : "", detail ? detail : "");
+    if (isError) errorCount++;
+    else warningCount++;
+}
+
+// Copia o texto trocando qualquer sequência de espaços por um único e tirando as pontas.
+static char *NormalizeSpaces(const char *text, bool *changed) {
+    size_t length = strlen(text);
+    char *out = malloc(length + 1);
+    if (out == NULL) return NULL;
+    size_t used = 0;
+    bool pendingSpace = false;
+    for (const char *p = text; *p != '\0'; p++) {
+        if (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') {
+            pendingSpace = used > 0;
+            continue;
+        }
+        if (pendingSpace) out[used++] = ' ';
+        pendingSpace = false;
+        out[used++] = *p;
+    }
+    out[used] = '\0';
+    *changed = used != length;
+    return out;
+}
+
+//---------------------------------------------
+// Métricas da Fonte (TTF)
+//---------------------------------------------
+static uint16_t ReadU16(const unsigned char *p) { return (uint16_t)((p[0] << 8) | p[1]); }
+static int16_t ReadS16(const unsigned char *p) { return (int16_t)ReadU16(p); }
+static uint32_t ReadU32(const unsigned char *p) { return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3]; }
+
+static const unsigned char *FindTable(const unsigned char *font, size_t size, const char *tag, size_t minLength) {
+    if (size < 12) return NULL;
+    int tableCount = ReadU16(font + 4);
+    for (int i = 0; i < tableCount && 12 + (size_t)(i + 1) * 16 <= size; i++) {
+        const unsigned char *record = font + 12 + i * 16;
+        uint32_t offset = ReadU32(record + 8), length = ReadU32(record + 12);
+        if (memcmp(record, tag, 4) == 0 && offset <= size && length <= size - offset && length >= minLength) return font + offset;
+    }
+    return NULL;
+}
+
+// Mesma escolha de subtabela do stb_truetype: a última Unicode (plataforma 0) ou Windows BMP/completa.
+static const unsigned char *FindUnicodeCmap(const unsigned char *font, size_t size) {
+    const unsigned char *cmap = FindTable(font, size, "cmap", 4);
+    if (cmap == NULL) return NULL;
+    const unsigned char *selected = NULL;
+    int tableCount = ReadU16(cmap + 2);
+    for (int i = 0; i < tableCount; i++) {
+        const unsigned char *record = cmap + 4 + i * 8;
+        if (record + 8 > font + size) break;
+        int platform = ReadU16(record), encoding = ReadU16(record + 2);
+        if (platform == 0 || (platform == 3 && (encoding == 1 || encoding == 10))) {
+            size_t offset = (size_t)(cmap - font) + ReadU32(record + 4);
+            if (offset + 16 <= size) selected = font + offset;
+        }
+    }
+    return selected;
+}
+
+// Glyph do codepoint nos formatos 4 e 12, como stbtt_FindGlyphIndex.
+static int FindGlyph(const unsigned char *map, const unsigned char *end, int codepoint) {
+    int format = ReadU16(map);
+    if (format == 4) {
+        int segCount = ReadU16(map + 6) / 2;
+        if (map + 16 + segCount * 8 > end) return 0;
+        for (int s = 0; s < segCount; s++) {
+            int last = ReadU16(map + 14 + s * 2);
+            int first = ReadU16(map + 16 + segCount * 2 + s * 2);
+            if (codepoint < first || codepoint > last) continue;
+            int delta = ReadS16(map + 16 + segCount * 4 + s * 2);
+            const unsigned char *rangeOffset = map + 16 + segCount * 6 + s * 2;
+            int offset = ReadU16(rangeOffset);
+            if (offset == 0) return (uint16_t)(codepoint + delta);
+            const unsigned char *glyph = rangeOffset + offset + (codepoint - first) * 2;
+            return (glyph + 2 <= end) ? ReadU16(glyph) : 0;
+        }
+    } else if (format == 12) {
+        uint32_t groups = ReadU32(map + 12);
+        for (uint32_t g = 0; g < groups && map + 16 + (g + 1) * 12 <= end; g++) {
+            const unsigned char *group = map + 16 + g * 12;
+            uint32_t first = ReadU32(group), last = ReadU32(group + 4);
+            if ((uint32_t)codepoint >= first && (uint32_t)codepoint <= last) return (int)(ReadU32(group + 8) + (codepoint - first));
+        }
+    }
+    return 0;
+}
+
+static bool LoadFontMetrics(FontMetrics *metrics, const char *path, int baseSize) {
+    size_t size = 0;
+    unsigned char *font = (unsigned char *)ReadWholeFile(path, &size);
+    if (font == NULL) {
+        fprintf(stderr, "[QuestionCompiler] Erro ao ler a fonte '%s'.\n", path);
+        return false;
+    }
+    const unsigned char *hhea = FindTable(font, size, "hhea", 36);
+    const unsigned char *hmtx = FindTable(font, size, "hmtx", 4);
+    const unsigned char *map = FindUnicodeCmap(font, size);
+    if (hhea == NULL || hmtx == NULL || map == NULL) {
+        fprintf(stderr, "[QuestionCompiler] Erro: '%s' não tem as tabelas hhea/hmtx/cmap esperadas.\n", path);
+        free(font);
+        return false;
+    }
+
+    // stbtt_ScaleForPixelHeight, e o avanço truncado para int como em LoadFontData.
+    float scale = (float)baseSize / (float)(ReadS16(hhea + 4) - ReadS16(hhea + 6));
+    int longMetrics = ReadU16(hhea + 34);
+    for (int i = 0; i < FONT_GLYPH_COUNT; i++) {
+        int glyph = FindGlyph(map, font + size, FONT_FIRST_CODEPOINT + i);
+        int metric = (glyph < longMetrics) ? glyph : longMetrics - 1;
+        const unsigned char *entry = hmtx + 4 * metric;
+        metrics->present[i] = glyph > 0;
+        metrics->advance[i] = (entry + 2 <= font + size) ? (int)((float)ReadS16(entry) * scale) : 0;
+    }
+    metrics->baseSize = baseSize;
+    metrics->hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        metrics->hash ^= font[i];
+        metrics->hash *= 1099511628211ULL;
+    }
+    free(font);
+    return true;
+}
+
+// GetCodepointNext do raylib: sequência inválida vira '?' e consome um byte.
+static int NextCodepoint(const char *text, int *bytes) {
+    const unsigned char *p = (const unsigned char *)text;
+    *bytes = 1;
+    if (p[0] < 0x80) return p[0];
+    if ((p[0] & 0xE0) == 0xC0 && (p[1] & 0xC0) == 0x80) {
+        *bytes = 2;
+        return ((p[0] & 0x1F) << 6) | (p[1] & 0x3F);
+    }
+    if ((p[0] & 0xF0) == 0xE0 && (p[1] & 0xC0) == 0x80 && (p[2] & 0xC0) == 0x80) {
+        *bytes = 3;
+        return ((p[0] & 0x0F) << 12) | ((p[1] & 0x3F) << 6) | (p[2] & 0x3F);
+    }
+    if ((p[0] & 0xF8) == 0xF0 && (p[1] & 0xC0) == 0x80 && (p[2] & 0xC0) == 0x80 && (p[3] & 0xC0) == 0x80) {
+        *bytes = 4;
+        return ((p[0] & 0x07) << 18) | ((p[1] & 0x3F) << 12) | ((p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+    }
+    return '?';
+}
+
+static bool HasGlyph(const FontMetrics *metrics, int codepoint) {
+    int index = codepoint - FONT_FIRST_CODEPOINT;
+    return index >= 0 && index < FONT_GLYPH_COUNT && metrics->present[index];
+}
+
+// Avanço de um caractere no tamanho do estilo, como GlyphAdvance em text_layout.c.
+static float GlyphAdvance(const FontMetrics *metrics, int codepoint, float scale) {
+    if (!HasGlyph(metrics, codepoint)) codepoint = '?';
+    return metrics->advance[codepoint - FONT_FIRST_CODEPOINT] * scale;
+}
+
+// Mesma quebra de WrapTextLines (text_layout.c), com as mesmas contas, para que o layout
+// do pack e a quebra feita na hora pelo jogo coincidam: gulosa por palavras, e uma palavra
+// mais larga que a área é partida entre dois caracteres. O texto já vem com os espaços
+// normalizados, então não há '\t', '\r' nem '\n'. Retorna o número de linhas.
+static int WrapLines(const FontMetrics *metrics, const char *text, TextStyle style, TextLayoutLine *lines, int maxLines, bool *splitWord) {
+    float scale = style.fontSize / (float)metrics->baseSize;
+    float spacing = style.spacing, maxWidth = style.width;
+    float spaceWidth = GlyphAdvance(metrics, ' ', scale);
+    int lineCount = 0;
+    int lineStart = 0, lineEnd = 0;     // linha atual: [lineStart, lineEnd)
+    float lineWidth = 0.0f;
+    int i = 0;
+    *splitWord = false;
+    while (text[i] != '\0' && lineCount < maxLines && i < 0xFFFF) {  // deslocamentos de 16 bits
+        if (text[i] == ' ') { i++; continue; }
+        int wordStart = i;
+        float wordWidth = 0.0f;
+        while (text[i] != '\0' && text[i] != ' ') {
+            int bytes = 0;
+            int codepoint = NextCodepoint(text + i, &bytes);
+            wordWidth += GlyphAdvance(metrics, codepoint, scale) + ((i > wordStart) ? spacing : 0.0f);
+            i += bytes;
+        }
+        if (lineEnd > lineStart) {
+            float joined = lineWidth + spacing + spaceWidth + spacing + wordWidth;
+            if (joined <= maxWidth) {
+                lineEnd = i;
+                lineWidth = joined;
+                continue;
+            }
+            lines[lineCount++] = (TextLayoutLine){ (unsigned short)lineStart, (unsigned short)(lineEnd - lineStart), lineWidth };
+            if (lineCount >= maxLines) break;
+        }
+        lineStart = wordStart;
+        lineEnd = i;
+        lineWidth = wordWidth;
+        for (int p = wordStart; lineWidth > maxWidth && lineCount < maxLines;) {
+            int pieceStart = p;
+            float pieceWidth = 0.0f;
+            while (p < i) {
+                int bytes = 0;
+                float advance = GlyphAdvance(metrics, NextCodepoint(text + p, &bytes), scale) + ((p > pieceStart) ? spacing : 0.0f);
+                if (p > pieceStart && pieceWidth + advance > maxWidth) break;
+                pieceWidth += advance;
+                p += bytes;
+            }
+            if (p >= i) break;
+            *splitWord = true;
+            lines[lineCount++] = (TextLayoutLine){ (unsigned short)pieceStart, (unsigned short)(p - pieceStart), pieceWidth };
+            lineStart = p;
+            lineWidth -= pieceWidth + spacing;
+        }
+    }
+    if (lineEnd > lineStart && lineCount < maxLines) {
+        lines[lineCount++] = (TextLayoutLine){ (unsigned short)lineStart, (unsigned short)(lineEnd - lineStart), lineWidth };
+    }
+    return lineCount;
+}
+
+// Quebra o texto (WrapLines), avisa se ele não cabe na área e guarda o layout.
+static void ComputeLayout(const FontMetrics *metrics, const char *text, TextStyle style, TextLayout *layout,
+                          const SourceQuestion *source, const char *what) {
+    TextLayoutLine lines[64];
+    bool splitWord = false;
+    int lineCount = WrapLines(metrics, text, style, lines, 64, &splitWord);
+    if (splitWord) Report(source, false, "palavra mais larga que a área do texto (partida entre caracteres)", what);
+    float height = lineCount * style.fontSize + (lineCount - 1) * style.spacing;
+    if (height > style.maxHeight) {
+        char detail[128];
+        snprintf(detail, sizeof(detail), "%s, %d linhas (%.0f de %.0f px)", what, lineCount, height, style.maxHeight);
+        Report(source, false, "texto não cabe na altura da área", detail);
+    }
+
+    memset(layout, 0, sizeof(*layout));
+    if (lineCount > TEXT_LAYOUT_MAX_LINES) return; // o jogo quebra na hora
+    layout->lineCount = lineCount;
+    memcpy(layout->lines, lines, lineCount * sizeof(TextLayoutLine));
+}
+
+//---------------------------------------------
+// Leitura e Validação das Perguntas
+//---------------------------------------------
+static const char *TakeText(const cJSON *item, const SourceQuestion *source, const char *what) {
+    if (!cJSON_IsString(item) || item->valuestring[0] == '\0') {
+        Report(source, true, "texto ausente ou vazio", what);
+        return NULL;
+    }
+    bool changed = false;
+    char *text = NormalizeSpaces(item->valuestring, &changed);
+    if (text == NULL) return NULL;
+    if (changed) Report(source, false, "espaços normalizados", what);
+    if (strlen(text) > MAX_TEXT_BYTES) {
+        Report(source, true, "texto longo demais", what);
+        free(text);
+        return NULL;
+    }
+    return text;
+}
+
+static bool ReadInteger(const cJSON *item, int min, int max, int *out) {
+    if (!cJSON_IsNumber(item) || item->valuedouble < min || item->valuedouble > max) return false;
+    if (item->valuedouble != (double)(int)item->valuedouble) return false;
+    *out = (int)item->valuedouble;
+    return true;
+}
+
+// Categoria ou tópico: opcional, mas se presente precisa ser um texto não vazio.
+static const char *TakeTag(const cJSON *object, const char *key, SourceQuestion *source) {
+    const cJSON *item = cJSON_GetObjectItemCaseSensitive(object, key);
+    if (item == NULL) return NULL;
+    return TakeText(item, source, key);
+}
+
+static void FreeQuestionTexts(SourceQuestion *source) {
+    free((char *)source->question.questionText);
+    for (int i = 0; i < OPTION_COUNT; i++) free((char *)source->question.options[i]);
+    free((char *)source->meta.category);
+    free((char *)source->meta.topic);
+    free((char *)source->meta.image);
+}
+
+// Imagem: opcional; o caminho é relativo ao diretório do JSON (resources/ no jogo) e,
+// se o arquivo não existir ali, a pergunta é gravada assim mesmo, só com um aviso.
+static const char *TakeImage(const cJSON *object, SourceQuestion *source) {
+    const cJSON *item = cJSON_GetObjectItemCaseSensitive(object, "image");
+    if (item == NULL) return NULL;
+    if (!cJSON_IsString(item) || !IsValidQuestionImagePath(item->valuestring)) {
+        Report(source, true, "'image' deve ser um caminho relativo dentro de " QUESTION_IMAGE_DIR, NULL);
+        return NULL;
+    }
+    const char *slash = strrchr(source->path, '/');
+    int directoryLength = (slash != NULL) ? (int)(slash - source->path + 1) : 0;
+    char imagePath[512];
+    snprintf(imagePath, sizeof(imagePath), "%.*s%s", directoryLength, source->path, item->valuestring);
+    FILE *file = fopen(imagePath, "rb");
+    if (file != NULL) fclose(file);
+    else Report(source, false, "imagem não encontrada", imagePath);
+    char *image = malloc(strlen(item->valuestring) + 1);
+    if (image != NULL) strcpy(image, item->valuestring);
+    return image;
+}
+
+// Valida uma pergunta; com erro, ela é contada e descartada.
+static bool ReadQuestion(const cJSON *item, SourceQuestion *source) {
+    Question *q = &source->question;
+    memset(q, 0, sizeof(*q));
+    memset(&source->meta, 0, sizeof(source->meta));
+    if (!cJSON_IsObject(item)) {
+        Report(source, true, "não é um objeto", NULL);
+        return false;
+    }
+    int errorsBefore = errorCount;
+    if (!ReadInteger(cJSON_GetObjectItemCaseSensitive(item, "id"), 1, INT32_MAX, &q->id)) Report(source, true, "'id' deve ser um inteiro positivo", NULL);
+    if (!ReadInteger(cJSON_GetObjectItemCaseSensitive(item, "correct"), 0, OPTION_COUNT - 1, &q->correctOption)) Report(source, true, "'correct' deve ser 0, 1, 2 ou 3", NULL);
+
+    const cJSON *difficulty = cJSON_GetObjectItemCaseSensitive(item, "difficulty");
+    int d = 0;
+    while (d < 3 && !(cJSON_IsString(difficulty) && strcmp(difficulty->valuestring, difficultyNames[d]) == 0)) d++;
+    if (d == 3) Report(source, true, "'difficulty' deve ser easy, medium ou hard", NULL);
+    else q->difficulty = (Difficulty)d;
+
+    if (!ReadInteger(cJSON_GetObjectItemCaseSensitive(item, "points"), 1, 65535, &q->points)) {
+        Report(source, true, "'points' deve ser um inteiro positivo", NULL);
+    } else if (d < 3 && q->points != pointsByDifficulty[d]) {
+        char detail[64];
+        snprintf(detail, sizeof(detail), "%s vale %d, não %d", difficultyNames[d], pointsByDifficulty[d], q->points);
+        Report(source, true, "pontos incoerentes com a dificuldade", detail);
+    }
+
+    q->questionText = TakeText(cJSON_GetObjectItemCaseSensitive(item, "text"), source, "enunciado");
+    source->meta.category = TakeTag(item, "category", source);
+    source->meta.topic = TakeTag(item, "topic", source);
+    source->meta.image = TakeImage(item, source);
+    const cJSON *rating = cJSON_GetObjectItemCaseSensitive(item, "rating");
+    if (rating != NULL) {
+        if (!cJSON_IsNumber(rating) || rating->valuedouble < QUESTION_RATING_MIN || rating->valuedouble > QUESTION_RATING_MAX) {
+            char detail[64];
+            snprintf(detail, sizeof(detail), "entre %.0f e %.0f", QUESTION_RATING_MIN, QUESTION_RATING_MAX);
+            Report(source, true, "'rating' deve ser um número", detail);
+        } else {
+            source->meta.rating = (float)rating->valuedouble;
+        }
+    }
+    const cJSON *options = cJSON_GetObjectItemCaseSensitive(item, "options");
+    if (!cJSON_IsArray(options) || cJSON_GetArraySize(options) != OPTION_COUNT) {
+        Report(source, true, "'options' deve ter exatamente 4 alternativas", NULL);
+    } else {
+        static const char *names[OPTION_COUNT] = { "alternativa A", "alternativa B", "alternativa C", "alternativa D" };
+        for (int i = 0; i < OPTION_COUNT; i++) q->options[i] = TakeText(cJSON_GetArrayItem(options, i), source, names[i]);
+        for (int i = 0; i < OPTION_COUNT; i++) {
+            for (int j = i + 1; j < OPTION_COUNT; j++) {
+                if (q->options[i] != NULL && q->options[j] != NULL && strcmp(q->options[i], q->options[j]) == 0) {
+                    Report(source, false, "alternativas repetidas", q->options[i]);
+                }
+            }
+        }
+    }
+
+    if (errorCount == errorsBefore) return true;
+    FreeQuestionTexts(source);
+    return false;
+}
+
+static int CompareById(const void *a, const void *b) {
+    const SourceQuestion *x = a, *y = b;
+    return (x->question.id > y->question.id) - (x->question.id < y->question.id);
+}
+
+// Lê um arquivo de perguntas, acrescentando as válidas em 'list'. Com 'keep', o JSON lido
+// fica com quem chamou (para identificar o pack); senão é liberado.
+static void ReadSourceFile(const char *path, SourceQuestion **list, int *count, int *capacity, QuestionSource *keep) {
+    QuestionSource source;
+    if (!ReadQuestionSource(path, &source)) {
+        fprintf(stderr, "%s: erro: não foi possível ler o arquivo\n", path);
+        errorCount++;
+        return;
+    }
+    const char *errorAt = NULL;
+    cJSON *root = cJSON_ParseWithLengthOpts(source.json, source.size, &errorAt, false);
+    if (root == NULL) {
+        int line = 1;
+        for (const char *p = source.json; errorAt != NULL && p < errorAt; p++) line += (*p == '\n');
+        fprintf(stderr, "%s:%d: erro: JSON inválido\n", path, line);
+        errorCount++;
+        FreeQuestionSource(&source);
+        return;
+    }
+
+    const cJSON *questions = cJSON_GetObjectItemCaseSensitive(root, "questions");
+    if (!cJSON_IsArray(questions)) {
+        fprintf(stderr, "%s: erro: array 'questions' não encontrado\n", path);
+        errorCount++;
+    }
+    int position = 0;
+    const cJSON *item = NULL;
+    cJSON_ArrayForEach(item, questions) {
+        if (*count == *capacity) {
+            *capacity = (*capacity > 0) ? *capacity * 2 : 256;
+            *list = realloc(*list, (size_t)*capacity * sizeof(SourceQuestion));
+            if (*list == NULL) {
+                fprintf(stderr, "[QuestionCompiler] Erro: memória insuficiente.\n");
+                exit(1);
+            }
+        }
+        SourceQuestion *source = &(*list)[*count];
+        source->path = path;
+        source->position = position++;
+        if (ReadQuestion(item, source)) (*count)++;
+    }
+    cJSON_Delete(root);
+    if (keep != NULL) *keep = source;
+    else FreeQuestionSource(&source);
+}
+
+//---------------------------------------------
+// Ponto de Entrada
+//---------------------------------------------
+int main(int argc, char **argv) {
+    const char *outputPath = DEFAULT_OUTPUT;
+    const char *fontPath = DEFAULT_FONT;
+    int fontBaseSize = DEFAULT_FONT_BASE_SIZE;
+    int firstSource = 1;
+    while (firstSource + 1 < argc && argv[firstSource][0] == '-') {
+        if (strcmp(argv[firstSource], "-o") == 0) outputPath = argv[firstSource + 1];
+        else if (strcmp(argv[firstSource], "-f") == 0) fontPath = argv[firstSource + 1];
+        else if (strcmp(argv[firstSource], "-s") == 0) fontBaseSize = atoi(argv[firstSource + 1]);
+        else break;
+        firstSource += 2;
+    }
+    if (firstSource >= argc || fontBaseSize <= 0) {
+        fprintf(stderr, "Uso: %s [-o saida.qpk] [-f fonte.ttf] [-s tamanho_base] <perguntas.json>...\n", argv[0]);
+        return 1;
+    }
+
+    FontMetrics metrics;
+    if (!LoadFontMetrics(&metrics, fontPath, fontBaseSize)) return 1;
+
+    SourceQuestion *list = NULL;
+    int count = 0, capacity = 0;
+    // Com um único fonte, o pack fica associado a ele e o jogo não o reconstrói.
+    QuestionSource single = { 0 };
+    bool singleSource = argc - firstSource == 1;
+    for (int i = firstSource; i < argc; i++) ReadSourceFile(argv[i], &list, &count, &capacity, singleSource ? &single : NULL);
+
+    // Ids repetidos, inclusive entre arquivos diferentes.
+    if (count > 1) qsort(list, (size_t)count, sizeof(SourceQuestion), CompareById);
+    for (int i = 1; i < count; i++) {
+        if (list[i].question.id == list[i - 1].question.id) {
+            char detail[512];
+            snprintf(detail, sizeof(detail), "também em %s, pergunta %d", list[i - 1].path, list[i - 1].position);
+            Report(&list[i], true, "id repetido", detail);
+        }
+    }
+
+    Question *questions = malloc(((size_t)count + 1) * sizeof(Question));
+    QuestionMeta *meta = malloc(((size_t)count + 1) * sizeof(QuestionMeta));
+    QuestionLayout *layouts = malloc(((size_t)count + 1) * sizeof(QuestionLayout));
+    int perDifficulty[3] = { 0 };
+    TextStyle questionStyle = QUESTION_TEXT_STYLE, optionStyle = OPTION_TEXT_STYLE;
+    static const char *optionNames[OPTION_COUNT] = { "alternativa A", "alternativa B", "alternativa C", "alternativa D" };
+    for (int i = 0; i < count && questions != NULL && meta != NULL && layouts != NULL; i++) {
+        const SourceQuestion *source = &list[i];
+        const Question *q = &source->question;
+        questions[i] = *q;
+        meta[i] = source->meta;
+        perDifficulty[q->difficulty]++;
+        ComputeLayout(&metrics, q->questionText, questionStyle, &layouts[i].question, source, "enunciado");
+        for (int o = 0; o < OPTION_COUNT; o++) ComputeLayout(&metrics, q->options[o], optionStyle, &layouts[i].options[o], source, optionNames[o]);
+
+        const char *texts[OPTION_COUNT + 1] = { q->questionText, q->options[0], q->options[1], q->options[2], q->options[3] };
+        for (int t = 0; t < OPTION_COUNT + 1; t++) {
+            for (const char *p = texts[t]; *p != '\0';) {
+                int bytes = 0;
+                int codepoint = NextCodepoint(p, &bytes);
+                if (!HasGlyph(&metrics, codepoint)) {
+                    Report(source, false, "caractere fora da fonte, será desenhado como '?'", texts[t]);
+                    break;
+                }
+                p += bytes;
+            }
+        }
+    }
+
+    int status = 0;
+    if (questions == NULL || meta == NULL || layouts == NULL) {
+        fprintf(stderr, "[QuestionCompiler] Erro: memória insuficiente.\n");
+        status = 1;
+    } else if (errorCount > 0 || count == 0) {
+        fprintf(stderr, "[QuestionCompiler] %d erro(s), %d aviso(s); '%s' não foi gravado.\n", errorCount, warningCount, outputPath);
+        status = 1;
+    } else {
+        QuestionLayoutSet layoutSet = { layouts, metrics.baseSize, metrics.hash, { QUESTION_TEXT_STYLE, OPTION_TEXT_STYLE } };
+        size_t packSize = 0;
+        char *pack = BuildQuestionPack(questions, meta, count, &layoutSet, (single.json != NULL) ? &single : NULL, &packSize);
+        if (pack == NULL || !WriteQuestionPack(outputPath, pack, packSize)) {
+            fprintf(stderr, "[QuestionCompiler] Erro ao gravar '%s'.\n", outputPath);
+            status = 1;
+        } else {
+            printf("%s: %d perguntas (%d fáceis, %d médias, %d difíceis), %zu bytes, %d aviso(s)\n",
+                   outputPath, count, perDifficulty[EASY], perDifficulty[MEDIUM], perDifficulty[HARD], packSize, warningCount);
+        }
+        free(pack);
+    }
+
+    for (int i = 0; i < count; i++) FreeQuestionTexts(&list[i]);
+    FreeQuestionSource(&single);
+    free(list);
+    free(questions);
+    free(meta);
+    free(layouts);
+    return status;
+}